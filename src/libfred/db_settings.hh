@@ -24,6 +24,9 @@
  *    Manager and used Connection factory, and following types
  *    defined as internal and depends on used connection manager type
  *    (Manager + Connection factory) - Connection, Result and Row types.
+ *
+ *  Connections are pooled (Factory::Pool) if USE_CONNECTION_POOL is defined,
+ *  otherwise each connection is opened on demand (Factory::Simple).
  */
 
 #ifndef DB_SETTINGS_HH_496DFB2A05584145B21F5808014C6545
@@ -33,7 +36,11 @@
 
 namespace Database {
 
+#if defined(USE_CONNECTION_POOL) && USE_CONNECTION_POOL
+using StandaloneConnectionFactory = Factory::Pool<PSQLConnection>;
+#else
 using StandaloneConnectionFactory = Factory::Simple<PSQLConnection>;
+#endif
 using StandaloneManager = Manager_<StandaloneConnectionFactory>;
 
 using StandaloneConnection = StandaloneManager::connection_type;
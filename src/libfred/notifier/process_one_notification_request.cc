@@ -22,12 +22,21 @@
 #include "libfred/notifier/gather_email_data/gather_email_content.hh"
 #include "libfred/notifier/exception.hh"
 
-#include <exception>
 #include <boost/foreach.hpp>
 #include <boost/algorithm/string/trim.hpp>
-#include <string>
-#include <set>
+#include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
 #include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace Notification {
 namespace {
@@ -109,6 +118,53 @@ void send_email(std::shared_ptr<LibFred::Mailer::Manager> mailer, const EmailDat
     }
 }
 
+notification_request make_notification_request(const Database::Row& _row)
+{
+    return notification_request(
+        EventOnObject(
+            LibFred::object_type_from_db_handle( static_cast<std::string>( _row["object_type_"] ) ),
+            notified_event_from_db_handle( static_cast<std::string>( _row["change"] ) )
+        ),
+        static_cast<unsigned long long>( _row["done_by_registrar"] ),
+        static_cast<unsigned long long>( _row["historyid_post_change"] ),
+        static_cast<std::string>( _row["svtrid"] )
+    );
+}
+
+std::string make_log_prefix(const std::string& _function_name, const notification_request& _request)
+{
+    return _function_name + " "
+        "event=\"" + to_db_handle( _request.event.get_event() ) + "\" "
+        "object_type=\"" + to_db_handle( _request.event.get_type() ) + "\" "
+        "done_by_registrar=\"" + boost::lexical_cast<std::string>( _request.done_by_registrar ) + "\" "
+        "history_id_post_change=\"" + boost::lexical_cast<std::string>( _request.history_id_post_change ) + "\" "
+        "svtrid=\"" + _request.svtrid + "\" ";
+}
+
+/**
+ * @returns false if there is nothing to send
+ */
+bool is_worth_sending(const notification_request& _request, const EmailData& _data)
+{
+    // Ticket #6547 send update notifications only if there are some changes
+    if (_request.event.get_event() == updated)
+    {
+        const std::map<std::string, std::string>::const_iterator changes_it = _data.template_parameters.find("changes");
+        if (changes_it == _data.template_parameters.end())
+        {
+            throw ExceptionMissingChangesFlagInUpdateNotificationContent();
+        }
+        if (changes_it->second == "0")
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* upper bound of threads sending e-mails of one batch */
+constexpr std::size_t max_number_of_concurrent_senders = 16;
+
 } // namespace Notification::{anonymous}
 
 bool process_one_notification_request(const LibFred::OperationContext& _ctx, std::shared_ptr<LibFred::Mailer::Manager> _mailer) {
@@ -172,40 +228,18 @@ bool process_one_notification_request(const LibFred::OperationContext& _ctx, std
             return false;
         }
 
-        notification_request request(
-            EventOnObject(
-                LibFred::object_type_from_db_handle( static_cast<std::string>( notification_to_send_res[0]["object_type_"] ) ),
-                notified_event_from_db_handle( static_cast<std::string>( notification_to_send_res[0]["change"] ) )
-            ),
-            static_cast<unsigned long long>( notification_to_send_res[0]["done_by_registrar"] ),
-            static_cast<unsigned long long>( notification_to_send_res[0]["historyid_post_change"] ),
-            static_cast<std::string>( notification_to_send_res[0]["svtrid"] )
-        );
-
-        log_prefix +=
-            "event=\"" + to_db_handle( request.event.get_event() ) + "\" "
-            "object_type=\"" + to_db_handle( request.event.get_type() ) + "\" "
-            "done_by_registrar=\"" + boost::lexical_cast<std::string>( request.done_by_registrar ) + "\" "
-            "history_id_post_change=\"" + boost::lexical_cast<std::string>( request.history_id_post_change ) + "\" "
-            "svtrid=\"" + request.svtrid + "\" ";
+        const notification_request request = make_notification_request(notification_to_send_res[0]);
+
+        log_prefix = make_log_prefix("process_one_notification_request()", request);
 
         const EmailData data(
                 gather_email_addresses(_ctx, request.event, request.history_id_post_change),
                 get_template_name(request.event.get_event()),
                 gather_email_content(_ctx, request));
 
-        // Ticket #6547 send update notifications only if there are some changes
-        if (request.event.get_event() == updated)
+        if (!is_worth_sending(request, data))
         {
-            const std::map<std::string, std::string>::const_iterator changes_it = data.template_parameters.find("changes");
-            if (changes_it == data.template_parameters.end())
-            {
-                throw ExceptionMissingChangesFlagInUpdateNotificationContent();
-            }
-            if (changes_it->second == "0")
-            {
-                return true;
-            }
+            return true;
         }
 
         FREDLOG_INFO(log_prefix + "completed - transaction not yet comitted");
@@ -245,4 +279,156 @@ bool process_one_notification_request(const LibFred::OperationContext& _ctx, std
     }
 }
 
+ProcessedNotificationRequests process_notification_requests(
+        const LibFred::OperationContext& _ctx,
+        std::shared_ptr<LibFred::Mailer::Manager> _mailer,
+        std::size_t _batch_size)
+{
+    ProcessedNotificationRequests result;
+    if (_batch_size == 0)
+    {
+        return result;
+    }
+
+    /* rows locked by concurrent workers are skipped, object types are resolved for the whole batch at once */
+    const Database::Result claimed_res = _ctx.get_conn().exec_params(
+        "WITH locked AS ("
+            "SELECT "
+                "change, "
+                "done_by_registrar, "
+                "historyid_post_change, "
+                "svtrid "
+            "FROM notification_queue "
+            "FOR UPDATE SKIP LOCKED "
+            "LIMIT $1::INTEGER "
+        "), "
+        "deleted AS ("
+            "DELETE "
+            "FROM notification_queue AS q "
+            "USING locked "
+            "WHERE "
+                "q.change = locked.change "
+                "AND q.done_by_registrar = locked.done_by_registrar "
+                "AND q.historyid_post_change = locked.historyid_post_change "
+                "AND q.svtrid = locked.svtrid "
+            "RETURNING locked.* "
+        ") "
+        "SELECT "
+            "d.*, "
+            "e_o_t.name AS object_type_ "
+        "FROM deleted d "
+        "LEFT JOIN object_history o_h ON o_h.historyid = d.historyid_post_change "
+        "LEFT JOIN object_registry o_r ON o_r.id = o_h.id "
+        "LEFT JOIN enum_object_type e_o_t ON e_o_t.id = o_r.type",
+        Database::query_param_list(_batch_size));
+
+    result.number_of_processed_requests = claimed_res.size();
+    if (claimed_res.size() == 0)
+    {
+        FREDLOG_INFO("process_notification_requests() no record found in notification_queue");
+        return result;
+    }
+
+    struct RequestToSend
+    {
+        notification_request request;
+        EmailData data;
+    };
+    std::vector<RequestToSend> requests_to_send;
+    requests_to_send.reserve(claimed_res.size());
+
+    for (Database::Result::size_type idx = 0; idx < claimed_res.size(); ++idx)
+    {
+        /* failure of one request must not spoil the whole batch */
+        _ctx.get_conn().exec("SAVEPOINT notification_request");
+        try
+        {
+            const notification_request request = make_notification_request(claimed_res[idx]);
+            EmailData data(
+                    gather_email_addresses(_ctx, request.event, request.history_id_post_change),
+                    get_template_name(request.event.get_event()),
+                    gather_email_content(_ctx, request));
+            _ctx.get_conn().exec("RELEASE SAVEPOINT notification_request");
+            if (is_worth_sending(request, data))
+            {
+                requests_to_send.push_back(RequestToSend{request, std::move(data)});
+            }
+        }
+        catch (const std::exception& e)
+        {
+            FREDLOG_ERROR(std::string("process_notification_requests() exception: ") + e.what());
+            _ctx.get_conn().exec("ROLLBACK TO SAVEPOINT notification_request");
+            /* return the request into the queue to be processed later */
+            _ctx.get_conn().exec_params(
+                "INSERT INTO notification_queue (change, done_by_registrar, historyid_post_change, svtrid) "
+                "VALUES ($1::notified_event, $2::INTEGER, $3::INTEGER, $4::TEXT)",
+                Database::query_param_list
+                    ( static_cast<std::string>( claimed_res[idx]["change"] ) )
+                    ( static_cast<unsigned long long>( claimed_res[idx]["done_by_registrar"] ) )
+                    ( static_cast<unsigned long long>( claimed_res[idx]["historyid_post_change"] ) )
+                    ( static_cast<std::string>( claimed_res[idx]["svtrid"] ) ));
+            --result.number_of_processed_requests;
+            ++result.number_of_requests_returned_to_queue;
+        }
+    }
+
+    /* e-mails of different requests are sent concurrently, each request by one sender */
+    std::vector<boost::optional<FailedToSendMail>> failures(requests_to_send.size());
+    std::vector<std::exception_ptr> unexpected_errors(requests_to_send.size());
+    std::atomic<std::size_t> next_request_idx(0);
+    const auto sender = [&]()
+    {
+        for (std::size_t idx = next_request_idx++; idx < requests_to_send.size(); idx = next_request_idx++)
+        {
+            const RequestToSend& to_send = requests_to_send[idx];
+            try
+            {
+                send_email(_mailer, to_send.data);
+            }
+            catch (const FailedToSendMailToRecipient& e)
+            {
+                failures[idx].emplace(
+                    to_send.request,
+                    e.failed_recipient,
+                    e.skipped_recipients,
+                    to_send.data.template_name,
+                    to_send.data.template_parameters);
+            }
+            catch (...)
+            {
+                unexpected_errors[idx] = std::current_exception();
+            }
+        }
+    };
+    const std::size_t number_of_senders = std::min(requests_to_send.size(), max_number_of_concurrent_senders);
+    std::vector<std::future<void>> senders;
+    senders.reserve(number_of_senders);
+    for (std::size_t idx = 1; idx < number_of_senders; ++idx)
+    {
+        senders.push_back(std::async(std::launch::async, sender));
+    }
+    sender();
+    for (auto& running_sender : senders)
+    {
+        running_sender.get();
+    }
+
+    for (std::size_t idx = 0; idx < requests_to_send.size(); ++idx)
+    {
+        if (unexpected_errors[idx] != nullptr)
+        {
+            std::rethrow_exception(unexpected_errors[idx]);
+        }
+        if (failures[idx] != boost::none)
+        {
+            FREDLOG_ERROR(make_log_prefix("process_notification_requests()", requests_to_send[idx].request) +
+                          "failed to send mail to " + failures[idx]->failed_recipient);
+            result.failed_to_send.push_back(*failures[idx]);
+        }
+    }
+    FREDLOG_INFO("process_notification_requests() completed " +
+                 std::to_string(result.number_of_processed_requests) + " requests - transaction not yet comitted");
+    return result;
+}
+
 } // namespace Notification
@@ -28,10 +28,12 @@
 
 #include "libfred/notifier/gather_email_data/notification_request.hh"
 
+#include <cstddef>
 #include <map>
 #include <set>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Notification {
 
@@ -68,5 +70,24 @@ struct FailedToLockRequest { };
  */
 bool process_one_notification_request(const LibFred::OperationContext& _ctx, std::shared_ptr<LibFred::Mailer::Manager> _mailer);
 
+struct ProcessedNotificationRequests {
+    std::size_t number_of_processed_requests = 0; ///< requests removed from notification_queue
+    std::size_t number_of_requests_returned_to_queue = 0; ///< requests which email data could not be gathered
+    std::vector<FailedToSendMail> failed_to_send; ///< processed requests which mails were not all sent
+};
+
+/**
+ * Process batch of notifications enqueued in table notification_queue.
+ * Claims up to _batch_size requests, requests locked by other transactions are skipped so concurrent workers do not collide.
+ * Requests which email data can not be gathered are returned into the queue, other requests are not affected.
+ * Mails of different requests are sent concurrently, so _mailer has to be safe to use from more threads at once.
+ * Respects do-not-send-empty-update-notification rule as process_one_notification_request.
+ * @returns counts of processed requests and the list of requests which mails failed to be sent
+ */
+ProcessedNotificationRequests process_notification_requests(
+        const LibFred::OperationContext& _ctx,
+        std::shared_ptr<LibFred::Mailer::Manager> _mailer,
+        std::size_t _batch_size);
+
 }
 #endif
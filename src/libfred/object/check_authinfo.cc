@@ -20,10 +20,26 @@
 #include "libfred/object/check_authinfo.hh"
 #include "libfred/opexception.hh"
 
+#include "util/db/param_query_composition.hh"
 #include "util/log/log.hh"
 #include "util/password_storage.hh"
 
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace LibFred {
 namespace Object {
@@ -61,6 +77,173 @@ void lock_for_share(const OperationContext& ctx, const ObjectId& object_id)
     }
 }
 
+/**
+ * Successful password verifications remembered for a short time, so repeated checks
+ * of the same password skip the expensive key derivation.
+ * Only keyed hashes of (password data, plaintext password) are stored, the key is random
+ * and never leaves the process.
+ */
+class VerifiedPasswordCache
+{
+public:
+    static VerifiedPasswordCache& get_instance()
+    {
+        static VerifiedPasswordCache instance;
+        return instance;
+    }
+
+    bool contains(const std::string& encrypted_password_data, const std::string& plaintext_password)
+    {
+        const auto key = make_key(encrypted_password_data, plaintext_password);
+        const auto now = std::chrono::steady_clock::now();
+        const std::lock_guard<std::mutex> lock(mutex_);
+        const auto verified_itr = verified_at_.find(key);
+        return (verified_itr != verified_at_.end()) && (now < (verified_itr->second + time_to_live));
+    }
+
+    void insert(const std::string& encrypted_password_data, const std::string& plaintext_password)
+    {
+        auto key = make_key(encrypted_password_data, plaintext_password);
+        const auto now = std::chrono::steady_clock::now();
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (max_size <= verified_at_.size())
+        {
+            for (auto verified_itr = verified_at_.begin(); verified_itr != verified_at_.end();)
+            {
+                verified_itr = (verified_itr->second + time_to_live) <= now ? verified_at_.erase(verified_itr)
+                                                                            : std::next(verified_itr);
+            }
+            if (max_size <= verified_at_.size())
+            {
+                verified_at_.clear();
+            }
+        }
+        verified_at_[std::move(key)] = now;
+    }
+private:
+    VerifiedPasswordCache()
+    {
+        if (::RAND_bytes(secret_.data(), secret_.size()) != 1)
+        {
+            throw std::runtime_error("unable to generate secret key of verified passwords cache");
+        }
+    }
+
+    std::string make_key(const std::string& encrypted_password_data, const std::string& plaintext_password)const
+    {
+        std::string message;
+        message.reserve(encrypted_password_data.size() + 1 + plaintext_password.size());
+        message.append(encrypted_password_data).append(1, '\0').append(plaintext_password);
+        std::array<unsigned char, EVP_MAX_MD_SIZE> digest;
+        unsigned int digest_length = 0;
+        const auto* const result = ::HMAC(
+                ::EVP_sha256(),
+                secret_.data(),
+                secret_.size(),
+                reinterpret_cast<const unsigned char*>(message.data()),
+                message.size(),
+                digest.data(),
+                &digest_length);
+        std::fill(message.begin(), message.end(), '\0');
+        if (result == nullptr)
+        {
+            throw std::runtime_error("unable to compute key of verified passwords cache");
+        }
+        return std::string(reinterpret_cast<const char*>(digest.data()), digest_length);
+    }
+
+    static constexpr std::chrono::seconds time_to_live{60};
+    static constexpr std::size_t max_size = 16384;
+    std::array<unsigned char, 32> secret_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> verified_at_;
+};
+
+constexpr std::chrono::seconds VerifiedPasswordCache::time_to_live;
+constexpr std::size_t VerifiedPasswordCache::max_size;
+
+constexpr unsigned max_number_of_concurrent_checks = 8;
+
+bool does_password_match(const std::string& plaintext_password, const std::string& encrypted_password_data)
+{
+    auto& verified_passwords = VerifiedPasswordCache::get_instance();
+    if (verified_passwords.contains(encrypted_password_data, plaintext_password))
+    {
+        return true;
+    }
+    try
+    {
+        PasswordStorage::check_password(
+                plaintext_password,
+                PasswordStorage::PasswordData::construct_from(encrypted_password_data));
+    }
+    catch (const PasswordStorage::IncorrectPassword&)
+    {
+        return false;
+    }
+    verified_passwords.insert(encrypted_password_data, plaintext_password);
+    return true;
+}
+
+//passwords are checked concurrently, each check is an expensive key derivation
+//if stop_on_first_match then no other check is started once a password matches, unchecked passwords don't match
+std::vector<bool> check_passwords(
+        const std::string& plaintext_password,
+        const std::vector<std::string>& encrypted_passwords,
+        bool stop_on_first_match = false)
+{
+    std::vector<char> matches(encrypted_passwords.size(), false);
+    std::atomic<std::size_t> next_idx{0};
+    const auto check_next_passwords = [&]()
+    {
+        for (std::size_t idx = next_idx++; idx < encrypted_passwords.size(); idx = next_idx++)
+        {
+            matches[idx] = does_password_match(plaintext_password, encrypted_passwords[idx]);
+            if (matches[idx] && stop_on_first_match)
+            {
+                next_idx = encrypted_passwords.size();
+            }
+        }
+    };
+    const auto number_of_workers = std::min<std::size_t>(
+            std::min<std::size_t>(encrypted_passwords.size(), max_number_of_concurrent_checks),
+            std::max(std::thread::hardware_concurrency(), 1u));
+    std::vector<std::future<void>> workers;
+    for (std::size_t cnt = 1; cnt < number_of_workers; ++cnt)
+    {
+        workers.push_back(std::async(std::launch::async, check_next_passwords));
+    }
+    std::exception_ptr failure;
+    try
+    {
+        check_next_passwords();
+    }
+    catch (...)
+    {
+        failure = std::current_exception();
+        next_idx = encrypted_passwords.size();
+    }
+    for (auto& worker : workers)
+    {
+        try
+        {
+            worker.get();
+        }
+        catch (...)
+        {
+            if (failure == nullptr)
+            {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure != nullptr)
+    {
+        std::rethrow_exception(failure);
+    }
+    return std::vector<bool>(matches.begin(), matches.end());
+}
+
 auto visit_authinfos(
         const OperationContext& ctx,
         const ObjectId& object_id,
@@ -76,19 +259,23 @@ auto visit_authinfos(
                    "password <> '' "
                "FOR UPDATE",
             Database::QueryParams{object_id});
+    std::vector<std::string> encrypted_passwords;
+    encrypted_passwords.reserve(dbres.size());
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        encrypted_passwords.push_back(static_cast<std::string>(dbres[idx][1]));
+    }
+    const auto matches = check_passwords(plaintext_password, encrypted_passwords);
     int match_counter = 0;
     for (std::size_t idx = 0; idx < dbres.size(); ++idx)
     {
         const auto authinfo_id = static_cast<AuthinfoId>(dbres[idx][0]);
-        const auto encrypted_password_data =
-                PasswordStorage::PasswordData::construct_from(static_cast<std::string>(dbres[idx][1]));
-        try
+        if (matches[idx])
         {
-            PasswordStorage::check_password(plaintext_password, encrypted_password_data);
             ++match_counter;
             on_match(ctx, authinfo_id);
         }
-        catch (const PasswordStorage::IncorrectPassword&)
+        else
         {
             FREDLOG_DEBUG(boost::format{"Password does not match the Authinfo %1% for object %2%, registrar %3%, "
                                         "created at %4% and expires at %5%"} %
@@ -102,6 +289,65 @@ auto visit_authinfos(
     return match_counter;
 }
 
+//objects not existing are skipped, the rest is locked for share in ascending order of ids
+std::vector<ObjectId> lock_existing_for_share(const OperationContext& ctx, const std::vector<ObjectId>& object_ids)
+{
+    std::vector<unsigned long long> ids;
+    ids.reserve(object_ids.size());
+    std::transform(object_ids.begin(), object_ids.end(), std::back_inserter(ids), [](auto&& object_id) { return *object_id; });
+    const auto dbres = ctx.get_conn().exec_params(Database::ParamQuery(
+            "SELECT id "
+              "FROM object_registry "
+             "WHERE id = ANY(").param_bigint_array(ids)(") AND "
+                   "erdate IS NULL "
+             "ORDER BY id "
+               "FOR SHARE"));
+    std::vector<ObjectId> existing_object_ids;
+    existing_object_ids.reserve(dbres.size());
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        existing_object_ids.push_back(ObjectId{static_cast<unsigned long long>(dbres[idx][0])});
+    }
+    return existing_object_ids;
+}
+
+auto visit_authinfos_of_any(
+        const OperationContext& ctx,
+        const std::vector<ObjectId>& object_ids,
+        const std::string& plaintext_password,
+        CheckAuthinfo::Visitor on_match)
+{
+    std::vector<unsigned long long> ids;
+    ids.reserve(object_ids.size());
+    std::transform(object_ids.begin(), object_ids.end(), std::back_inserter(ids), [](auto&& object_id) { return *object_id; });
+    const auto dbres = ctx.get_conn().exec_params(Database::ParamQuery(
+            "SELECT id, password, object_id "
+              "FROM object_authinfo "
+             "WHERE object_id = ANY(").param_bigint_array(ids)(") AND "
+                   "canceled_at IS NULL AND "
+                   "NOW() < expires_at AND "
+                   "password <> '' "
+             "ORDER BY object_id, id "
+               "FOR UPDATE"));
+    std::vector<std::string> encrypted_passwords;
+    encrypted_passwords.reserve(dbres.size());
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        encrypted_passwords.push_back(static_cast<std::string>(dbres[idx][1]));
+    }
+    const auto matches = check_passwords(plaintext_password, encrypted_passwords, true);
+    std::set<ObjectId> matching_object_ids;
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        if (matches[idx])
+        {
+            matching_object_ids.insert(ObjectId{static_cast<unsigned long long>(dbres[idx][2])});
+            on_match(ctx, static_cast<AuthinfoId>(dbres[idx][0]));
+        }
+    }
+    return matching_object_ids;
+}
+
 struct CheckAuthinfoFailure : LibFred::InternalError
 {
     CheckAuthinfoFailure() : LibFred::InternalError{""} { }
@@ -196,6 +442,58 @@ void CheckAuthinfo::increment_usage_and_cancel(const OperationContext& ctx, cons
     throw CheckAuthinfoFailure{};
 }
 
+CheckAuthinfoOfAnyObject::CheckAuthinfoOfAnyObject(std::vector<ObjectId> object_ids)
+    : object_ids_{std::move(object_ids)}
+{ }
+
+std::set<ObjectId> CheckAuthinfoOfAnyObject::exec(
+        const OperationContext& ctx,
+        const std::string& plaintext_password,
+        CheckAuthinfo::Visitor on_match) const
+{
+    if (object_ids_.empty())
+    {
+        return {};
+    }
+    try
+    {
+        const auto existing_object_ids = lock_existing_for_share(ctx, object_ids_);
+        if (existing_object_ids.empty())
+        {
+            return {};
+        }
+        return visit_authinfos_of_any(ctx, existing_object_ids, plaintext_password, on_match);
+    }
+    catch (const LibFred::InternalError&)
+    {
+        throw;
+    }
+    catch (const std::exception& e)
+    {
+        FREDLOG_ERROR(boost::format{"Check authinfo of any of objects %1% failed: %2%"} % this->to_string() % e.what());
+    }
+    catch (...)
+    {
+        FREDLOG_ERROR(boost::format{"Check authinfo of any of objects %1% failed: unknown exception caught"} % this->to_string());
+    }
+    throw CheckAuthinfoFailure{};
+}
+
+std::string CheckAuthinfoOfAnyObject::to_string() const
+{
+    std::string out = "{object_ids:[";
+    for (const auto& object_id : object_ids_)
+    {
+        if (&object_id != &object_ids_.front())
+        {
+            out += ",";
+        }
+        out += std::to_string(*object_id);
+    }
+    out += "]}";
+    return out;
+}
+
 std::string CheckAuthinfo::to_string() const
 {
     std::string out;
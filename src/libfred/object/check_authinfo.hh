@@ -26,7 +26,9 @@
 
 #include "util/printable.hh"
 
+#include <set>
 #include <string>
+#include <vector>
 
 namespace LibFred {
 namespace Object {
@@ -68,6 +70,40 @@ private:
     ObjectId object_id_;
 };
 
+/**
+ * Check if password match any authinfo associated with any of given objects.
+ * Authorization by one object is sufficient, so not all authinfos have to be checked.
+ */
+class CheckAuthinfoOfAnyObject : public Util::Printable<CheckAuthinfoOfAnyObject>
+{
+public:
+    /**
+     * CheckAuthinfoOfAnyObject constructor with mandatory parameters.
+     * @param object_ids objects' references
+     */
+    explicit CheckAuthinfoOfAnyObject(std::vector<ObjectId> object_ids);
+
+    /**
+     * Check if password match any authinfo associated with any of given objects.
+     * Objects which do not refer any existing registrable object are skipped. Authinfos of all objects
+     * are checked concurrently and no other check is started once the password matches.
+     * @param ctx database connection
+     * @param plaintext_password password in plain text format
+     * @param on_match procedure called for every checked authinfo matching the password
+     * @return objects having an authinfo matching the password, empty if no such object
+     * @throws InternalError in case of failure
+     */
+    std::set<ObjectId> exec(const OperationContext& ctx, const std::string& plaintext_password, CheckAuthinfo::Visitor on_match) const;
+
+    /**
+     * Dumps state of the instance into the string
+     * @return string with description of the instance state
+     */
+    std::string to_string() const;
+private:
+    std::vector<ObjectId> object_ids_;
+};
+
 }//namespace LibFred::Object
 }//namespace LibFred
 
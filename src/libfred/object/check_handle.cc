@@ -22,11 +22,155 @@
  */
 
 #include "libfred/object/check_handle.hh"
+#include "libfred/registry_metadata.hh"
+#include "util/log/log.hh"
 
 #include <boost/regex.hpp>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace LibFred {
 
+namespace {
+
+class HandleValidationRegexes
+{
+public:
+    HandleValidationRegexes(const Database::Result& regexes, std::chrono::steady_clock::time_point loaded_at)
+        : loaded_at_(loaded_at),
+          evaluated_by_database_(false)
+    {
+        try
+        {
+            regexes_.reserve(regexes.size());
+            for (Database::Result::size_type idx = 0; idx < regexes.size(); ++idx)
+            {
+                //the same composition as in the original `handle ~ ('^' || regex || '$')` condition
+                regexes_.emplace_back("^" + static_cast<std::string>(regexes[idx][0]) + "$", boost::regex::perl);
+            }
+        }
+        catch (const boost::regex_error& e)
+        {
+            FREDLOG_WARNING(std::string("handle validation regex not supported locally, database will be used: ") + e.what());
+            regexes_.clear();
+            evaluated_by_database_ = true;
+        }
+    }
+    bool is_evaluated_by_database()const
+    {
+        return evaluated_by_database_;
+    }
+    bool is_valid(const std::string& handle)const
+    {
+        return std::all_of(regexes_.begin(), regexes_.end(), [&](const boost::regex& regex)
+                {
+                    return boost::regex_search(handle, regex, boost::match_single_line);
+                });
+    }
+    bool is_expired(std::chrono::steady_clock::time_point now)const
+    {
+        return (loaded_at_ + handle_validation_regexes_ttl) <= now;
+    }
+private:
+    std::vector<boost::regex> regexes_;
+    std::chrono::steady_clock::time_point loaded_at_;
+    bool evaluated_by_database_;
+};
+
+Database::ParamQuery make_handle_validation_regexes_query(const std::string& object_type_name)
+{
+    return Database::ParamQuery(
+        "SELECT rc.regex AS regex "
+        "FROM enum_object_type eot "
+        "JOIN regex_object_type_handle_validation_checker_map rm ON eot.id=rm.type_id "
+        "JOIN regex_handle_validation_checker rc ON rc.id=rm.checker_id "
+        "WHERE eot.name=").param_text(object_type_name);
+}
+
+class HandleValidationRegexesCache
+{
+public:
+    static HandleValidationRegexesCache& get_instance()
+    {
+        static HandleValidationRegexesCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const HandleValidationRegexes> get(
+            const OperationContext& ctx,
+            const std::string& object_type_name)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        unsigned long long generation;
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            const auto cached_itr = regexes_.find(object_type_name);
+            if ((cached_itr != regexes_.end()) && !cached_itr->second->is_expired(now))
+            {
+                return cached_itr->second;
+            }
+            generation = generation_;
+        }
+        //database is queried and regexes are compiled without lock
+        const auto regexes = std::make_shared<const HandleValidationRegexes>(
+                ctx.get_conn().exec_params(make_handle_validation_regexes_query(object_type_name)),
+                now);
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            //do not store regexes which may have been read before invalidation
+            if (generation == generation_)
+            {
+                regexes_[object_type_name] = regexes;
+            }
+        }
+        return regexes;
+    }
+
+    void invalidate()
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        regexes_.clear();
+        ++generation_;
+    }
+private:
+    HandleValidationRegexesCache() : generation_{0} { }
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<const HandleValidationRegexes>> regexes_;
+    unsigned long long generation_;
+};
+
+std::set<std::string> get_invalid_handles_by_database(
+        const OperationContext& ctx,
+        const std::string& object_type_name,
+        const std::vector<std::string>& handles)
+{
+    const Database::Result db_res = ctx.get_conn().exec_params(
+        Database::ParamQuery(
+        "WITH "
+            "regexes AS "
+            "(")(make_handle_validation_regexes_query(object_type_name))(
+            "), "
+            "handles(handle) AS "
+            "( "
+                "SELECT DISTINCT UNNEST(").param_text_array(handles)(") "
+            ") "
+        "SELECT h.handle "
+        "FROM handles h "
+        "WHERE h.handle IS NULL OR "
+              "EXISTS(SELECT FROM regexes r WHERE NOT h.handle ~ ('^' || r.regex || '$'))"));
+    std::set<std::string> invalid_handles;
+    for (Database::Result::size_type idx = 0; idx < db_res.size(); ++idx)
+    {
+        invalid_handles.insert(static_cast<std::string>(db_res[idx][0]));
+    }
+    return invalid_handles;
+}
+
+}//namespace LibFred::{anonymous}
+
 template <Object_Type::Enum TYPE_OF_OBJECT>
 TestHandleOf<TYPE_OF_OBJECT>::TestHandleOf(const std::string &_handle)
 :   handle_(_handle)
@@ -34,40 +178,30 @@ TestHandleOf<TYPE_OF_OBJECT>::TestHandleOf(const std::string &_handle)
 
 template <Object_Type::Enum TYPE_OF_OBJECT>
 bool TestHandleOf< TYPE_OF_OBJECT >::is_invalid_handle(const OperationContext& _ctx)const
+{
+    return !get_invalid_handles(_ctx, { handle_ }).empty();
+}
+
+template <Object_Type::Enum TYPE_OF_OBJECT>
+std::set<std::string> TestHandleOf<TYPE_OF_OBJECT>::get_invalid_handles(
+        const OperationContext& _ctx,
+        const std::vector<std::string>& _handles)
 {
     const std::string object_type_name = Conversion::Enums::to_db_handle(TYPE_OF_OBJECT);
-    const Database::Result db_res = _ctx.get_conn().exec_params(
-        "WITH "
-            "regexes AS "
-            "( "
-                "SELECT rc.regex AS regex "
-                "FROM enum_object_type eot "
-                "JOIN regex_object_type_handle_validation_checker_map rm ON eot.id=rm.type_id "
-                "JOIN regex_handle_validation_checker rc ON rc.id=rm.checker_id "
-                "WHERE eot.name=$1::text "
-            "), "
-            "regexes_count(n) AS "
-            "( "
-                "SELECT COUNT(*) "
-                "FROM regexes "
-            "), "
-            "matches AS "
-            "( "
-                "SELECT regex "
-                "FROM regexes "
-                "WHERE $2::text ~ ('^' || regex || '$') "
-            "), "
-            "matches_count(n) AS "
-            "( "
-                "SELECT COUNT(*) "
-                "FROM matches "
-            ") "
-        "SELECT regexes_count.n - matches_count.n "
-        "FROM regexes_count CROSS JOIN matches_count",
-        Database::query_param_list(object_type_name)
-                                  (handle_));
+    const auto regexes = HandleValidationRegexesCache::get_instance().get(_ctx, object_type_name);
+    if (regexes->is_evaluated_by_database())
+    {
+        return get_invalid_handles_by_database(_ctx, object_type_name, _handles);
+    }
+    std::set<std::string> invalid_handles;
+    std::copy_if(_handles.begin(), _handles.end(), std::inserter(invalid_handles, invalid_handles.end()),
+                 [&](const std::string& handle) { return !regexes->is_valid(handle); });
+    return invalid_handles;
+}
 
-    return db_res.size() != 1 || db_res[0][0].isnull() || static_cast<int>(db_res[0][0]) != 0;
+void invalidate_handle_validation_regexes()
+{
+    HandleValidationRegexesCache::get_instance().invalidate();
 }
 
 
@@ -75,21 +209,24 @@ template <Object_Type::Enum TYPE_OF_OBJECT>
 bool TestHandleOf<TYPE_OF_OBJECT>::is_protected(const OperationContext& _ctx)const
 {
     static const char *const parameter_name = "handle_registration_protection_period";
-    const std::string object_type_name = Conversion::Enums::to_db_handle(TYPE_OF_OBJECT);
+    const auto metadata = get_registry_metadata(_ctx);
+    const auto protection_period = metadata->find_parameter(parameter_name);
+    if (protection_period == boost::none)
+    {
+        return false;
+    }
     const Database::Result db_res = _ctx.get_conn().exec_params(
         "WITH obj AS "
             "(SELECT obr.id,"
-                    "CURRENT_TIMESTAMP<(obr.erdate+(ep.val||'MONTH')::INTERVAL) AS protected "
-            "FROM enum_parameters ep,"
-                  "object_registry obr "
-            "WHERE ep.name=$1::TEXT AND "
-                   "obr.type=get_object_type_id($2::TEXT) AND "
+                    "CURRENT_TIMESTAMP<(obr.erdate+($1::TEXT||'MONTH')::INTERVAL) AS protected "
+            "FROM object_registry obr "
+            "WHERE obr.type=$2::BIGINT AND "
                    "UPPER(obr.name)=UPPER($3::TEXT) "
             "FOR SHARE of obr) "
         "SELECT protected FROM obj "
         "ORDER BY id DESC LIMIT 1",
-        Database::query_param_list(parameter_name)
-                                  (object_type_name)
+        Database::query_param_list(*protection_period)
+                                  (metadata->get_object_type_id(TYPE_OF_OBJECT))
                                   (handle_));
 
     return (db_res.size() == 1) && !db_res[0][0].isnull() && static_cast<bool>(db_res[0][0]);
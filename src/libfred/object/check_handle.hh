@@ -29,6 +29,11 @@
 
 #include <boost/mpl/assert.hpp>
 
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
 namespace LibFred {
 
 template <Object_Type::Enum TYPE_OF_OBJECT>
@@ -40,6 +45,9 @@ public:
     //check handle syntax
     bool is_invalid_handle(const OperationContext& _ctx)const;
 
+    //check syntax of many handles at once, returns handles with invalid syntax
+    static std::set<std::string> get_invalid_handles(const OperationContext& _ctx, const std::vector<std::string>& _handles);
+
     //check if handle is in protected period
     bool is_protected(const OperationContext& _ctx)const;
 
@@ -54,6 +62,15 @@ private:
                          unavailable_for_this_type_of_object, (Object_Type::Enum));
 };
 
+/**
+ * Handle validation regexes are loaded from database once per type of object and kept compiled
+ * in process-wide cache for at most handle_validation_regexes_ttl.
+ * Drop them, they are loaded again by the next check of handle syntax.
+ */
+void invalidate_handle_validation_regexes();
+
+constexpr std::chrono::seconds handle_validation_regexes_ttl{60};
+
 }//namespace LibFred
 
 #endif//CHECK_HANDLE_HH_86E459F246F043259DB898F445EEB82A
@@ -28,20 +28,14 @@
 #include "libfred/opcontext.hh"
 
 #include "libfred/object/object_impl.hh"
+#include "libfred/registry_metadata.hh"
 
 namespace LibFred
 {
 
     unsigned long long get_object_type_id(const OperationContext& ctx, const std::string& obj_type)
     {
-        const Database::Result object_type_res = ctx.get_conn().exec_params(
-            "SELECT id FROM enum_object_type WHERE name = $1::text FOR SHARE"
-            , Database::query_param_list(obj_type));
-        if (object_type_res.size() != 1)
-        {
-            BOOST_THROW_EXCEPTION(InternalError("failed to get object type"));
-        }
-        return  static_cast<unsigned long long> (object_type_res[0][0]);
+        return get_registry_metadata(ctx)->get_object_type_id(obj_type);
     }
 
 } // namespace LibFred
@@ -25,14 +25,16 @@
 #define OBJECT_IMPL_HH_38C1FBA33F194F939B09B6939D286CD6
 
 #include <string>
+#include <vector>
 
 #include "libfred/opexception.hh"
 #include "libfred/opcontext.hh"
+#include "util/db/param_query_composition.hh"
 
 namespace LibFred
 {
     /**
-    * Check existence, get database id and lock object type for read.
+    * Check existence and get database id of object type from registry metadata snapshot.
     * @param ctx contains reference to database and logging interface
     * @param obj_type is object type to look for in enum_object_type table, throw InternalError if not found
     * @return database id of the object type
@@ -93,6 +95,69 @@ namespace LibFred
         return  static_cast<unsigned long long> (object_id_res[0][0]);
     }
 
+    /**
+    * Gets ids of many objects by handles and object type name and locks their object_registry rows for update or for share by one query.
+    * Rows are locked in ascending order of object ids.
+    * @param EXCEPTION is type of exception used for reporting when object is not found, deducible from type of @ref ex_ptr parameter
+    * @param EXCEPTION_OBJECT_HANDLE_SETTER is EXCEPTION member function pointer used to report unknown object handle
+    * @param ctx contains reference to database and logging interface
+    * @param lock_for_update if true then locks for update if false then locks for share
+    * @param object_handles are handles to look for (not fqdns of domains)
+    * @param object_type is name from enum_object_type, if not found throws InternallError
+    * @param ex_ptr is pointer to given exception instance to be set (don't throw except for object_type), if ex_ptr is 0, new exception instance is created, set and thrown
+    * @param ex_handle_setter is EXCEPTION member function pointer used to report unknown object handle
+    * @return database ids of the objects in order of given handles
+    * , or throw @ref EXCEPTION with the first unknown object handle if external exception instance was not provided
+    * , or set every unknown object handle into given external exception instance and return 0 in place of its id
+    * , or throw InternalError or some other exception in case of failure.
+    */
+    template <class EXCEPTION, typename EXCEPTION_OBJECT_HANDLE_SETTER>
+    std::vector<unsigned long long> get_object_ids_by_handles_and_type_with_lock(const OperationContext& ctx
+            , const bool lock_for_update
+            , const std::vector<std::string>& object_handles, const std::string& object_type
+            , EXCEPTION* ex_ptr, EXCEPTION_OBJECT_HANDLE_SETTER ex_handle_setter)
+    {
+        const unsigned long long object_type_id = get_object_type_id(ctx, object_type);
+        std::vector<unsigned long long> object_ids(object_handles.size(), 0);
+        if (object_handles.empty())
+        {
+            return object_ids;
+        }
+
+        const Database::Result object_id_res = ctx.get_conn().exec_params(Database::ParamQuery(
+        "SELECT h.idx, oreg.id FROM UNNEST(").param_text_array(object_handles)(") WITH ORDINALITY AS h(handle, idx) "
+        " JOIN object_registry oreg ON oreg.name = UPPER(h.handle) AND oreg.type = ").param_bigint(object_type_id)(" "
+        " WHERE oreg.erdate IS NULL "
+        " ORDER BY oreg.id, h.idx")
+        (lock_for_update
+           ? " FOR UPDATE OF oreg"
+           : " FOR SHARE OF oreg"));
+
+        for (std::size_t i = 0; i < object_id_res.size(); ++i)
+        {
+            auto& object_id = object_ids.at(static_cast<std::size_t>(object_id_res[i][0]) - 1);
+            if (object_id != 0)
+            {
+                BOOST_THROW_EXCEPTION(InternalError("failed to get object handle"));
+            }
+            object_id = static_cast<unsigned long long>(object_id_res[i][1]);
+        }
+        for (std::size_t i = 0; i < object_ids.size(); ++i)
+        {
+            if (object_ids[i] != 0)
+            {
+                continue;
+            }
+            if (ex_ptr == 0)//make new exception instance, set data and throw
+            {
+                BOOST_THROW_EXCEPTION((EXCEPTION().*ex_handle_setter)(object_handles[i]));
+            }
+            //set unknown handle to given exception instance (don't throw)
+            (ex_ptr->*ex_handle_setter)(object_handles[i]);
+        }
+        return object_ids;
+    }
+
     /**
     * Locks object for update.
     * @param EXCEPTION is type of exception used for reporting when object is not found, deducible from type of @ref ex_ptr parameter
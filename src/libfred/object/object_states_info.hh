@@ -22,7 +22,8 @@
 #include "libfred/object/object_state.hh"
 #include "libfred/object_state/get_object_states.hh"
 
-#include <set>
+#include <bitset>
+#include <cstddef>
 
 namespace LibFred {
 
@@ -32,18 +33,28 @@ public:
     typedef std::vector<ObjectStateData> ObjectStates;
 
 
+    ObjectStatesInfo() = default;
+
+
     explicit ObjectStatesInfo(const ObjectStates& _object_states)
     {
         for (ObjectStates::const_iterator object_state = _object_states.begin(); object_state != _object_states.end(); ++object_state)
         {
-            presents_.insert(Conversion::Enums::from_db_handle<Object_State>(object_state->state_name));
+            this->set(Conversion::Enums::from_db_handle<Object_State>(object_state->state_name));
         }
     }
 
 
+    ObjectStatesInfo& set(Object_State::Enum _state)
+    {
+        presents_.set(_state);
+        return *this;
+    }
+
+
     bool presents(Object_State::Enum _state) const
     {
-        return presents_.find(_state) != presents_.end();
+        return presents_.test(_state);
     }
 
 
@@ -54,7 +65,8 @@ public:
 
 
 private:
-    typedef std::set<Object_State::Enum> SetOfStates;
+    static constexpr std::size_t number_of_states = Object_State::server_contact_permanent_address_change_prohibited + 1;
+    typedef std::bitset<number_of_states> SetOfStates;
 
     SetOfStates presents_;
 };
@@ -22,11 +22,15 @@
 #include "libfred/object/check_authinfo.hh"
 #include "libfred/object/clean_authinfo.hh"
 #include "libfred/object/object.hh"
+#include "libfred/object/object_type.hh"
 #include "libfred/object/transfer_object_exception.hh"
-#include "libfred/registrable_object/contact/info_contact.hh"
 #include "libfred/registrar/info_registrar.hh"
+#include "libfred/registry_metadata.hh"
 
-#include <algorithm>
+#include "util/db/param_query_composition.hh"
+
+#include <string>
+#include <vector>
 
 namespace LibFred {
 
@@ -89,37 +93,39 @@ auto set_history_id(
     return _history_id;
 }
 
-auto get_authorized_contacts(
+//resolves handles of existing contacts to their ids, unknown handles are skipped
+std::vector<Object::ObjectId> get_contact_ids(
+        const LibFred::OperationContext& _ctx,
+        const std::set<std::string>& _contacts)
+{
+    const auto dbres = _ctx.get_conn().exec_params(Database::ParamQuery(
+            "SELECT id "
+              "FROM object_registry "
+             "WHERE name = ANY(SELECT UPPER(handle) FROM UNNEST(").param_text_array(std::vector<std::string>(_contacts.begin(), _contacts.end()))(") AS h(handle)) AND "
+                   "type = ").param_bigint(get_registry_metadata(_ctx)->get_object_type_id(Object_Type::contact))(" AND "
+                   "erdate IS NULL "
+             "ORDER BY id"));
+    std::vector<Object::ObjectId> contact_ids;
+    contact_ids.reserve(dbres.size());
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        contact_ids.push_back(Object::ObjectId{static_cast<unsigned long long>(dbres[idx][0])});
+    }
+    return contact_ids;
+}
+
+bool is_authorized_by_any_contact(
         const LibFred::OperationContext& _ctx,
         const std::string& _authinfopw,
         const std::set<std::string>& _contacts)
 {
-    std::set<std::string> authorized_contacts;
-    std::copy_if(
-            begin(_contacts),
-            end(_contacts),
-            std::inserter(authorized_contacts, end(authorized_contacts)),
-            [&](auto&& contact_handle)
-            {
-                try
-                {
-                    const auto contact_id = Object::ObjectId{InfoContactByHandle{contact_handle}
-                                                    .exec(_ctx).info_contact_data.id};
-                    return 0 < Object::CheckAuthinfo{Object::ObjectId{contact_id}}
-                                        .exec(_ctx, _authinfopw, Object::CheckAuthinfo::increment_usage);
-                }
-                catch (const InfoContactByHandle::Exception& e)
-                {
-                    if (!e.is_set_unknown_contact_handle())
-                    {
-                        throw;
-                    }
-                }
-                catch (const UnknownObjectId&)
-                { }
-                return false;
-            });
-    return authorized_contacts;
+    if (_contacts.empty())
+    {
+        return false;
+    }
+    const auto contact_ids = get_contact_ids(_ctx, _contacts);
+    return !Object::CheckAuthinfoOfAnyObject{contact_ids}
+            .exec(_ctx, _authinfopw, Object::CheckAuthinfo::increment_usage).empty();
 }
 
 }//namespace LibFred::{anonymous}
@@ -156,7 +162,7 @@ unsigned long long transfer_object(
 
     const auto authinfo_of_object_used = 0 < Object::CheckAuthinfo{Object::ObjectId{_object_id}}
             .exec(_ctx, _authinfopw, Object::CheckAuthinfo::increment_usage_and_cancel);
-    const auto authinfo_of_friendly_contacts_used = !get_authorized_contacts(_ctx, _authinfopw, _enabled_contacts).empty();
+    const auto authinfo_of_friendly_contacts_used = is_authorized_by_any_contact(_ctx, _authinfopw, _enabled_contacts);
     if (!(authinfo_of_object_used || authinfo_of_friendly_contacts_used))
     {
         throw IncorrectAuthInfoPw{};
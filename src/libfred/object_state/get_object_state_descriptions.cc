@@ -22,6 +22,9 @@
  */
 
 #include "libfred/object_state/get_object_state_descriptions.hh"
+#include "libfred/registry_metadata.hh"
+
+#include <boost/optional.hpp>
 
 namespace LibFred {
 
@@ -44,34 +47,28 @@ GetObjectStateDescriptions& GetObjectStateDescriptions::set_object_type(const st
 
 std::vector<ObjectStateDescription> GetObjectStateDescriptions::exec(const OperationContext& ctx)
 {
-    Database::ParamQuery query(
-        "SELECT eosd.state_id,"
-               "eos.name,"
-               "eosd.description "
-        "FROM enum_object_states_desc eosd "
-        "JOIN enum_object_states eos ON eos.id=eosd.state_id");
-
-    if (external_states)
-    {
-        query(" AND eos.external");
-    }
-
+    const auto metadata = get_registry_metadata(ctx);
+    boost::optional<unsigned long long> object_type_id;
     if (!object_type_.empty())
     {
-        query(" AND (SELECT id FROM enum_object_type WHERE name=").param_text(object_type_)(")=ANY(eos.types)");
+        object_type_id = metadata->find_object_type_id(object_type_);
+        if (object_type_id == boost::none)
+        {
+            return std::vector<ObjectStateDescription>();
+        }
     }
 
-    query(" WHERE UPPER(eosd.lang)=UPPER(").param_text(description_language_)(")");
-
-    const Database::Result object_state_descriptions_result = ctx.get_conn().exec_params(query);
-
     std::vector<ObjectStateDescription> result;
-    for (unsigned long long idx = 0 ; idx < object_state_descriptions_result.size() ; ++idx)
+    for (const auto& description : metadata->get_object_state_descriptions(description_language_))
     {
-        result.push_back(ObjectStateDescription(
-            static_cast<unsigned long long>(object_state_descriptions_result[idx][0]),
-            static_cast<std::string>(object_state_descriptions_result[idx][1]),
-            static_cast<std::string>(object_state_descriptions_result[idx][2])));
+        const auto* const state = metadata->find_object_state(description.state_id);
+        if ((state == nullptr) ||
+            (external_states && !state->external) ||
+            ((object_type_id != boost::none) && !state->is_applicable_to(*object_type_id)))
+        {
+            continue;
+        }
+        result.push_back(ObjectStateDescription(state->id, state->name, description.description));
     }
     return result;
 }
@@ -23,8 +23,7 @@
 
 #include "libfred/object_state/get_object_state_id_map.hh"
 #include "libfred/opcontext.hh"
-
-#include <sstream>
+#include "libfred/registry_metadata.hh"
 
 namespace LibFred {
 
@@ -65,27 +64,14 @@ GetObjectStateIdMap::StateIdMap& GetObjectStateIdMap::get_result(
     {
         return _result;
     }
-    StatusList::const_iterator pState = _status_list.begin();
-    Database::query_param_list param(_object_type);
-    param(*pState);
-    ++pState;
-    std::ostringstream query;
-    query << "SELECT id,name "
-             "FROM enum_object_states "
-             "WHERE $1::INTEGER=ANY(types) AND "
-                   "name IN ($" << param.size() << "::TEXT";
-    while (pState != _status_list.end())
-    {
-        param(*pState);
-        query << ",$" << param.size() << "::TEXT";
-        ++pState;
-    }
-    query << ")";
-    const Database::Result id_name_result = _ctx.get_conn().exec_params(query.str(), param);
-    for (::size_t rowIdx = 0; rowIdx < id_name_result.size(); ++rowIdx)
+    const auto metadata = get_registry_metadata(_ctx);
+    for (const auto& state_name : _status_list)
     {
-        const Database::Row& row = id_name_result[rowIdx];
-        _result[row[1]] = row[0];
+        const auto* const state = metadata->find_object_state(state_name);
+        if ((state != nullptr) && state->is_applicable_to(_object_type))
+        {
+            _result[state_name] = state->id;
+        }
     }
     return _result;
 }
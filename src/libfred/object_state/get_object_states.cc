@@ -45,28 +45,32 @@ namespace LibFred
                 " AND (os.valid_to IS NULL OR os.valid_to > CURRENT_TIMESTAMP) "
         " ORDER BY eos.importance "
         , Database::query_param_list(object_id_)
+        , Database::ResultFormat::binary
         );
 
         std::vector<ObjectStateData> result;
         result.reserve(domain_states_result.size());
         for (unsigned long long i = 0 ; i < domain_states_result.size() ; ++i)
         {
+            const Database::Row row = domain_states_result[i];
             ObjectStateData osd;
-            osd.state_id = static_cast<unsigned long long>(domain_states_result[i][0]);
-            osd.state_name = static_cast<std::string>(domain_states_result[i][1]);
-            osd.valid_from_time = boost::posix_time::time_from_string(static_cast<std::string>(domain_states_result[i][2]));
-            osd.valid_to_time = domain_states_result[i][3].isnull() ? Nullable<boost::posix_time::ptime>()
-                : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
-                static_cast<std::string>(domain_states_result[i][3])));
+            osd.state_id = row.get<unsigned long long>(0);
+            osd.state_name = row.get<std::string>(1);
+            osd.valid_from_time = row.get<boost::posix_time::ptime>(2);
+            const auto valid_to_time = row.get<boost::optional<boost::posix_time::ptime>>(3);
+            osd.valid_to_time = valid_to_time == boost::none ? Nullable<boost::posix_time::ptime>()
+                : Nullable<boost::posix_time::ptime>(*valid_to_time);
 
-            osd.valid_from_history_id = domain_states_result[i][4].isnull() ? Nullable<unsigned long long>()
-                    : Nullable<unsigned long long>(static_cast<unsigned long long>(domain_states_result[i][4]));
-            osd.valid_to_history_id = domain_states_result[i][5].isnull() ? Nullable<unsigned long long>()
-                    : Nullable<unsigned long long>(static_cast<unsigned long long>(domain_states_result[i][5]));
+            const auto valid_from_history_id = row.get<boost::optional<unsigned long long>>(4);
+            osd.valid_from_history_id = valid_from_history_id == boost::none ? Nullable<unsigned long long>()
+                    : Nullable<unsigned long long>(*valid_from_history_id);
+            const auto valid_to_history_id = row.get<boost::optional<unsigned long long>>(5);
+            osd.valid_to_history_id = valid_to_history_id == boost::none ? Nullable<unsigned long long>()
+                    : Nullable<unsigned long long>(*valid_to_history_id);
 
-            osd.is_external = static_cast<bool>(domain_states_result[i][6]);
-            osd.is_manual = static_cast<bool>(domain_states_result[i][7]);
-            osd.importance = static_cast<long>(domain_states_result[i][8]);
+            osd.is_external = row.get<bool>(6);
+            osd.is_manual = row.get<bool>(7);
+            osd.importance = row.get<long>(8);
 
             result.push_back(osd);
         }//for i
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  get states of many objects at once
+ */
+
+#include "libfred/object_state/get_object_states_of_many.hh"
+#include "util/db/param_query_composition.hh"
+
+#include <utility>
+
+namespace LibFred
+{
+
+    GetObjectStatesOfMany::GetObjectStatesOfMany(std::vector<unsigned long long> object_ids)
+    : object_ids_(std::move(object_ids))
+    {}
+
+    std::unordered_map<unsigned long long, ObjectStatesInfo> GetObjectStatesOfMany::exec(const OperationContext& ctx)const
+    {
+        std::unordered_map<unsigned long long, ObjectStatesInfo> result;
+        result.reserve(object_ids_.size());
+        for (const auto object_id : object_ids_)
+        {
+            result[object_id];
+        }
+        if (object_ids_.empty())
+        {
+            return result;
+        }
+        const Database::Result states_result = ctx.get_conn().exec_params(Database::ParamQuery(
+        "SELECT os.object_id, eos.name "
+        " FROM object_state os "
+            " JOIN enum_object_states eos ON eos.id = os.state_id "
+            " WHERE os.object_id = ANY(").param_bigint_array(object_ids_)(") "
+                " AND os.valid_from <= CURRENT_TIMESTAMP "
+                " AND (os.valid_to IS NULL OR os.valid_to > CURRENT_TIMESTAMP)")
+        , Database::ResultFormat::binary);
+
+        for (unsigned long long i = 0 ; i < states_result.size() ; ++i)
+        {
+            const Database::Row row = states_result[i];
+            result[row.get<unsigned long long>(0)].set(
+                    Conversion::Enums::from_db_handle<Object_State>(row.get<std::string>(1)));
+        }
+        return result;
+    }
+
+} // namespace LibFred
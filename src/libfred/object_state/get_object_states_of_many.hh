@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  get states of many objects at once
+ */
+
+#ifndef GET_OBJECT_STATES_OF_MANY_HH_1F1C596DFB994578884DEEB2A1DECDDA
+#define GET_OBJECT_STATES_OF_MANY_HH_1F1C596DFB994578884DEEB2A1DECDDA
+
+#include "libfred/object/object_states_info.hh"
+#include "libfred/opcontext.hh"
+
+#include <unordered_map>
+#include <vector>
+
+namespace LibFred
+{
+    /**
+     * Gets current states of many objects by one query.
+     * Object database ids are set via constructor.
+     * It's executed by @ref exec method with database connection supplied in @ref OperationContext parameter.
+     */
+    class GetObjectStatesOfMany
+    {
+    public:
+        /**
+         * @param object_ids sets database ids of the objects @ref object_ids_ attribute
+         */
+        explicit GetObjectStatesOfMany(std::vector<unsigned long long> object_ids);
+        /**
+         * Executes getting states of given objects.
+         * @param ctx contains reference to database and logging interface
+         * @return states of every given object, objects without any state have empty states info
+         */
+        std::unordered_map<unsigned long long, ObjectStatesInfo> exec(const OperationContext& ctx)const;
+    private:
+        const std::vector<unsigned long long> object_ids_;/**< database ids of the objects */
+    };
+
+} // namespace LibFred
+
+#endif//GET_OBJECT_STATES_OF_MANY_HH_1F1C596DFB994578884DEEB2A1DECDDA
@@ -24,6 +24,7 @@
 #include "libfred/opcontext.hh"
 #include "libfred/db_settings.hh"
 #include "libfred/object_state/lock_object_state_request_lock.hh"
+#include "util/db/param_query_composition.hh"
 
 
 namespace LibFred
@@ -38,4 +39,19 @@ namespace LibFred
             Database::query_param_list(object_id_));
     }
 
+    LockObjectStateRequestLocks::LockObjectStateRequestLocks(std::vector<unsigned long long> object_ids)
+    : object_ids_(std::move(object_ids))
+    {}
+
+    void LockObjectStateRequestLocks::exec(const OperationContext& ctx)
+    {
+        if (object_ids_.empty())
+        {
+            return;
+        }
+        ctx.get_conn().exec_params(Database::ParamQuery(
+            "SELECT lock_object_state_request_lock(ids.id) "
+            "FROM (SELECT DISTINCT UNNEST(").param_bigint_array(object_ids_)(") AS id ORDER BY 1) ids"));
+    }
+
 } // namespace LibFred
@@ -25,6 +25,7 @@
 #define LOCK_OBJECT_STATE_REQUEST_LOCK_HH_354CB679B9FF4839A30A81D76DDCAF6E
 
 #include <string>
+#include <vector>
 
 #include "libfred/opcontext.hh"
 #include "util/optional_value.hh"
@@ -55,6 +56,26 @@ namespace LibFred
         const unsigned long long object_id_;/**< database id of the object */
     };
 
+    /**
+    * Locks states of many objects using object_state_request_lock table by one query.
+    * Objects are locked in ascending order of their database ids to prevent deadlocks.
+    */
+    class LockObjectStateRequestLocks
+    {
+    public:
+        /**
+        * @param object_ids sets database ids of the objects @ref object_ids_ attribute
+        */
+        explicit LockObjectStateRequestLocks(std::vector<unsigned long long> object_ids);
+        /**
+        * Executes object states lock using object_state_request_lock table.
+        * @param ctx contains reference to database and logging interface
+        */
+        void exec(const OperationContext& _ctx);
+    private:
+        const std::vector<unsigned long long> object_ids_;/**< database ids of the objects */
+    };
+
 } // namespace LibFred
 
 #endif
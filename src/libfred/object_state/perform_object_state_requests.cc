@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  perform object state requests of many objects in chunks
+ */
+
+#include "libfred/object_state/perform_object_state_requests.hh"
+
+#include "libfred/opcontext.hh"
+#include "libfred/object_state/lock_object_state_request_lock.hh"
+#include "util/db/param_query_composition.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace LibFred
+{
+
+namespace {
+
+constexpr std::size_t default_chunk_size = 1000;
+
+std::vector<unsigned long long> get_object_ids_in_range(
+        unsigned long long first_object_id,
+        unsigned long long last_object_id,
+        unsigned long long resume_after)
+{
+    OperationContextCreator ctx;
+    const Database::Result dbres = ctx.get_conn().exec_params(
+            "SELECT id FROM object_registry "
+            "WHERE $1::bigint <= id AND id <= $2::bigint AND $3::bigint < id "
+            "ORDER BY id",
+            Database::query_param_list(first_object_id)(last_object_id)(resume_after),
+            Database::ResultFormat::binary);
+    std::vector<unsigned long long> object_ids;
+    object_ids.reserve(dbres.size());
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        object_ids.push_back(dbres[idx].get<unsigned long long>(0));
+    }
+    return object_ids;
+}
+
+void perform_object_state_requests_of_chunk(const std::vector<unsigned long long>& object_ids)
+{
+    OperationContextCreator ctx;
+    LockObjectStateRequestLocks(object_ids).exec(ctx);
+    ctx.get_conn().exec_params(Database::ParamQuery(
+            "SELECT update_object_states(ids.id::integer) "
+            "FROM (SELECT UNNEST(").param_bigint_array(object_ids)(") AS id ORDER BY 1) ids"));
+    ctx.commit_transaction();
+}
+
+//tracks committed chunks, chunks are committed in any order but progress is reported continuously
+class ChunksCommitted
+{
+public:
+    ChunksCommitted(
+            const std::vector<unsigned long long>& object_ids,
+            std::size_t chunk_size,
+            unsigned long long resume_after,
+            const PerformObjectStateRequests::OnChunkCommitted& on_chunk_committed)
+        : object_ids_(object_ids),
+          chunk_size_(chunk_size),
+          committed_(get_number_of_chunks(), false),
+          first_uncommitted_(0),
+          number_of_processed_objects_(0),
+          processed_up_to_object_id_(resume_after),
+          on_chunk_committed_(on_chunk_committed)
+    { }
+    std::size_t get_number_of_chunks() const
+    {
+        return (object_ids_.size() + chunk_size_ - 1) / chunk_size_;
+    }
+    std::vector<unsigned long long> get_chunk(std::size_t chunk_idx) const
+    {
+        const auto begin = object_ids_.begin() + chunk_idx * chunk_size_;
+        const auto end = object_ids_.begin() + std::min(object_ids_.size(), (chunk_idx + 1) * chunk_size_);
+        return std::vector<unsigned long long>(begin, end);
+    }
+    void set_committed(std::size_t chunk_idx, const std::vector<unsigned long long>& chunk)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        committed_[chunk_idx] = true;
+        number_of_processed_objects_ += chunk.size();
+        while ((first_uncommitted_ < committed_.size()) && committed_[first_uncommitted_])
+        {
+            ++first_uncommitted_;
+            processed_up_to_object_id_ = object_ids_[std::min(object_ids_.size(), first_uncommitted_ * chunk_size_) - 1];
+        }
+        if (on_chunk_committed_ != nullptr)
+        {
+            PerformObjectStateRequests::Progress progress;
+            progress.first_object_id = chunk.front();
+            progress.last_object_id = chunk.back();
+            progress.number_of_processed_objects = number_of_processed_objects_;
+            progress.number_of_objects = object_ids_.size();
+            progress.processed_up_to_object_id = processed_up_to_object_id_;
+            on_chunk_committed_(progress);
+        }
+    }
+    std::size_t get_number_of_processed_objects() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return number_of_processed_objects_;
+    }
+private:
+    const std::vector<unsigned long long>& object_ids_;
+    const std::size_t chunk_size_;
+    mutable std::mutex mutex_;
+    std::vector<bool> committed_;
+    std::size_t first_uncommitted_;
+    std::size_t number_of_processed_objects_;
+    unsigned long long processed_up_to_object_id_;
+    const PerformObjectStateRequests::OnChunkCommitted& on_chunk_committed_;
+};
+
+}//namespace LibFred::{anonymous}
+
+    PerformObjectStateRequests::PerformObjectStateRequests(std::vector<unsigned long long> _object_ids)
+    :   object_ids_(std::move(_object_ids)),
+        object_ids_range_(false),
+        chunk_size_(default_chunk_size),
+        number_of_workers_(std::max(std::thread::hardware_concurrency(), 1u)),
+        resume_after_(0)
+    {}
+
+    PerformObjectStateRequests::PerformObjectStateRequests(
+            unsigned long long _first_object_id,
+            unsigned long long _last_object_id)
+    :   object_ids_({ _first_object_id, _last_object_id }),
+        object_ids_range_(true),
+        chunk_size_(default_chunk_size),
+        number_of_workers_(std::max(std::thread::hardware_concurrency(), 1u)),
+        resume_after_(0)
+    {}
+
+    PerformObjectStateRequests& PerformObjectStateRequests::set_chunk_size(std::size_t _chunk_size)
+    {
+        if (_chunk_size == 0)
+        {
+            throw std::invalid_argument("chunk size must be greater than 0");
+        }
+        chunk_size_ = _chunk_size;
+        return *this;
+    }
+
+    PerformObjectStateRequests& PerformObjectStateRequests::set_number_of_workers(unsigned _number_of_workers)
+    {
+        if (_number_of_workers == 0)
+        {
+            throw std::invalid_argument("number of workers must be greater than 0");
+        }
+        number_of_workers_ = _number_of_workers;
+        return *this;
+    }
+
+    PerformObjectStateRequests& PerformObjectStateRequests::set_resume_after(unsigned long long _object_id)
+    {
+        resume_after_ = _object_id;
+        return *this;
+    }
+
+    PerformObjectStateRequests& PerformObjectStateRequests::set_on_chunk_committed(OnChunkCommitted _on_chunk_committed)
+    {
+        on_chunk_committed_ = std::move(_on_chunk_committed);
+        return *this;
+    }
+
+    std::size_t PerformObjectStateRequests::exec() const
+    {
+        std::vector<unsigned long long> object_ids;
+        if (object_ids_range_)
+        {
+            object_ids = get_object_ids_in_range(object_ids_.front(), object_ids_.back(), resume_after_);
+        }
+        else
+        {
+            object_ids = object_ids_;
+            std::sort(object_ids.begin(), object_ids.end());
+            object_ids.erase(std::unique(object_ids.begin(), object_ids.end()), object_ids.end());
+            object_ids.erase(
+                    object_ids.begin(),
+                    std::upper_bound(object_ids.begin(), object_ids.end(), resume_after_));
+        }
+        if (object_ids.empty())
+        {
+            return 0;
+        }
+
+        ChunksCommitted chunks(object_ids, chunk_size_, resume_after_, on_chunk_committed_);
+        const std::size_t number_of_chunks = chunks.get_number_of_chunks();
+        std::atomic<std::size_t> next_chunk_idx{0};
+        const auto process_next_chunks = [&]()
+        {
+            for (std::size_t chunk_idx = next_chunk_idx++; chunk_idx < number_of_chunks; chunk_idx = next_chunk_idx++)
+            {
+                const auto chunk = chunks.get_chunk(chunk_idx);
+                perform_object_state_requests_of_chunk(chunk);
+                chunks.set_committed(chunk_idx, chunk);
+            }
+        };
+        const auto number_of_workers = std::min<std::size_t>(number_of_chunks, number_of_workers_);
+        std::exception_ptr failure;
+        std::vector<std::future<void>> workers;
+        for (std::size_t cnt = 0; cnt < number_of_workers; ++cnt)
+        {
+            workers.push_back(std::async(std::launch::async, [&]()
+            {
+                try
+                {
+                    process_next_chunks();
+                }
+                catch (...)
+                {
+                    next_chunk_idx = number_of_chunks;//no more chunks for anybody
+                    throw;
+                }
+            }));
+        }
+        for (auto& worker : workers)
+        {
+            try
+            {
+                worker.get();
+            }
+            catch (...)
+            {
+                if (failure == nullptr)
+                {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        if (failure != nullptr)
+        {
+            std::rethrow_exception(failure);
+        }
+        return chunks.get_number_of_processed_objects();
+    }
+
+} // namespace LibFred
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  perform object state requests of many objects in chunks
+ */
+
+#ifndef PERFORM_OBJECT_STATE_REQUESTS_HH_6A0E3B5D91C24F7B8E2D4C17F05A93B8
+#define PERFORM_OBJECT_STATE_REQUESTS_HH_6A0E3B5D91C24F7B8E2D4C17F05A93B8
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace LibFred
+{
+    /**
+    * Process object state change requests of many objects.
+    * Objects are split into chunks of ascending database ids, every chunk is processed (and committed)
+    * in its own transaction on its own database connection, chunks are processed concurrently.
+    * Every object belongs to exactly one chunk and object state request locks of the chunk objects are
+    * taken in ascending order before processing, so the processing is serialized with all other operations
+    * using @ref LockObjectStateRequestLock on the same object.
+    * In case of insuperable failures and inconsistencies, exception is thrown.
+    */
+    class PerformObjectStateRequests
+    {
+    public:
+        /**
+         * Progress of the processing reported after each committed chunk.
+         */
+        struct Progress
+        {
+            unsigned long long first_object_id;/**< the lowest object id of the committed chunk */
+            unsigned long long last_object_id;/**< the highest object id of the committed chunk */
+            std::size_t number_of_processed_objects;/**< number of objects in all committed chunks */
+            std::size_t number_of_objects;/**< number of all objects to process */
+            /**
+             * All objects with id not greater than this one are processed (0 if none of them);
+             * it is the value usable in @ref set_resume_after in the case of interrupted processing.
+             */
+            unsigned long long processed_up_to_object_id;
+        };
+        using OnChunkCommitted = std::function<void(const Progress&)>;
+
+        /**
+         * Process object state change requests of given objects.
+         * @param _object_ids database ids of the objects, duplicities are ignored
+         */
+        explicit PerformObjectStateRequests(std::vector<unsigned long long> _object_ids);
+
+        /**
+         * Process object state change requests of all existing objects with database id in given range.
+         * @param _first_object_id the lowest object id
+         * @param _last_object_id the highest object id
+         */
+        PerformObjectStateRequests(unsigned long long _first_object_id, unsigned long long _last_object_id);
+
+        /**
+         * Sets maximal number of objects processed in one transaction.
+         * @param _chunk_size number of objects, must be greater than 0
+         * @return operation instance reference to allow method chaining
+         */
+        PerformObjectStateRequests& set_chunk_size(std::size_t _chunk_size);
+
+        /**
+         * Sets maximal number of concurrently used database connections.
+         * @param _number_of_workers number of connections, must be greater than 0
+         * @return operation instance reference to allow method chaining
+         */
+        PerformObjectStateRequests& set_number_of_workers(unsigned _number_of_workers);
+
+        /**
+         * Skips objects processed by a previous (interrupted) run.
+         * @param _object_id objects with id not greater than this one are not processed
+         * @return operation instance reference to allow method chaining
+         */
+        PerformObjectStateRequests& set_resume_after(unsigned long long _object_id);
+
+        /**
+         * Sets callback called after each committed chunk.
+         * @param _on_chunk_committed callback, calls are serialized
+         * @return operation instance reference to allow method chaining
+         */
+        PerformObjectStateRequests& set_on_chunk_committed(OnChunkCommitted _on_chunk_committed);
+
+        /**
+         * Executes object state change requests processing.
+         * Uses its own database connections, chunks committed before a failure stay committed.
+         * @return number of processed objects
+         * @throw the first exception thrown by the chunks processing
+         */
+        std::size_t exec() const;
+
+    private:
+        std::vector<unsigned long long> object_ids_;/**< database ids of the objects */
+        bool object_ids_range_;/**< object_ids_ contains the first and the last id of a range */
+        std::size_t chunk_size_;
+        unsigned number_of_workers_;
+        unsigned long long resume_after_;
+        OnChunkCommitted on_chunk_committed_;
+    };//class PerformObjectStateRequests
+
+} // namespace LibFred
+
+#endif
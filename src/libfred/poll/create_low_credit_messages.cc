@@ -20,17 +20,27 @@
 #include "libfred/opexception.hh"
 #include "util/db/query_param.hh"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 namespace LibFred {
 namespace Poll {
 
-unsigned long long CreateLowCreditMessages::exec(const OperationContext& _ctx) const
+namespace {
+
+//common table expressions tmp_message, tmp_invoice, tmp_poll_credit (messages to create) and the message insertion
+std::string make_low_credit_messages_query_part(
+        const std::function<std::string(const std::string& registrar_id_column)>& registrar_condition)
 {
-    const Database::Result sql_query_result = _ctx.get_conn().exec(
-        "WITH "
+    return
             "tmp_message AS "
             "("
                 "SELECT m.clid, pc.zone, MAX(m.crdate) AS crdate "
                 "FROM message m JOIN poll_credit pc ON m.id=pc.msgid "
+                "WHERE " + registrar_condition("m.clid") + " "
                 "GROUP BY m.clid, pc.zone "
             "), "
             "tmp_invoice AS "
@@ -38,6 +48,7 @@ unsigned long long CreateLowCreditMessages::exec(const OperationContext& _ctx) c
                 "SELECT i.registrar_id, i.zone_id, MAX(i.crdate) AS crdate "
                 "FROM invoice i "
                 "JOIN invoice_prefix ip ON i.invoice_prefix_id = ip.id AND ip.typ=0 "
+                "WHERE " + registrar_condition("i.registrar_id") + " "
                 "GROUP BY i.registrar_id, i.zone_id "
             "), "
             "tmp_poll_credit AS "
@@ -51,14 +62,23 @@ unsigned long long CreateLowCreditMessages::exec(const OperationContext& _ctx) c
                 "JOIN poll_credit_zone_limit l ON rc.zone_id = l.zone "
                 "LEFT JOIN tmp_message ON tmp_message.clid=rc.registrar_id AND tmp_message.zone=rc.zone_id "
                 "LEFT JOIN tmp_invoice ON tmp_invoice.registrar_id=rc.registrar_id AND tmp_invoice.zone_id=rc.zone_id "
-                "WHERE rc.credit < l.credlimit AND (tmp_message.crdate IS NULL OR tmp_message.crdate < tmp_invoice.crdate) "
+                "WHERE " + registrar_condition("rc.registrar_id") + " AND "
+                      "rc.credit < l.credlimit AND (tmp_message.crdate IS NULL OR tmp_message.crdate < tmp_invoice.crdate) "
             "), "
             "we_dont_care_because_we_dont_actually_use_the_name AS "
             "("
                 "INSERT INTO message (id, clid, crdate, exdate, seen, msgtype) "
                 "SELECT msgid, reg, CURRENT_TIMESTAMP, CURRENT_TIMESTAMP + INTERVAL '7days', false, 1 "
                 "FROM tmp_poll_credit "
-            ")"
+            ")";
+}
+
+}//namespace LibFred::Poll::{anonymous}
+
+unsigned long long CreateLowCreditMessages::exec(const OperationContext& _ctx) const
+{
+    const Database::Result sql_query_result = _ctx.get_conn().exec(
+        "WITH " + make_low_credit_messages_query_part([](const std::string&) { return std::string("TRUE"); }) +
         "INSERT INTO poll_credit (msgid, zone, credlimit, credit) "
         "SELECT msgid, zoneid, creditlimit, credititself "
         "FROM tmp_poll_credit");
@@ -66,6 +86,87 @@ unsigned long long CreateLowCreditMessages::exec(const OperationContext& _ctx) c
     return sql_query_result.rows_affected();
 }
 
+CreateLowCreditMessagesInChunks::CreateLowCreditMessagesInChunks(unsigned _chunk_size)
+    : chunk_size_(_chunk_size),
+      first_registrar_id_(0),
+      last_registrar_id_(std::numeric_limits<long long>::max())
+{
+    if (chunk_size_ == 0)
+    {
+        throw std::invalid_argument("chunk size must be greater than 0");
+    }
+}
+
+CreateLowCreditMessagesInChunks& CreateLowCreditMessagesInChunks::set_registrar_id_range(
+        unsigned long long _first_registrar_id,
+        unsigned long long _last_registrar_id)
+{
+    first_registrar_id_ = _first_registrar_id;
+    last_registrar_id_ = _last_registrar_id;
+    return *this;
+}
+
+CreateLowCreditMessagesInChunks::ChunkResult CreateLowCreditMessagesInChunks::exec_chunk(
+        const OperationContext& _ctx,
+        unsigned long long _after_registrar_id) const
+{
+    const auto after_registrar_id = std::max(_after_registrar_id, first_registrar_id_ == 0 ? 0 : first_registrar_id_ - 1);
+    const Database::Result dbres = _ctx.get_conn().exec_params(
+        "WITH "
+            "chunk AS "
+            "("
+                "SELECT id "
+                "FROM registrar "
+                "WHERE $1::BIGINT<id AND id<=$2::BIGINT "
+                "ORDER BY id "
+                "LIMIT $3::INT"
+            "), " +
+            make_low_credit_messages_query_part([](const std::string& registrar_id)
+                    {
+                        return registrar_id + " IN (SELECT id FROM chunk)";
+                    }) + ", "
+            "poll_credit_inserted AS "
+            "("
+                "INSERT INTO poll_credit (msgid, zone, credlimit, credit) "
+                "SELECT msgid, zoneid, creditlimit, credititself "
+                "FROM tmp_poll_credit "
+            ") "
+        "SELECT (SELECT MAX(id) FROM chunk), "
+               "(SELECT COUNT(*) FROM chunk), "
+               "(SELECT COUNT(*) FROM tmp_poll_credit)",
+        Database::query_param_list(after_registrar_id)(last_registrar_id_)(chunk_size_));
+    ChunkResult result;
+    result.last_registrar_id = dbres[0][0].isnull() ? after_registrar_id
+                                                    : static_cast<unsigned long long>(dbres[0][0]);
+    result.is_last = static_cast<unsigned long long>(dbres[0][1]) < chunk_size_;
+    result.number_of_messages = static_cast<unsigned long long>(dbres[0][2]);
+    return result;
+}
+
+unsigned long long CreateLowCreditMessagesInChunks::exec(
+        unsigned long long _after_registrar_id,
+        const OnChunkCommitted& _on_chunk_committed) const
+{
+    unsigned long long number_of_messages = 0;
+    unsigned long long after_registrar_id = _after_registrar_id;
+    while (true)
+    {
+        OperationContextCreator ctx;
+        const ChunkResult chunk = this->exec_chunk(ctx, after_registrar_id);
+        ctx.commit_transaction();
+        number_of_messages += chunk.number_of_messages;
+        if (_on_chunk_committed != nullptr)
+        {
+            _on_chunk_committed(chunk);
+        }
+        if (chunk.is_last)
+        {
+            return number_of_messages;
+        }
+        after_registrar_id = chunk.last_registrar_id;
+    }
+}
+
 } // namespace LibFred::Poll
 } // namespace LibFred
 
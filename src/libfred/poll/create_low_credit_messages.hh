@@ -21,6 +21,8 @@
 
 #include "libfred/opcontext.hh"
 
+#include <functional>
+
 namespace LibFred {
 namespace Poll {
 
@@ -29,6 +31,47 @@ struct CreateLowCreditMessages
     unsigned long long exec(const OperationContext& _ctx) const;
 };
 
+/**
+ * Creates low credit messages of registrars processed in chunks of ascending registrar ids.
+ * Workers running concurrently have to process disjoint ranges of registrar ids.
+ */
+class CreateLowCreditMessagesInChunks
+{
+public:
+    struct ChunkResult
+    {
+        unsigned long long last_registrar_id;/**< cursor, all registrars with id up to this one are processed */
+        bool is_last;/**< no more registrars in the range */
+        unsigned long long number_of_messages;/**< number of created messages */
+    };
+    using OnChunkCommitted = std::function<void(const ChunkResult&)>;
+
+    /**
+     * @param _chunk_size number of registrars processed in one chunk, must be greater than 0
+     */
+    explicit CreateLowCreditMessagesInChunks(unsigned _chunk_size);
+    /**
+     * Restricts processing to registrars with id in range [_first_registrar_id, _last_registrar_id].
+     */
+    CreateLowCreditMessagesInChunks& set_registrar_id_range(unsigned long long _first_registrar_id, unsigned long long _last_registrar_id);
+    /**
+     * Processes one chunk of registrars following the cursor within given transaction.
+     * @param _after_registrar_id cursor, the last registrar id of the previous chunk or 0
+     */
+    ChunkResult exec_chunk(const OperationContext& _ctx, unsigned long long _after_registrar_id) const;
+    /**
+     * Processes all chunks following the cursor, each one in its own committed transaction.
+     * @param _after_registrar_id cursor, the last registrar id of the previous (interrupted) run or 0
+     * @param _on_chunk_committed optional callback called after each committed chunk
+     * @return number of created messages
+     */
+    unsigned long long exec(unsigned long long _after_registrar_id, const OnChunkCommitted& _on_chunk_committed = nullptr) const;
+private:
+    unsigned chunk_size_;
+    unsigned long long first_registrar_id_;
+    unsigned long long last_registrar_id_;
+};
+
 } // namespace LibFred::Poll
 } // namespace LibFred
 
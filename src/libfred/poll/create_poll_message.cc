@@ -19,6 +19,7 @@
 
 #include "libfred/poll/create_poll_message.hh"
 #include "libfred/object/object_type.hh"
+#include "libfred/registry_metadata.hh"
 
 namespace LibFred {
 namespace Poll {
@@ -34,16 +35,14 @@ unsigned long long create_poll_eppaction_message(
     const Database::Result db_res = ctx.get_conn().exec_params(
             "WITH create_new_message AS ("
                 "INSERT INTO message (clid,crdate,exdate,seen,msgtype) "
-                "SELECT $2::BIGINT,NOW(),NOW()+'7DAY'::INTERVAL,false,id "
-                "FROM messagetype "
-                "WHERE name=$3::TEXT "
+                "VALUES ($2::BIGINT,NOW(),NOW()+'7DAY'::INTERVAL,false,$3::BIGINT) "
                 "RETURNING id AS msgid) "
             "INSERT INTO poll_eppaction (msgid,objid) "
             "SELECT msgid,$1::BIGINT FROM create_new_message "
             "RETURNING msgid",
             Database::query_param_list(action_history_id)
                                       (recipient_registrar_id)
-                                      (Conversion::Enums::to_db_handle(message_type)));
+                                      (get_registry_metadata(ctx)->get_message_type_id(message_type)));
     if (db_res.size() == 1)
     {
         return static_cast<unsigned long long>(db_res[0][0]);
@@ -20,6 +20,7 @@
 #include "util/db/query_param.hh"
 #include "libfred/opexception.hh"
 #include "libfred/poll/message_type.hh"
+#include "libfred/registry_metadata.hh"
 
 namespace LibFred {
 namespace Poll {
@@ -29,8 +30,7 @@ unsigned long long CreateRequestFeeInfoMessage::exec(const OperationContext& _ct
     const Database::Result sql_query_result = _ctx.get_conn().exec_params(
         "WITH create_new_message AS ( "
            "INSERT INTO message (clid, crdate, exdate, msgtype) "
-           "SELECT $2::bigint, current_timestamp, current_timestamp + interval '7 days', id "
-           "FROM messagetype WHERE name=$3::text "
+           "VALUES ($2::bigint, current_timestamp, current_timestamp + interval '7 days', $3::bigint) "
            "RETURNING id AS msgid) "
         "INSERT INTO poll_request_fee (msgid, period_from, period_to, total_free_count, used_count, price) "
         "SELECT msgid, ($4::timestamp AT TIME ZONE $1::text) AT TIME ZONE 'UTC', "
@@ -40,7 +40,7 @@ unsigned long long CreateRequestFeeInfoMessage::exec(const OperationContext& _ct
         Database::query_param_list
         (time_zone_)
         (registrar_id_)
-        (Conversion::Enums::to_db_handle(MessageType::request_fee_info))
+        (get_registry_metadata(_ctx)->get_message_type_id(MessageType::request_fee_info))
         (period_from_)
         (period_to_)
         (total_free_count_)
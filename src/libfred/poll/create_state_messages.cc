@@ -19,49 +19,40 @@
 #include "libfred/poll/create_state_messages.hh"
 #include "libfred/opexception.hh"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 
 namespace LibFred {
 namespace Poll {
 
-    CreateStateMessages::CreateStateMessages(
-            const std::set<LibFred::Poll::MessageType::Enum>& _except_list,
-            const boost::optional<int>& _limit)
-    : except_list_(_except_list),
-      limit_(_limit)
-{
-}
+namespace {
 
-unsigned long long CreateStateMessages::exec(const OperationContext& _ctx) const
+//common table expressions pfilter, sfilter and tfilter (state id, object type id, message type id)
+std::string make_state_message_type_filter(
+        const std::set<LibFred::Poll::MessageType::Enum>& except_list,
+        Database::query_param_list& query_parameters)
 {
     std::ostringstream argument_list_query_part;
-    std::ostringstream limit_query_part;
-
-    Database::query_param_list query_parameters;
-
-    if (!except_list_.empty())
+    if (!except_list.empty())
     {
         argument_list_query_part << "WHERE msgtypename NOT IN (";
-        for (const auto msg_type: except_list_)
+        bool is_first = true;
+        for (const auto msg_type: except_list)
         {
-            if (!query_parameters.empty())
+            if (!is_first)
             {
                 argument_list_query_part << ",";
             }
+            is_first = false;
             argument_list_query_part << "$"
                                      << query_parameters.add(Conversion::Enums::to_db_handle(msg_type))
                                      << "::TEXT";
         }
         argument_list_query_part << ")";
     }
-
-    if (limit_ != boost::none)
-    {
-        limit_query_part << "LIMIT $" << query_parameters.add(*limit_) << "::INT";
-    }
-
-    const std::string query =
-             "WITH "
+    return
                   "pfilter(stateidname, registrytypename, msgtypename) AS "
                   "( "
                       "VALUES  "
@@ -87,7 +78,33 @@ unsigned long long CreateStateMessages::exec(const OperationContext& _ctx) const
                       "JOIN enum_object_states eos ON eos.name=f.stateidname "
                       "LEFT JOIN enum_object_type eot ON eot.name=f.registrytypename "
                       "JOIN messagetype mt ON mt.name=f.msgtypename "
-                  "), "
+                  ") ";
+}
+
+}//namespace LibFred::Poll::{anonymous}
+
+    CreateStateMessages::CreateStateMessages(
+            const std::set<LibFred::Poll::MessageType::Enum>& _except_list,
+            const boost::optional<int>& _limit)
+    : except_list_(_except_list),
+      limit_(_limit)
+{
+}
+
+unsigned long long CreateStateMessages::exec(const OperationContext& _ctx) const
+{
+    std::ostringstream limit_query_part;
+
+    Database::query_param_list query_parameters;
+    const std::string filter_query_part = make_state_message_type_filter(except_list_, query_parameters);
+
+    if (limit_ != boost::none)
+    {
+        limit_query_part << "LIMIT $" << query_parameters.add(*limit_) << "::INT";
+    }
+
+    const std::string query =
+             "WITH " + filter_query_part + ", "
                   "tmp_table AS "
                   "( "
                       "SELECT nextval('message_id_seq') AS id, oh.clid AS reg, f.msgtype AS msgtype, os.id AS stateid "
@@ -116,5 +133,132 @@ unsigned long long CreateStateMessages::exec(const OperationContext& _ctx) const
     return sql_query_result.rows_affected();
 }
 
+CreateStateMessagesInChunks::CreateStateMessagesInChunks(
+        const std::set<LibFred::Poll::MessageType::Enum>& _except_list,
+        unsigned _chunk_size)
+    : except_list_(_except_list),
+      chunk_size_(_chunk_size),
+      first_state_id_(0),
+      last_state_id_(std::numeric_limits<long long>::max())
+{
+    if (chunk_size_ == 0)
+    {
+        throw std::invalid_argument("chunk size must be greater than 0");
+    }
+}
+
+CreateStateMessagesInChunks& CreateStateMessagesInChunks::set_state_id_range(
+        unsigned long long _first_state_id,
+        unsigned long long _last_state_id)
+{
+    first_state_id_ = _first_state_id;
+    last_state_id_ = _last_state_id;
+    return *this;
+}
+
+CreateStateMessagesInChunks::ChunkResult CreateStateMessagesInChunks::exec_chunk(
+        const OperationContext& _ctx,
+        unsigned long long _after_state_id) const
+{
+    Database::query_param_list query_parameters;
+    const std::string filter_query_part = make_state_message_type_filter(except_list_, query_parameters);
+    const auto after_state_id = std::max(_after_state_id, first_state_id_ == 0 ? 0 : first_state_id_ - 1);
+    const std::string after_state_id_param = "$" + query_parameters.add(after_state_id) + "::BIGINT";
+    const std::string last_state_id_param = "$" + query_parameters.add(last_state_id_) + "::BIGINT";
+    const std::string chunk_size_param = "$" + query_parameters.add(chunk_size_) + "::INT";
+
+    //chunk is given by valid object states only, already processed ones included, so the cursor always moves on
+    const std::string query =
+             "WITH " + filter_query_part + ", "
+                  "chunk AS "
+                  "( "
+                      "SELECT os.id "
+                      "FROM object_state os "
+                      "WHERE " + after_state_id_param + "<os.id AND os.id<=" + last_state_id_param + " AND "
+                            "os.valid_to IS NULL AND "
+                            "os.state_id IN (SELECT stateid FROM tfilter) "
+                      "ORDER BY os.id "
+                      "LIMIT " + chunk_size_param +
+                  "), "
+                  "tmp_table AS "
+                  "( "
+                      "SELECT nextval('message_id_seq') AS id, oh.clid AS reg, f.msgtype AS msgtype, os.id AS stateid "
+                      "FROM chunk c "
+                      "JOIN object_state os ON os.id=c.id "
+                      "JOIN object_registry ob ON ob.id=os.object_id "
+                      "JOIN object_history oh ON oh.historyid=os.ohid_from "
+                      "JOIN tfilter f ON f.stateid=os.state_id AND (f.registrytype IS NULL OR f.registrytype=ob.type) "
+                      "LEFT JOIN poll_statechange ps ON ps.stateid=os.id "
+                      "WHERE ps.stateid IS NULL "
+                      "ORDER BY os.id "
+                  "), "
+                  "message_inserted AS "
+                  "( "
+                      "INSERT INTO message (id, clid, crdate, exdate, seen, msgtype) "
+                      "SELECT id, reg, CURRENT_TIMESTAMP, CURRENT_TIMESTAMP + INTERVAL '7days', false, msgtype "
+                      "FROM tmp_table "
+                      "ORDER BY stateid "
+                  "), "
+                  "poll_statechange_inserted AS "
+                  "( "
+                      "INSERT INTO poll_statechange (msgid, stateid) "
+                      "SELECT id, stateid "
+                      "FROM tmp_table "
+                      "ORDER BY stateid "
+                  ") "
+             "SELECT c.last_state_id, c.number_of_states, mt.name, COUNT(t.id) "
+             "FROM (SELECT MAX(id) AS last_state_id, COUNT(*) AS number_of_states FROM chunk) c "
+             "LEFT JOIN tmp_table t ON TRUE "
+             "LEFT JOIN messagetype mt ON mt.id=t.msgtype "
+             "GROUP BY c.last_state_id, c.number_of_states, mt.name";
+
+    const Database::Result dbres = _ctx.get_conn().exec_params(query, query_parameters);
+    if (dbres.size() == 0)
+    {
+        throw std::runtime_error("unexpected empty result of state messages chunk processing");
+    }
+    ChunkResult result;
+    const auto number_of_states = static_cast<unsigned long long>(dbres[0][1]);
+    result.last_state_id = dbres[0][0].isnull() ? after_state_id
+                                                : static_cast<unsigned long long>(dbres[0][0]);
+    result.is_last = number_of_states < chunk_size_;
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        if (!dbres[idx][2].isnull())
+        {
+            result.number_of_messages[Conversion::Enums::from_db_handle<LibFred::Poll::MessageType>(
+                    static_cast<std::string>(dbres[idx][2]))] = static_cast<unsigned long long>(dbres[idx][3]);
+        }
+    }
+    return result;
+}
+
+CreateStateMessagesInChunks::NumberOfMessages CreateStateMessagesInChunks::exec(
+        unsigned long long _after_state_id,
+        const OnChunkCommitted& _on_chunk_committed) const
+{
+    NumberOfMessages number_of_messages;
+    unsigned long long after_state_id = _after_state_id;
+    while (true)
+    {
+        OperationContextCreator ctx;
+        const ChunkResult chunk = this->exec_chunk(ctx, after_state_id);
+        ctx.commit_transaction();
+        for (const auto& message_type_count : chunk.number_of_messages)
+        {
+            number_of_messages[message_type_count.first] += message_type_count.second;
+        }
+        if (_on_chunk_committed != nullptr)
+        {
+            _on_chunk_committed(chunk);
+        }
+        if (chunk.is_last)
+        {
+            return number_of_messages;
+        }
+        after_state_id = chunk.last_state_id;
+    }
+}
+
 } // namespace LibFred::Poll
 } // namespace LibFred
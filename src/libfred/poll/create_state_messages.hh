@@ -24,6 +24,8 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
+#include <map>
 #include <set>
 #include <string>
 
@@ -40,6 +42,52 @@ private:
     boost::optional<int> limit_;
 };
 
+/**
+ * Creates state messages of object states processed in chunks of ascending object state ids.
+ * Every chunk covers (at most) given number of valid object states following the cursor, so the work
+ * can be split into small transactions and continued from the last cursor after an interruption.
+ * Workers running concurrently have to process disjoint ranges of object state ids.
+ */
+class CreateStateMessagesInChunks
+{
+public:
+    using NumberOfMessages = std::map<LibFred::Poll::MessageType::Enum, unsigned long long>;
+    struct ChunkResult
+    {
+        unsigned long long last_state_id;/**< cursor, all object states with id up to this one are processed */
+        bool is_last;/**< no more object states in the range */
+        NumberOfMessages number_of_messages;/**< number of created messages of each type */
+    };
+    using OnChunkCommitted = std::function<void(const ChunkResult&)>;
+
+    /**
+     * @param _except_list types of messages not to create
+     * @param _chunk_size number of object states processed in one chunk, must be greater than 0
+     */
+    CreateStateMessagesInChunks(const std::set<LibFred::Poll::MessageType::Enum>& _except_list, unsigned _chunk_size);
+    /**
+     * Restricts processing to object states with id in range [_first_state_id, _last_state_id].
+     */
+    CreateStateMessagesInChunks& set_state_id_range(unsigned long long _first_state_id, unsigned long long _last_state_id);
+    /**
+     * Processes one chunk of object states following the cursor within given transaction.
+     * @param _after_state_id cursor, the last state id of the previous chunk or 0
+     */
+    ChunkResult exec_chunk(const OperationContext& _ctx, unsigned long long _after_state_id) const;
+    /**
+     * Processes all chunks following the cursor, each one in its own committed transaction.
+     * @param _after_state_id cursor, the last state id of the previous (interrupted) run or 0
+     * @param _on_chunk_committed optional callback called after each committed chunk
+     * @return number of created messages of each type
+     */
+    NumberOfMessages exec(unsigned long long _after_state_id, const OnChunkCommitted& _on_chunk_committed = nullptr) const;
+private:
+    std::set<LibFred::Poll::MessageType::Enum> except_list_;
+    unsigned chunk_size_;
+    unsigned long long first_state_id_;
+    unsigned long long last_state_id_;
+};
+
 } // namespace LibFred::Poll
 } // namespace LibFred
 
@@ -18,6 +18,10 @@
  */
 #include "libfred/registrable_object/contact/copy_history_impl.hh"
 
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
 namespace LibFred
 {
 
@@ -26,7 +30,8 @@ namespace LibFred
         const unsigned long long _contact_id,
         const unsigned long long _historyid
     ) {
-        const Database::Result res = _ctx.get_conn().exec_params(
+        auto pipeline = _ctx.get_conn().pipeline();
+        const std::size_t contact_history_idx = pipeline.add(
             "INSERT INTO contact_history( "
                 "historyid,  id, name, organization, street1, street2, street3, city, stateorprovince, postalcode, country, telephone, fax, email, notifyemail, vat, ssntype, ssn, "
                 "disclosename, discloseorganization, discloseaddress, disclosetelephone, disclosefax, discloseemail, disclosevat, discloseident, disclosenotifyemail, warning_letter "
@@ -40,11 +45,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_contact_id)
         );
 
-        if (res.rows_affected() != 1) {
-            throw std::runtime_error("INSERT INTO contact_history failed");
-        }
-
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO contact_address_history ( "
                 "historyid,  id, contactid, type, company_name, street1, street2, street3, city, stateorprovince, postalcode, country "
             ") "
@@ -54,5 +55,10 @@ namespace LibFred
             "FROM contact_address WHERE contactid=$2::bigint ",
             Database::query_param_list(_historyid)(_contact_id)
         );
+
+        const std::vector<Database::Result> results = pipeline.exec();
+        if (results[contact_history_idx].rows_affected() != 1) {
+            throw std::runtime_error("INSERT INTO contact_history failed");
+        }
     }
 }
@@ -16,18 +16,287 @@
  * You should have received a copy of the GNU General Public License
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include "libfred/registrable_object/contact/find_contact_duplicates.hh"
 
+#include "util/case_insensitive.hh"
 #include "util/optional_value.hh"
-#include "libfred/registrable_object/contact/find_contact_duplicates.hh"
 
-#include <boost/algorithm/string/join.hpp>
+#include <openssl/evp.h>
 
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace LibFred {
 namespace Contact {
 
+namespace {
+
+constexpr std::size_t number_of_contact_address_types = 5;
+const char* const contact_address_types[number_of_contact_address_types] =
+        { "MAILING", "BILLING", "SHIPPING", "SHIPPING_2", "SHIPPING_3" };
+
+//column indexes of contacts query
+constexpr int contact_handle_column = 0;
+constexpr int contact_id_column = 1;
+constexpr int first_contact_normalized_column = 2;
+constexpr int first_contact_exact_column = 17;
+constexpr int number_of_contact_columns = 30;
+
+//column indexes of contact addresses query
+constexpr int address_contact_id_column = 0;
+constexpr int address_type_column = 1;
+constexpr int first_address_normalized_column = 2;
+constexpr int number_of_address_columns = 10;
+
+using Fingerprint = std::array<unsigned char, 16>;
+
+bool is_space(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\f') || (c == '\v');
+}
+
+//removes leading and trailing whitespaces, the run of whitespaces is replaced by its first character
+//and letters are converted to upper case, so equal results mean equal database
+//LOWER(REGEXP_REPLACE(value, '^\s+|\s+$|(\s)\s+', '\1', 'g')) results
+std::string normalize(const std::string& value)
+{
+    std::string result;
+    result.reserve(value.size());
+    const char* const end = value.data() + value.size();
+    const char* c = value.data();
+    while ((c != end) && is_space(*c))
+    {
+        ++c;
+    }
+    while (c != end)
+    {
+        if (!is_space(*c))
+        {
+            result.push_back(*c);
+            ++c;
+            continue;
+        }
+        const char first_space = *c;
+        while ((c != end) && is_space(*c))
+        {
+            ++c;
+        }
+        if (c != end)
+        {
+            result.push_back(first_space);
+        }
+    }
+    return Util::to_upper_case(result);
+}
+
+class FingerprintComputation
+{
+public:
+    FingerprintComputation()
+        : md_ctx_(::EVP_MD_CTX_new(), ::EVP_MD_CTX_free)
+    {
+        if ((md_ctx_ == nullptr) || (::EVP_DigestInit_ex(md_ctx_.get(), ::EVP_sha256(), nullptr) != 1))
+        {
+            throw std::runtime_error("unable to initialize contact fingerprint computation");
+        }
+    }
+    //every item is prefixed by its kind and length, so different sequences of items never produce the same input
+    FingerprintComputation& add_null()
+    {
+        return this->add_bytes("N", 1);
+    }
+    FingerprintComputation& add_value(const std::string& value)
+    {
+        const unsigned long long length = value.size();
+        unsigned char prefix[1 + sizeof(length)];
+        prefix[0] = 'V';
+        std::memcpy(prefix + 1, &length, sizeof(length));
+        this->add_bytes(prefix, sizeof(prefix));
+        return this->add_bytes(value.data(), value.size());
+    }
+    FingerprintComputation& add_field(const Database::Value& value)
+    {
+        if (value.isnull())
+        {
+            return this->add_null();
+        }
+        return this->add_value(static_cast<std::string>(value));
+    }
+    //NULL and empty string are the same after the normalization
+    FingerprintComputation& add_normalized_field(const Database::Value& value)
+    {
+        if (value.isnull())
+        {
+            return this->add_value(std::string());
+        }
+        return this->add_value(normalize(static_cast<std::string>(value)));
+    }
+    Fingerprint get_result()
+    {
+        std::array<unsigned char, EVP_MAX_MD_SIZE> digest;
+        unsigned int digest_length = 0;
+        if ((::EVP_DigestFinal_ex(md_ctx_.get(), digest.data(), &digest_length) != 1) ||
+            (digest_length < std::tuple_size<Fingerprint>::value))
+        {
+            throw std::runtime_error("unable to compute contact fingerprint");
+        }
+        Fingerprint result;
+        std::copy(digest.begin(), digest.begin() + result.size(), result.begin());
+        return result;
+    }
+private:
+    FingerprintComputation& add_bytes(const void* data, std::size_t length)
+    {
+        if (::EVP_DigestUpdate(md_ctx_.get(), data, length) != 1)
+        {
+            throw std::runtime_error("unable to compute contact fingerprint");
+        }
+        return *this;
+    }
+    std::unique_ptr<::EVP_MD_CTX, void(*)(::EVP_MD_CTX*)> md_ctx_;
+};
+
+//indexes of contact addresses rows of one contact, by address type
+struct ContactAddresses
+{
+    std::bitset<number_of_contact_address_types> present;
+    std::array<std::size_t, number_of_contact_address_types> row_idx;
+};
+
+using AddressesOfContacts = std::unordered_map<unsigned long long, ContactAddresses>;
+
+AddressesOfContacts get_addresses_of_contacts(const Database::Result& addresses)
+{
+    AddressesOfContacts result;
+    for (std::size_t idx = 0; idx < addresses.size(); ++idx)
+    {
+        const auto type = static_cast<std::string>(addresses[idx][address_type_column]);
+        const auto type_itr = std::find(std::begin(contact_address_types), std::end(contact_address_types), type);
+        if (type_itr == std::end(contact_address_types))
+        {
+            continue;
+        }
+        const auto type_idx = static_cast<std::size_t>(type_itr - std::begin(contact_address_types));
+        auto& contact_addresses = result[static_cast<unsigned long long>(addresses[idx][address_contact_id_column])];
+        contact_addresses.present.set(type_idx);
+        contact_addresses.row_idx[type_idx] = idx;
+    }
+    return result;
+}
+
+Fingerprint get_contact_fingerprint(
+        const Database::Row& contact,
+        const Database::Result& addresses,
+        const AddressesOfContacts& addresses_of_contacts)
+{
+    FingerprintComputation fingerprint;
+    for (int column = first_contact_normalized_column; column < first_contact_exact_column; ++column)
+    {
+        fingerprint.add_normalized_field(contact[column]);
+    }
+    for (int column = first_contact_exact_column; column < number_of_contact_columns; ++column)
+    {
+        fingerprint.add_field(contact[column]);
+    }
+    const auto contact_addresses_itr = addresses_of_contacts.find(static_cast<unsigned long long>(contact[contact_id_column]));
+    for (std::size_t type_idx = 0; type_idx < number_of_contact_address_types; ++type_idx)
+    {
+        const bool address_present = (contact_addresses_itr != addresses_of_contacts.end()) &&
+                                     contact_addresses_itr->second.present.test(type_idx);
+        if (!address_present)
+        {
+            fingerprint.add_null();
+            continue;
+        }
+        const auto address = addresses[contact_addresses_itr->second.row_idx[type_idx]];
+        fingerprint.add_value(contact_address_types[type_idx]);
+        for (int column = first_address_normalized_column; column < number_of_address_columns; ++column)
+        {
+            fingerprint.add_normalized_field(address[column]);
+        }
+    }
+    return fingerprint.get_result();
+}
+
+struct FingerprintOfContact
+{
+    Fingerprint fingerprint;
+    std::size_t contact_idx;
+    friend bool operator<(const FingerprintOfContact& lhs, const FingerprintOfContact& rhs)
+    {
+        return std::tie(lhs.fingerprint, lhs.contact_idx) < std::tie(rhs.fingerprint, rhs.contact_idx);
+    }
+};
+
+//calls task(worker_idx) in number_of_workers concurrent threads, rethrows the first exception
+template <typename T>
+void run_concurrently(unsigned number_of_workers, T task)
+{
+    std::vector<std::future<void>> workers;
+    workers.reserve(number_of_workers);
+    for (unsigned worker_idx = 0; worker_idx < number_of_workers; ++worker_idx)
+    {
+        workers.push_back(std::async(std::launch::async, [&task, worker_idx]() { task(worker_idx); }));
+    }
+    std::exception_ptr failure;
+    for (auto& worker : workers)
+    {
+        try
+        {
+            worker.get();
+        }
+        catch (...)
+        {
+            if (failure == nullptr)
+            {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure != nullptr)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+bool have_intersection(const std::set<std::string>& lhs, const std::set<std::string>& rhs)
+{
+    auto lhs_itr = lhs.begin();
+    auto rhs_itr = rhs.begin();
+    while ((lhs_itr != lhs.end()) && (rhs_itr != rhs.end()))
+    {
+        if (*lhs_itr < *rhs_itr)
+        {
+            ++lhs_itr;
+        }
+        else if (*rhs_itr < *lhs_itr)
+        {
+            ++rhs_itr;
+        }
+        else
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}//namespace LibFred::Contact::{anonymous}
+
 FindContactDuplicates::FindContactDuplicates()
 {
 }
@@ -46,104 +315,112 @@ FindContactDuplicates& FindContactDuplicates::set_exclude_contacts(const std::se
 
 std::set<std::string> FindContactDuplicates::exec(const LibFred::OperationContext& _ctx)
 {
-    std::set<std::string> result;
-    Database::QueryParams dup_params;
-    std::vector<std::string> contact_address_types = Util::vector_of<std::string>
-            ("MAILING")
-            ("BILLING")
-            ("SHIPPING")
-            ("SHIPPING_2")
-            ("SHIPPING_3");
-    std::ostringstream dup_sql;
-    dup_sql << "SELECT unnest(dup_set)"
-        " FROM (SELECT array_agg(oreg.name) AS dup_set,";
-        for (std::vector<std::string>::const_iterator contact_address_type = contact_address_types.begin();
-            contact_address_type != contact_address_types.end();
-            ++contact_address_type)
-        {
-            dup_sql <<
-            " (SELECT row("
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.company_name, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.street1, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.street2, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.street3, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.city, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.stateorprovince, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.postalcode, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-               "COALESCE(LOWER(REGEXP_REPLACE(ca.country, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), '')) "
-              "FROM contact_address ca"
-             " WHERE ca.type = '" << *contact_address_type << "'"
-               " AND ca.contactid = c.id"
-            " ) AS " << *contact_address_type << "_addr" << (contact_address_type != contact_address_types.end() - 1 ? "," : "");
-        }
-    dup_sql <<
-        " FROM object_registry oreg"
-        " JOIN contact c ON c.id = oreg.id"
-        " JOIN object o ON o.id = c.id"
-        " JOIN registrar r ON r.id = o.clid";
-
-    if (registrar_handle_.isset()) {
-        dup_params.push_back(registrar_handle_.get_value());
-        dup_sql << " WHERE r.handle = $" << dup_params.size() << "::text";
-    }
-
-    dup_sql << " GROUP BY "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.name, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.organization, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(CAST(c.ssntype AS TEXT), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.ssn, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.vat, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.telephone, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.fax, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.email, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.notifyemail, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.street1, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.street2, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.street3, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.city, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.stateorprovince, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.postalcode, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "COALESCE(LOWER(REGEXP_REPLACE(c.country, '^\\s+|\\s+$|(\\s)\\s+', '\\1', 'g')), ''), "
-        "o.clid, "
-        "c.disclosename, "
-        "c.discloseorganization, "
-        "c.discloseaddress, "
-        "c.disclosetelephone, "
-        "c.disclosefax, "
-        "c.discloseemail, "
-        "c.disclosevat, "
-        "c.discloseident, "
-        "c.disclosenotifyemail, "
-        "COALESCE(CAST(c.warning_letter AS TEXT), ''),";
-    for (std::vector<std::string>::const_iterator contact_address_type = contact_address_types.begin();
-        contact_address_type != contact_address_types.end();
-        ++contact_address_type)
-    {
-        dup_sql <<
-        " " << *contact_address_type << "_addr" << (contact_address_type != contact_address_types.end() - 1 ? "," : "");
-    }
-    dup_sql << \
-        " HAVING array_upper(array_agg(oreg.name), 1) > 1";
-    if (!exclude_contacts_.empty()) {
-        std::vector<std::string> array_params;
-        for (std::set<std::string>::const_iterator i = exclude_contacts_.begin();
-                i != exclude_contacts_.end(); ++i)
-        {
-            dup_params.push_back(*i);
-            array_params.push_back("$" + boost::lexical_cast<std::string>(dup_params.size()));
-        }
-
-        dup_sql << " AND NOT (array_agg(oreg.name)"
-                << " && array[" << boost::algorithm::join(array_params, ", ") << "]::varchar[])";
-    }
-    dup_sql << " LIMIT 1) as dup_q";
-
-    const Database::Result dup_result = _ctx.get_conn().exec_params(dup_sql.str(), dup_params);
-
-    for (Database::Result::size_type i = 0; i < dup_result.size(); i++) {
-        result.insert(static_cast<std::string>(dup_result[i][0]));
+    auto duplicates = this->exec_all(_ctx);
+    if (duplicates.empty())
+    {
+        return std::set<std::string>();
+    }
+    return std::move(duplicates.front());
+}
+
+std::vector<std::set<std::string>> FindContactDuplicates::exec_all(const LibFred::OperationContext& _ctx)
+{
+    Database::QueryParams params;
+    std::string registrar_condition;
+    if (registrar_handle_.isset())
+    {
+        params.push_back(registrar_handle_.get_value());
+        registrar_condition = " JOIN registrar r ON r.id = o.clid AND r.handle = $1::text";
+    }
+    //raw data are fetched once, normalization, fingerprinting and grouping are done locally
+    const Database::Result contacts = _ctx.get_conn().exec_params(
+            "SELECT oreg.name, c.id, "
+                   "c.name, c.organization, c.ssn, c.vat, c.telephone, c.fax, c.email, c.notifyemail, "
+                   "c.street1, c.street2, c.street3, c.city, c.stateorprovince, c.postalcode, c.country, "
+                   "COALESCE(c.ssntype::text, ''), o.clid::text, "
+                   "c.disclosename::text, c.discloseorganization::text, c.discloseaddress::text, "
+                   "c.disclosetelephone::text, c.disclosefax::text, c.discloseemail::text, c.disclosevat::text, "
+                   "c.discloseident::text, c.disclosenotifyemail::text, COALESCE(c.warning_letter::text, '') "
+            "FROM object_registry oreg "
+            "JOIN contact c ON c.id = oreg.id "
+            "JOIN object o ON o.id = c.id" + registrar_condition,
+            params);
+    if (contacts.size() < 2)
+    {
+        return std::vector<std::set<std::string>>();
     }
+    const Database::Result addresses = _ctx.get_conn().exec_params(
+            "SELECT ca.contactid, ca.type::text, "
+                   "ca.company_name, ca.street1, ca.street2, ca.street3, ca.city, ca.stateorprovince, "
+                   "ca.postalcode, ca.country "
+            "FROM contact_address ca "
+            "JOIN object o ON o.id = ca.contactid" + registrar_condition,
+            params);
+    const AddressesOfContacts addresses_of_contacts = get_addresses_of_contacts(addresses);
 
+    const unsigned number_of_workers = std::min<std::size_t>(
+            std::max(std::thread::hardware_concurrency(), 1u),
+            (contacts.size() + 999) / 1000);
+    //fingerprints are computed in parallel by slices of contacts, every worker distributes its results
+    //into shards by fingerprint, so the same fingerprints meet in the same shard
+    std::vector<std::vector<std::vector<FingerprintOfContact>>> shards_of_worker(
+            number_of_workers,
+            std::vector<std::vector<FingerprintOfContact>>(number_of_workers));
+    run_concurrently(number_of_workers, [&](unsigned worker_idx)
+    {
+        const std::size_t begin = (contacts.size() * worker_idx) / number_of_workers;
+        const std::size_t end = (contacts.size() * (worker_idx + 1)) / number_of_workers;
+        auto& shards = shards_of_worker[worker_idx];
+        for (std::size_t contact_idx = begin; contact_idx < end; ++contact_idx)
+        {
+            FingerprintOfContact item;
+            item.fingerprint = get_contact_fingerprint(contacts[contact_idx], addresses, addresses_of_contacts);
+            item.contact_idx = contact_idx;
+            shards[item.fingerprint[0] % number_of_workers].push_back(item);
+        }
+    });
+    //every shard is grouped by its own worker
+    std::vector<std::vector<std::set<std::string>>> duplicates_of_shard(number_of_workers);
+    run_concurrently(number_of_workers, [&](unsigned shard_idx)
+    {
+        std::vector<FingerprintOfContact> shard;
+        for (const auto& shards : shards_of_worker)
+        {
+            shard.insert(shard.end(), shards[shard_idx].begin(), shards[shard_idx].end());
+        }
+        std::sort(shard.begin(), shard.end());
+        auto& duplicates = duplicates_of_shard[shard_idx];
+        for (auto group_begin = shard.begin(); group_begin != shard.end();)
+        {
+            const auto group_end = std::find_if(group_begin, shard.end(), [&](const FingerprintOfContact& item)
+            {
+                return item.fingerprint != group_begin->fingerprint;
+            });
+            if (1 < std::distance(group_begin, group_end))
+            {
+                std::set<std::string> group;
+                std::for_each(group_begin, group_end, [&](const FingerprintOfContact& item)
+                {
+                    group.insert(static_cast<std::string>(contacts[item.contact_idx][contact_handle_column]));
+                });
+                if (!have_intersection(group, exclude_contacts_))
+                {
+                    duplicates.push_back(std::move(group));
+                }
+            }
+            group_begin = group_end;
+        }
+    });
+
+    std::vector<std::set<std::string>> result;
+    for (auto& duplicates : duplicates_of_shard)
+    {
+        std::move(duplicates.begin(), duplicates.end(), std::back_inserter(result));
+    }
+    std::sort(result.begin(), result.end(), [](const std::set<std::string>& lhs, const std::set<std::string>& rhs)
+    {
+        return *lhs.begin() < *rhs.begin();
+    });
     return result;
 }
 
@@ -24,6 +24,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 
 namespace LibFred {
@@ -38,8 +39,20 @@ public:
     FindContactDuplicates& set_exclude_contacts(const std::set<std::string>& _exclude_contacts);
     FindContactDuplicates& set_specific_contact(const std::string& _dest_contact_handle);
 
+    /**
+     * Finds one group of duplicate contacts.
+     * @return handles of contacts of the group (the one with the lowest handle) or empty set if no group found
+     */
     std::set<std::string> exec(const LibFred::OperationContext& _ctx);
 
+    /**
+     * Finds all groups of duplicate contacts.
+     * Contacts are duplicate if they have the same sponsoring registrar, disclose flags and the same data
+     * (including addresses) up to letter case and superfluous whitespace.
+     * @return handles of contacts of each group, groups are ordered by their lowest handle
+     */
+    std::vector<std::set<std::string>> exec_all(const LibFred::OperationContext& _ctx);
+
 private:
     Optional<std::string> registrar_handle_;
     std::set<std::string> exclude_contacts_;
@@ -17,6 +17,7 @@
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "libfred/registrable_object/contact/get_contact_data_history.hh"
+#include "libfred/registry_metadata.hh"
 #include "libfred/registrable_object/history_interval_impl.hh"
 #include "libfred/registrable_object/exceptions_impl.hh"
 
@@ -31,12 +32,12 @@ bool does_object_exist(
         const OperationContext& ctx,
         T get_object_id_rule)
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    Database::query_param_list params(get_registry_metadata(ctx)->get_object_type_id(object_type));
     const std::string object_id_rule = get_object_id_rule(params);
     return 0 < ctx.get_conn().exec_params(
             "SELECT 0 "
             "FROM object_registry "
-            "WHERE type=get_object_type_id($1::TEXT) AND "
+            "WHERE type=$1::BIGINT AND "
                   "id=(" + object_id_rule + ")", params).size();
 }
 
@@ -89,7 +90,7 @@ ContactDataHistory get_contact_data_history(
     private:
         Database::query_param_list& params_;
     };
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    Database::query_param_list params(get_registry_metadata(ctx)->get_object_type_id(object_type));
     const std::string object_id_rule = get_object_id_rule(params);
     const auto lower_limit_rule = boost::apply_visitor(LowerLimitVisitor(params), range.lower_limit);
     const auto upper_limit_rule = boost::apply_visitor(UpperLimitVisitor(params), range.upper_limit);
@@ -99,7 +100,7 @@ ContactDataHistory get_contact_data_history(
                        "(" + lower_limit_rule + ") AS lower_limit,"
                        "(" + upper_limit_rule + ") AS upper_limit "
                 "FROM object_registry "
-                "WHERE type=get_object_type_id($1::TEXT) AND "
+                "WHERE type=$1::BIGINT AND "
                       "id=(" + object_id_rule + ")) "
             "SELECT o.uuid,h.uuid,h.valid_from,h.valid_to,h.request_id "
             "FROM o "
@@ -156,7 +157,6 @@ GetContactDataHistoryById::Result GetContactDataHistoryById::exec(
         const OperationContext& ctx,
         const HistoryInterval& range)const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
     class OperationById
     {
     public:
@@ -180,12 +180,13 @@ GetContactDataHistoryByHandle::Result GetContactDataHistoryByHandle::exec(
         const OperationContext& ctx,
         const HistoryInterval& range)const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    const auto object_type_id = get_registry_metadata(ctx)->get_object_type_id(object_type);
     class OperationByHandle
     {
     public:
-        explicit OperationByHandle(const std::string& handle)
-            : handle_(handle) { }
+        OperationByHandle(const std::string& handle, unsigned long long object_type_id)
+            : handle_(handle),
+              object_type_id_(object_type_id) { }
         std::string operator()(Database::query_param_list& params)const
         {
             static const std::string sql_handle_case_normalize_function =
@@ -194,13 +195,14 @@ GetContactDataHistoryByHandle::Result GetContactDataHistoryByHandle::exec(
             return "SELECT id "
                    "FROM object_registry "
                    "WHERE name=" + sql_handle_case_normalize_function + "($" + params.add(handle_) + "::TEXT) AND "
-                         "type=get_object_type_id($" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT) AND "
+                         "type=$" + params.add(object_type_id_) + "::BIGINT AND "
                          "erdate IS NULL";
         }
     private:
         const std::string handle_;
+        const unsigned long long object_type_id_;
     };
-    return get_contact_data_history(ctx, range, OperationByHandle(handle_));
+    return get_contact_data_history(ctx, range, OperationByHandle(handle_, object_type_id));
 }
 
 GetContactDataHistoryByUuid::GetContactDataHistoryByUuid(const ContactUuid& contact_uuid)
@@ -211,24 +213,26 @@ GetContactDataHistoryByUuid::Result GetContactDataHistoryByUuid::exec(
         const OperationContext& ctx,
         const HistoryInterval& range)const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    const auto object_type_id = get_registry_metadata(ctx)->get_object_type_id(object_type);
     class OperationByUuid
     {
     public:
-        explicit OperationByUuid(const ContactUuid& uuid)
-            : uuid_(uuid) { }
+        OperationByUuid(const ContactUuid& uuid, unsigned long long object_type_id)
+            : uuid_(uuid),
+              object_type_id_(object_type_id) { }
         std::string operator()(Database::query_param_list& params)const
         {
-            const auto object_type_param_text = "$" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT";
+            const auto object_type_param_text = "$" + params.add(object_type_id_) + "::BIGINT";
             return "SELECT id "
                    "FROM object_registry "
                    "WHERE uuid=$" + params.add(uuid_) + "::UUID AND "
-                         "type=get_object_type_id(" + object_type_param_text + ")";
+                         "type=" + object_type_param_text;
         }
     private:
         const ContactUuid uuid_;
+        const unsigned long long object_type_id_;
     };
-    return get_contact_data_history(ctx, range, OperationByUuid(uuid_));
+    return get_contact_data_history(ctx, range, OperationByUuid(uuid_, object_type_id));
 }
 
 }//namespace LibFred::RegistrableObject::Contact
@@ -29,6 +29,7 @@
 #include "libfred/object/generate_authinfo_password.hh"
 #include "libfred/object/object_states_info.hh"
 #include "libfred/object_state/create_object_state_request_id.hh"
+#include "libfred/object_state/get_object_states_of_many.hh"
 #include "libfred/object_state/lock_object_state_request_lock.hh"
 #include "libfred/poll/create_update_object_poll_message.hh"
 #include "libfred/poll/create_poll_message.hh"
@@ -40,6 +41,8 @@
 
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace LibFred {
 
@@ -57,6 +60,22 @@ bool is_attached_to_identity(
             "LIMIT 1", Database::query_param_list{contact_id}).size();
 }
 
+//locks states of objects and gets them by two queries instead of two queries per object
+std::unordered_map<unsigned long long, ObjectStatesInfo> lock_and_get_object_states(
+        const OperationContext& ctx,
+        const Database::Result& objects,
+        Database::Result::size_type object_id_column)
+{
+    std::vector<unsigned long long> object_ids;
+    object_ids.reserve(objects.size());
+    for (Database::Result::size_type idx = 0; idx < objects.size(); ++idx)
+    {
+        object_ids.push_back(static_cast<unsigned long long>(objects[idx][object_id_column]));
+    }
+    LockObjectStateRequestLocks(object_ids).exec(ctx);
+    return GetObjectStatesOfMany(std::move(object_ids)).exec(ctx);
+}
+
 }//namespace LibFred::{anonymous}
 
 MergeContact::MergeContact(
@@ -199,6 +218,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
                 (dry_run ? "" : " FOR UPDATE OF oreg"),
                         // clang-format on
                 Database::query_param_list(src_contact_handle_));
+        const auto objects_states = lock_and_get_object_states(ctx, result, 2);
 
         for (Database::Result::size_type idx = 0; idx < result.size(); ++idx)
         {
@@ -209,8 +229,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
             tmp.set_registrant = dst_contact_handle_;
 
             //check if object blocked
-            LockObjectStateRequestLock(tmp.domain_id).exec(ctx);
-            const ObjectStatesInfo domain_states(GetObjectStates(tmp.domain_id).exec(ctx));
+            const ObjectStatesInfo& domain_states = objects_states.at(tmp.domain_id);
             if (domain_states.presents(Object_State::server_blocked) ||
                 domain_states.presents(Object_State::server_update_prohibited))
             {
@@ -251,6 +270,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
                 (dry_run ? "" : " FOR UPDATE OF oreg"),
                         // clang-format on
                 Database::query_param_list(src_contact_handle_));
+        const auto objects_states = lock_and_get_object_states(ctx, result, 2);
 
         for (Database::Result::size_type idx = 0; idx < result.size(); ++idx)
         {
@@ -262,8 +282,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
             tmp.add_admin_contact = dst_contact_handle_;
 
             //check if object blocked
-            LockObjectStateRequestLock(tmp.domain_id).exec(ctx);
-            const ObjectStatesInfo domain_states(GetObjectStates(tmp.domain_id).exec(ctx));
+            const ObjectStatesInfo& domain_states = objects_states.at(tmp.domain_id);
             if (domain_states.presents(Object_State::server_blocked) ||
                 domain_states.presents(Object_State::server_update_prohibited))
             {
@@ -327,6 +346,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
                 (dry_run ? "" : " FOR UPDATE OF oreg"),
                         // clang-format on
                 Database::query_param_list(src_contact_handle_));
+        const auto objects_states = lock_and_get_object_states(ctx, result, 2);
 
         for (Database::Result::size_type idx = 0; idx < result.size(); ++idx)
         {
@@ -338,8 +358,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
             tmp.add_tech_contact = dst_contact_handle_;
 
             //check if object blocked
-            LockObjectStateRequestLock(tmp.nsset_id).exec(ctx);
-            const ObjectStatesInfo nsset_states(GetObjectStates(tmp.nsset_id).exec(ctx));
+            const ObjectStatesInfo& nsset_states = objects_states.at(tmp.nsset_id);
             if (nsset_states.presents(Object_State::server_update_prohibited))
             {
                 BOOST_THROW_EXCEPTION(MergeContact::Exception().set_object_blocked(tmp.handle));
@@ -403,6 +422,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
                 (dry_run ? "" : " FOR UPDATE OF oreg"),
                         // clang-format off
                 Database::query_param_list(src_contact_handle_));
+        const auto objects_states = lock_and_get_object_states(ctx, result, 2);
 
         for (Database::Result::size_type idx = 0; idx < result.size(); ++idx)
         {
@@ -414,8 +434,7 @@ MergeContactOutput MergeContact::merge_contact_impl(const OperationContext& ctx,
             tmp.add_tech_contact = dst_contact_handle_;
 
             //check if object blocked
-            LockObjectStateRequestLock(tmp.keyset_id).exec(ctx);
-            const ObjectStatesInfo keyset_states(GetObjectStates(tmp.keyset_id).exec(ctx));
+            const ObjectStatesInfo& keyset_states = objects_states.at(tmp.keyset_id);
             if (keyset_states.presents(Object_State::server_update_prohibited))
             {
                 BOOST_THROW_EXCEPTION(MergeContact::Exception().set_object_blocked(tmp.handle));
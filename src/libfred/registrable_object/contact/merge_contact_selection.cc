@@ -25,13 +25,19 @@
 #include "libfred/object/object_state.hh"
 #include "libfred/opcontext.hh"
 #include "libfred/db_settings.hh"
+#include "libfred/registry_metadata.hh"
 
+#include "util/db/param_query_composition.hh"
 #include "util/util.hh"
 
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/optional.hpp>
 #include <boost/regex.hpp>
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -41,6 +47,258 @@
 
 namespace LibFred {
 
+namespace {
+
+//all metrics used by contact selection filters
+struct ContactCandidate
+{
+    std::string handle;
+    bool exists;/**< contact of given handle exists, other metrics are valid only if it exists */
+    std::string name;
+    bool identified;
+    bool conditionally_identified;
+    bool identity_attached;
+    unsigned long long number_of_domains;/**< number of domains the contact is registrant or admin of */
+    unsigned long long number_of_objects;/**< number_of_domains plus number of nssets and keysets the contact is tech of */
+    boost::optional<unsigned long long> update_rank;/**< the lower the more recently updated, none if never updated */
+    unsigned long long creation_rank;/**< the lower the more recently created, unique */
+    bool not_regcznic;
+};
+
+using Candidates = std::vector<const ContactCandidate*>;
+
+unsigned long long get_object_state_id(const std::shared_ptr<const RegistryMetadata>& metadata, Object_State::Enum state)
+{
+    const auto* const object_state = metadata->find_object_state(Conversion::Enums::to_db_handle(state));
+    if (object_state == nullptr)
+    {
+        BOOST_THROW_EXCEPTION(InternalError("failed to get object state"));
+    }
+    return object_state->id;
+}
+
+//one set-based query computes metrics of all candidates, the result is in order of given handles
+std::vector<ContactCandidate> get_contact_candidates(
+        const OperationContext& ctx,
+        const std::vector<std::string>& contact_handles)
+{
+    const auto metadata = get_registry_metadata(ctx);
+    const Database::Result dbres = ctx.get_conn().exec_params(Database::ParamQuery(
+            "WITH candidates AS ("
+                "SELECT h.idx, h.handle, oreg.id, oreg.name, oreg.crdate, o.update, o.clid "
+                "FROM UNNEST(").param_text_array(contact_handles)(") WITH ORDINALITY AS h(handle, idx) "
+                "JOIN object_registry oreg ON oreg.name = UPPER(h.handle) AND oreg.erdate IS NULL "
+                "JOIN contact c ON c.id = oreg.id "
+                "JOIN object o ON o.id = oreg.id) "
+            "SELECT ca.idx, "
+                   "ca.name, "
+                   "ca.name = ca.handle AND "
+                       "EXISTS(SELECT FROM object_state os "
+                              "WHERE os.object_id = ca.id AND "
+                                    "os.state_id = ").param_bigint(get_object_state_id(metadata, Object_State::identified_contact))(" AND "
+                                    "os.valid_to IS NULL), "
+                   "ca.name = ca.handle AND "
+                       "EXISTS(SELECT FROM object_state os "
+                              "WHERE os.object_id = ca.id AND "
+                                    "os.state_id = ").param_bigint(get_object_state_id(metadata, Object_State::conditionally_identified_contact))(" AND "
+                                    "os.valid_to IS NULL), "
+                   "(SELECT COUNT(*) FROM contact_identity ci WHERE ci.contact_id = ca.id AND ci.valid_to IS NULL) = 1, "
+                   "COALESCE(dr.count, 0) + COALESCE(da.count, 0), "
+                   "COALESCE(dr.count, 0) + COALESCE(da.count, 0) + COALESCE(nt.count, 0) + COALESCE(kt.count, 0), "
+                   "ca.update IS NOT NULL, "
+                   "DENSE_RANK() OVER (ORDER BY ca.update DESC NULLS LAST), "
+                   "DENSE_RANK() OVER (ORDER BY ca.crdate DESC, ca.id DESC), "
+                   "r.handle != 'REG-CZNIC' "
+            "FROM candidates ca "
+            "JOIN registrar r ON r.id = ca.clid "
+            "LEFT JOIN (SELECT d.registrant AS contact_id, COUNT(*) AS count "
+                       "FROM domain d "
+                       "WHERE d.registrant IN (SELECT id FROM candidates) "
+                       "GROUP BY 1) dr ON dr.contact_id = ca.id "
+            "LEFT JOIN (SELECT dcm.contactid AS contact_id, COUNT(*) AS count "
+                       "FROM domain_contact_map dcm "
+                       "WHERE dcm.role = 1 AND dcm.contactid IN (SELECT id FROM candidates) "
+                       "GROUP BY 1) da ON da.contact_id = ca.id "
+            "LEFT JOIN (SELECT ncm.contactid AS contact_id, COUNT(*) AS count "
+                       "FROM nsset_contact_map ncm "
+                       "WHERE ncm.contactid IN (SELECT id FROM candidates) "
+                       "GROUP BY 1) nt ON nt.contact_id = ca.id "
+            "LEFT JOIN (SELECT kcm.contactid AS contact_id, COUNT(*) AS count "
+                       "FROM keyset_contact_map kcm "
+                       "WHERE kcm.contactid IN (SELECT id FROM candidates) "
+                       "GROUP BY 1) kt ON kt.contact_id = ca.id"));
+    std::vector<ContactCandidate> candidates(contact_handles.size());
+    for (std::size_t idx = 0; idx < contact_handles.size(); ++idx)
+    {
+        candidates[idx].handle = contact_handles[idx];
+        candidates[idx].exists = false;
+    }
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        auto& candidate = candidates.at(static_cast<std::size_t>(dbres[idx][0]) - 1);
+        candidate.exists = true;
+        candidate.name = static_cast<std::string>(dbres[idx][1]);
+        candidate.identified = static_cast<bool>(dbres[idx][2]);
+        candidate.conditionally_identified = static_cast<bool>(dbres[idx][3]);
+        candidate.identity_attached = static_cast<bool>(dbres[idx][4]);
+        candidate.number_of_domains = static_cast<unsigned long long>(dbres[idx][5]);
+        candidate.number_of_objects = static_cast<unsigned long long>(dbres[idx][6]);
+        if (static_cast<bool>(dbres[idx][7]))
+        {
+            candidate.update_rank = static_cast<unsigned long long>(dbres[idx][8]);
+        }
+        candidate.creation_rank = static_cast<unsigned long long>(dbres[idx][9]);
+        candidate.not_regcznic = static_cast<bool>(dbres[idx][10]);
+    }
+    return candidates;
+}
+
+Candidates get_all(const std::vector<ContactCandidate>& candidates)
+{
+    Candidates result;
+    result.reserve(candidates.size());
+    std::for_each(candidates.begin(), candidates.end(), [&](auto&& candidate) { result.push_back(&candidate); });
+    return result;
+}
+
+struct ContactSelector
+{
+    std::function<Candidates(const Candidates&)> select;
+    bool returns_registry_name;/**< selected contacts are presented by handle from registry instead of given handle */
+};
+
+template <typename P>
+Candidates select_if(const Candidates& candidates, P predicate)
+{
+    Candidates result;
+    std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(result), predicate);
+    return result;
+}
+
+//selects existing candidates with the best key, candidates keep their order
+template <typename K, typename C>
+Candidates select_best(const Candidates& candidates, K key, C is_better)
+{
+    Candidates result;
+    for (const auto* const candidate : candidates)
+    {
+        if (!candidate->exists)
+        {
+            continue;
+        }
+        if (!result.empty() && is_better(key(*candidate), key(*result.front())))
+        {
+            result.clear();
+        }
+        if (result.empty() || !is_better(key(*result.front()), key(*candidate)))
+        {
+            result.push_back(candidate);
+        }
+    }
+    return result;
+}
+
+const std::map<std::string, ContactSelector>& get_contact_selectors()
+{
+    static const std::map<std::string, ContactSelector> selectors = {
+        { MCS_FILTER_IDENTIFIED_CONTACT,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_if(candidates, [](auto&& candidate) { return candidate->exists && candidate->identified; });
+                },
+                false } },
+        { MCS_FILTER_IDENTITY_ATTACHED,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_if(candidates, [](auto&& candidate) { return candidate->exists && candidate->identity_attached; });
+                },
+                false } },
+        { MCS_FILTER_CONDITIONALLY_IDENTIFIED_CONTACT,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_if(candidates, [](auto&& candidate) { return candidate->exists && candidate->conditionally_identified; });
+                },
+                false } },
+        { MCS_FILTER_HANDLE_MOJEID_SYNTAX,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    static const boost::regex mojeid_handle_syntax("^[a-z0-9](-?[a-z0-9])*$");
+                    return select_if(candidates, [](auto&& candidate)
+                    {
+                        return boost::regex_match(boost::to_lower_copy(candidate->handle), mojeid_handle_syntax) &&
+                               (candidate->handle.length() <= 30);
+                    });
+                },
+                false } },
+        { MCS_FILTER_MAX_DOMAINS_BOUND,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_best(
+                            candidates,
+                            [](const ContactCandidate& candidate) { return candidate.number_of_domains; },
+                            std::greater<unsigned long long>());
+                },
+                true } },
+        { MCS_FILTER_MAX_OBJECTS_BOUND,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_best(
+                            candidates,
+                            [](const ContactCandidate& candidate) { return candidate.number_of_objects; },
+                            std::greater<unsigned long long>());
+                },
+                true } },
+        { MCS_FILTER_RECENTLY_UPDATED,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_best(
+                            select_if(candidates, [](auto&& candidate) { return candidate->update_rank != boost::none; }),
+                            [](const ContactCandidate& candidate) { return *candidate.update_rank; },
+                            std::less<unsigned long long>());
+                },
+                true } },
+        { MCS_FILTER_NOT_REGCZNIC,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    return select_if(candidates, [](auto&& candidate) { return candidate->exists && candidate->not_regcznic; });
+                },
+                true } },
+        { MCS_FILTER_RECENTLY_CREATED,
+          ContactSelector{
+                [](const Candidates& candidates)
+                {
+                    //creation rank is unique, at most one contact is selected
+                    return select_best(
+                            candidates,
+                            [](const ContactCandidate& candidate) { return candidate.creation_rank; },
+                            std::less<unsigned long long>());
+                },
+                true } }
+    };
+    return selectors;
+}
+
+std::vector<std::string> get_handles(const ContactSelector& selector, const Candidates& candidates)
+{
+    std::vector<std::string> handles;
+    handles.reserve(candidates.size());
+    std::for_each(candidates.begin(), candidates.end(), [&](auto&& candidate)
+    {
+        handles.push_back(selector.returns_registry_name ? candidate->name : candidate->handle);
+    });
+    return handles;
+}
+
+}//namespace LibFred::{anonymous}
+
 MergeContactSelectionOutput::MergeContactSelectionOutput(std::string _handle, std::string _filter)
     : handle{std::move(_handle)},
       filter{std::move(_filter)}
@@ -69,19 +327,26 @@ MergeContactSelectionOutput MergeContactSelection::exec(const OperationContext&
         {
             BOOST_THROW_EXCEPTION(NoContactHandles());
         }
-        const auto& filter = get_default_contact_selection_filter_factory();
+        //all metrics of all candidates are obtained at once, the chain of filters is evaluated in memory
+        const auto candidates = get_contact_candidates(ctx, contact_handles_);
+        auto remaining_candidates = get_all(candidates);
+        const auto& selectors = get_contact_selectors();
         for (auto&& filter_name : filters_)
         {
-            if (filter.has_key(filter_name))
+            const auto selector_itr = selectors.find(filter_name);
+            if (selector_itr != selectors.end())
             {
-                auto current_filter_result = filter[filter_name](ctx, contact_handles_);
+                auto current_filter_result = selector_itr->second.select(remaining_candidates);
                 if (current_filter_result.size() == 1)
                 {
-                    return MergeContactSelectionOutput{current_filter_result[0], filter_name};
+                    return MergeContactSelectionOutput{
+                            get_handles(selector_itr->second, current_filter_result)[0],
+                            filter_name};
                 }
                 if (1 < current_filter_result.size())
                 {
-                    contact_handles_ = std::move(current_filter_result);
+                    contact_handles_ = get_handles(selector_itr->second, current_filter_result);
+                    remaining_candidates = std::move(current_filter_result);
                 }
             }
         }
@@ -115,339 +380,26 @@ const char* MergeContactSelection::TooManyContactHandlesLeft::what() const noexc
 
 namespace {
 
-class FilterIdentifiedContact : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(const OperationContext& ctx, const std::vector<std::string>& contact_handle) override
-    {
-        std::vector<std::string> filtered;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            const Database::Result contact_check = ctx.get_conn().exec_params(
-                "SELECT oreg.name FROM contact c JOIN object_registry oreg ON c.id = oreg.id AND oreg.erdate IS NULL "
-                "JOIN object_state os ON os.object_id = oreg.id AND os.valid_to IS NULL "
-                "JOIN enum_object_states eos ON eos.id = os.state_id "
-                "WHERE eos.name = $1::text AND oreg.name = $2::text",
-                Database::query_param_list
-                    (Conversion::Enums::to_db_handle(Object_State::identified_contact))
-                    (*i));
-
-            if (contact_check.size() == 1) filtered.push_back(*i);
-        }
-        return filtered;
-    }
-};
-
-class FilterIdentityAttached : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext& ctx,
-            const std::vector<std::string>& contacts) override
-    {
-        std::vector<std::string> filtered;
-        std::for_each(contacts.begin(), contacts.end(), [&](auto&& contact_handle)
-                {
-                    const auto db_res = ctx.get_conn().exec_params(
-                            "SELECT 0 "
-                            "FROM object_registry obr "
-                            "JOIN contact_identity ci ON ci.contact_id = obr.id "
-                            "WHERE obr.erdate IS NULL AND "
-                                  "obr.name = UPPER($1::TEXT) AND "
-                                  "obr.type = get_object_type_id('contact') AND "
-                                  "ci.valid_to IS NULL",
-                            Database::query_param_list(contact_handle));
-                    if (db_res.size() == 1)
-                    {
-                        filtered.push_back(contact_handle);
-                    }
-                });
-        return filtered;
-    }
-};
-
-class FilterConditionallyIdentifiedContact : public ContactSelectionFilter
+//filter using metrics of contacts obtained by one query
+class MetricsFilter : public ContactSelectionFilter
 {
+public:
+    explicit MetricsFilter(const ContactSelector& selector)
+        : selector_(selector)
+    { }
 private:
     std::vector<std::string> operator()(
             const OperationContext& ctx,
             const std::vector<std::string>& contact_handle) override
     {
-        std::vector<std::string> filtered;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
+        if (contact_handle.empty())
         {
-            const Database::Result contact_check = ctx.get_conn().exec_params(
-                "SELECT oreg.name FROM contact c JOIN object_registry oreg ON c.id = oreg.id AND oreg.erdate IS NULL "
-                "JOIN object_state os ON os.object_id = oreg.id AND os.valid_to IS NULL "
-                "JOIN enum_object_states eos ON eos.id = os.state_id "
-                "WHERE eos.name = $1::text AND oreg.name = $2::text",
-                Database::query_param_list
-                    (Conversion::Enums::to_db_handle(Object_State::conditionally_identified_contact))
-                    (*i));
-
-            if (contact_check.size() == 1)
-            {
-                filtered.push_back(*i);
-            }
-        }
-        return filtered;
-    }
-};
-
-class FilterHandleMojeIDSyntax : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext&,
-            const std::vector<std::string>& contact_handle) override
-    {
-        boost::regex mojeid_handle_syntax("^[a-z0-9](-?[a-z0-9])*$");
-        std::vector<std::string> filtered;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            if (boost::regex_match(boost::to_lower_copy(*i), mojeid_handle_syntax)
-                    && (*i).length() <= 30)
-            {
-                filtered.push_back(*i);
-            }
+            return std::vector<std::string>();
         }
-        return filtered;
-    }
-};
-
-class FilterMaxDomainsBound : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext& ctx,
-            const std::vector<std::string>& contact_handle) override
-    {
-        std::vector<std::string> filtered;
-
-        if (contact_handle.empty()) return filtered;
-
-        std::string query_begin("SELECT cc.handle, (cc.domain_registrant_count + cc.domain_admin_count) AS all_domains_count FROM ( "
-        " SELECT current_contact.handle "
-        " , (SELECT count(*) FROM object_registry oreg JOIN domain d ON oreg.id = d.id WHERE d.registrant = current_contact.id) AS domain_registrant_count "
-        " , (SELECT count(*) FROM object_registry oreg JOIN domain d ON oreg.id = d.id JOIN domain_contact_map dcm ON dcm.domainid = d.id and dcm.role = 1 "
-        "    WHERE dcm.contactid  = current_contact.id) AS domain_admin_count "
-        " FROM (SELECT oreg.name AS handle, c.id AS id FROM contact c JOIN object_registry oreg ON c.id = oreg.id AND oreg.erdate IS NULL");
-
-        Util::HeadSeparator where_or(" WHERE ", " OR ");
-
-        std::string query_end(") AS current_contact"
-        " ) cc "
-        " ORDER BY all_domains_count DESC ");
-
-        Database::QueryParams params;//query params
-        std::ostringstream sql;
-        sql << query_begin;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            params.push_back(*i);
-            sql << where_or.get() << "oreg.name = UPPER($" << params.size() << "::text) ";
-        }
-        sql << query_end;
-
-        const Database::Result contact_domains = ctx.get_conn().exec_params(sql.str(), params);
-
-        for (Database::Result::size_type i = 0 ; i < contact_domains.size(); ++i)
-        {
-            //if it is first contact with maximum of domains bound or another contact with the same maximum number of domains bound
-            if ((i == 0) || (std::string(contact_domains[0][1]).compare(std::string(contact_domains[i][1])) == 0 ))
-            {
-                filtered.push_back(std::string(contact_domains[i][0]));
-            }
-            else
-            {//ignore others
-                break;
-            }
-        }
-        return filtered;
-    }
-};
-
-class FilterMaxObjectsBound : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext& ctx,
-            const std::vector<std::string>& contact_handle) override
-    {
-        std::vector<std::string> filtered;
-
-        if (contact_handle.empty()) return filtered;
-
-
-        std::string query_begin("SELECT cc.handle, (cc.domain_registrant_count + cc.domain_admin_count + cc.nsset_tech_count + cc.keyset_tech_count) AS all_domains_count FROM ( "
-        " SELECT current_contact.handle "
-        " , (SELECT count(*) FROM object_registry oreg JOIN domain d ON oreg.id = d.id WHERE d.registrant = current_contact.id) AS domain_registrant_count "
-        " , (SELECT count(*) FROM object_registry oreg JOIN domain d ON oreg.id = d.id JOIN domain_contact_map dcm ON dcm.domainid = d.id and dcm.role = 1 "
-        "    WHERE dcm.contactid  = current_contact.id) AS domain_admin_count "
-        " , (SELECT count(*) FROM object_registry oreg JOIN nsset n ON oreg.id = n.id JOIN nsset_contact_map ncm ON ncm.nssetid = n.id "
-        "    WHERE ncm.contactid  = current_contact.id) AS nsset_tech_count "
-        " , (SELECT count(*) FROM object_registry oreg JOIN keyset k ON oreg.id = k.id JOIN keyset_contact_map kcm ON kcm.keysetid = k.id "
-        "    WHERE kcm.contactid  = current_contact.id) AS keyset_tech_count "
-        " FROM (SELECT oreg.name AS handle, c.id AS id FROM contact c JOIN object_registry oreg ON c.id = oreg.id AND oreg.erdate IS NULL");
-
-        Util::HeadSeparator where_or(" WHERE ", " OR ");
-
-        std::string query_end(") AS current_contact"
-        " ) cc "
-        " ORDER BY all_domains_count DESC ");
-
-        Database::QueryParams params;//query params
-        std::ostringstream sql;
-        sql << query_begin;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            params.push_back(*i);
-            sql << where_or.get() << "oreg.name = UPPER($" << params.size() << "::text) ";
-        }
-        sql << query_end;
-
-        const Database::Result contact_objects = ctx.get_conn().exec_params(sql.str(), params);
-
-        for (Database::Result::size_type i = 0 ; i < contact_objects.size(); ++i)
-        {
-            //if it is first contact with maximum of objects bound or another contact with the same maximum number of objects bound
-            if ((i == 0) || (std::string(contact_objects[0][1]).compare(std::string(contact_objects[i][1])) == 0 ))
-            {
-                filtered.push_back(std::string(contact_objects[i][0]));
-            }
-            else
-            {//ignore others
-                break;
-            }
-        }
-
-        return filtered;
-    }
-};
-
-class FilterRecentlyUpdated : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext& ctx,
-            const std::vector<std::string>& contact_handle) override
-    {
-        std::vector<std::string> filtered;
-
-        if (contact_handle.empty()) return filtered;
-
-        std::string query_begin("SELECT oreg.name, o.update FROM object o "
-                " JOIN object_registry oreg ON o.id = oreg.id AND o.update IS NOT NULL AND oreg.erdate IS NULL"
-                " JOIN contact c ON c.id = oreg.id ");
-
-        Util::HeadSeparator where_or(" WHERE ", " OR ");
-
-        std::string query_end(" ORDER BY o.update DESC ");
-
-        Database::QueryParams params;//query params
-        std::ostringstream sql;
-        sql << query_begin;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            params.push_back(*i);
-            sql << where_or.get() << "oreg.name = UPPER($" << params.size() << "::text) ";
-        }
-        sql << query_end;
-
-        const Database::Result contact_updated = ctx.get_conn().exec_params(sql.str(), params);
-
-        for (Database::Result::size_type i = 0 ; i < contact_updated.size(); ++i)
-        {
-            //if it is first contact with most recent update timestamp or another contact with the same update timestamp
-            if ((i == 0) || (std::string(contact_updated[0][1]).compare(std::string(contact_updated[i][1])) == 0 ))
-            {
-                filtered.push_back(std::string(contact_updated[i][0]));
-            }
-            else
-            {//ignore others
-                break;
-            }
-        }
-
-        return filtered;
-    }
-};
-
-class FilterNotRegCzNic : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext& ctx,
-            const std::vector<std::string>& contact_handle) override
-    {
-        std::vector<std::string> filtered;
-
-        std::string query(
-            "SELECT oreg.name FROM object_registry oreg "
-            " JOIN object o ON oreg.id = o.id AND oreg.erdate IS NULL"
-            " JOIN registrar r ON r.id = o.clid AND r.handle != 'REG-CZNIC' "
-            " JOIN contact c ON c.id = oreg.id ");
-
-        Util::HeadSeparator where_or(" WHERE ", " OR ");
-
-        Database::QueryParams params;//query params
-        std::ostringstream sql;
-        sql << query;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            params.push_back(*i);
-            sql << where_or.get() << "oreg.name = UPPER($" << params.size() << "::text) ";
-        }
-
-        const Database::Result contact_not_regcznic = ctx.get_conn().exec_params(sql.str(), params);
-
-        for (Database::Result::size_type i = 0 ; i < contact_not_regcznic.size(); ++i)
-        {
-                filtered.push_back(std::string(contact_not_regcznic[i][0]));
-        }
-
-        return filtered;
-    }
-};
-
-class FilterRecentlyCreated : public ContactSelectionFilter
-{
-private:
-    std::vector<std::string> operator()(
-            const OperationContext& ctx,
-            const std::vector<std::string>& contact_handle) override
-    {
-        std::vector<std::string> filtered;
-
-        if (contact_handle.empty()) return filtered;
-
-        std::string query_begin("SELECT oreg.name "
-                " FROM object_registry oreg "
-                " JOIN contact c ON c.id = oreg.id AND oreg.erdate IS NULL");
-
-        Util::HeadSeparator where_or(" WHERE ", " OR ");
-
-        std::string query_end(" ORDER BY oreg.crdate DESC, oreg.id DESC LIMIT 1 ");
-
-        Database::QueryParams params;//query params
-        std::ostringstream sql;
-        sql << query_begin;
-        for (std::vector<std::string>::const_iterator i = contact_handle.begin(); i != contact_handle.end() ; ++i)
-        {
-            params.push_back(*i);
-            sql << where_or.get() << "oreg.name = UPPER($" << params.size() << "::text) ";
-        }
-        sql << query_end;
-
-        const Database::Result contact_created = ctx.get_conn().exec_params(sql.str(), params);
-
-        if (contact_created.size() == 1)
-        {
-            filtered.push_back(std::string(contact_created[0][0]));
-        }
-
-        return filtered;
+        const auto candidates = get_contact_candidates(ctx, contact_handle);
+        return get_handles(selector_, selector_.select(get_all(candidates)));
     }
+    const ContactSelector& selector_;
 };
 
 }//namespace LibFred::{anonymous}
@@ -459,15 +411,10 @@ const LibFred::ContactSelectionFilterFactory& LibFred::get_default_contact_selec
     static thread_local const auto factory = []()
     {
         ContactSelectionFilterFactory factory{};
-        factory.add_producer({MCS_FILTER_IDENTIFIED_CONTACT, std::make_unique<FilterIdentifiedContact>()})
-               .add_producer({MCS_FILTER_IDENTITY_ATTACHED, std::make_unique<FilterIdentityAttached>()})
-               .add_producer({MCS_FILTER_CONDITIONALLY_IDENTIFIED_CONTACT, std::make_unique<FilterConditionallyIdentifiedContact>()})
-               .add_producer({MCS_FILTER_HANDLE_MOJEID_SYNTAX, std::make_unique<FilterHandleMojeIDSyntax>()})
-               .add_producer({MCS_FILTER_MAX_DOMAINS_BOUND, std::make_unique<FilterMaxDomainsBound>()})
-               .add_producer({MCS_FILTER_MAX_OBJECTS_BOUND, std::make_unique<FilterMaxObjectsBound>()})
-               .add_producer({MCS_FILTER_RECENTLY_UPDATED, std::make_unique<FilterRecentlyUpdated>()})
-               .add_producer({MCS_FILTER_NOT_REGCZNIC, std::make_unique<FilterNotRegCzNic>()})
-               .add_producer({MCS_FILTER_RECENTLY_CREATED, std::make_unique<FilterRecentlyCreated>()});
+        for (const auto& selector : get_contact_selectors())
+        {
+            factory.add_producer({selector.first, std::make_unique<MetricsFilter>(selector.second)});
+        }
         return factory;
     }();
     return factory;
@@ -52,7 +52,7 @@ namespace LibFred
             Zone::Data zone;
             try
             {
-                zone = Zone::find_zone_in_fqdn(ctx, no_root_dot_fqdn);
+                zone = Zone::find_zone_in_fqdn_cached(ctx, no_root_dot_fqdn);
             }
             catch (const Zone::Exception& ex)
             {
@@ -68,7 +68,7 @@ namespace LibFred
 
             //domain_name_validation
             if (!LibFred::Domain::DomainNameValidator(is_system_registrar_)
-                .set_checker_names(LibFred::Domain::get_domain_name_validation_config_for_zone(ctx, zone.name))
+                .set_checker_names(LibFred::Domain::get_cached_domain_name_validation_config_for_zone(ctx, zone.name))
                 .set_zone_name(LibFred::Domain::DomainName(zone.name))
                 .set_ctx(ctx)
                 .exec(LibFred::Domain::DomainName(fqdn_), std::count(zone.name.begin(), zone.name.end(), '.') + 1) // skip zone labels
@@ -96,7 +96,7 @@ namespace LibFred
             Zone::Data zone;
             try
             {
-                zone = Zone::find_zone_in_fqdn(ctx, no_root_dot_fqdn);
+                zone = Zone::find_zone_in_fqdn_cached(ctx, no_root_dot_fqdn);
             }
             catch (const Zone::Exception& ex)
             {
@@ -130,7 +130,7 @@ namespace LibFred
             Zone::Data zone;
             try
             {
-                zone = Zone::find_zone_in_fqdn(ctx, no_root_dot_fqdn);
+                zone = Zone::find_zone_in_fqdn_cached(ctx, no_root_dot_fqdn);
             }
             catch (const Zone::Exception& ex)
             {
@@ -196,7 +196,7 @@ namespace LibFred
             Zone::Data zone;
             try
             {
-                zone = Zone::find_zone_in_fqdn(ctx, no_root_dot_fqdn);
+                zone = Zone::find_zone_in_fqdn_cached(ctx, no_root_dot_fqdn);
             }
             catch (const Zone::Exception& ex)
             {
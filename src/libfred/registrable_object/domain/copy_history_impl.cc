@@ -18,6 +18,9 @@
  */
 #include "libfred/registrable_object/domain/copy_history_impl.hh"
 
+#include <stdexcept>
+#include <vector>
+
 namespace LibFred
 {
     void copy_domain_data_to_domain_history_impl(
@@ -25,7 +28,18 @@ namespace LibFred
         const unsigned long long _domain_id,
         const unsigned long long _historyid
     ) {
-        const Database::Result res = _ctx.get_conn().exec_params(
+        auto pipeline = _ctx.get_conn().pipeline();
+        const std::size_t domain_history_idx = copy_domain_data_to_domain_history_impl(pipeline, _domain_id, _historyid);
+        const std::vector<Database::Result> results = pipeline.exec();
+        check_copy_domain_data_to_domain_history_result(results[domain_history_idx]);
+    }
+
+    std::size_t copy_domain_data_to_domain_history_impl(
+        Database::StandaloneConnection::Pipeline& _pipeline,
+        const unsigned long long _domain_id,
+        const unsigned long long _historyid
+    ) {
+        const std::size_t domain_history_idx = _pipeline.add(
             "INSERT INTO domain_history( "
                 "historyid,  id, zone, registrant, nsset, exdate, keyset "
             ") "
@@ -36,11 +50,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_domain_id)
         );
 
-        if (res.rows_affected() != 1) {
-            throw std::runtime_error("INSERT INTO domain_history failed");
-        }
-
-        _ctx.get_conn().exec_params(
+        _pipeline.add(
             "INSERT INTO domain_contact_map_history( "
                 "historyid,  domainid, contactid, role "
             ") "
@@ -51,7 +61,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_domain_id)
         );
 
-        _ctx.get_conn().exec_params(
+        _pipeline.add(
             "INSERT INTO enumval_history( "
                 "historyid,  domainid, exdate, publish "
             ") "
@@ -61,5 +71,13 @@ namespace LibFred
             "WHERE domainid = $2::integer ",
             Database::query_param_list(_historyid)(_domain_id)
         );
+        return domain_history_idx;
+    }
+
+    void check_copy_domain_data_to_domain_history_result(const Database::Result& _domain_history_result)
+    {
+        if (_domain_history_result.rows_affected() != 1) {
+            throw std::runtime_error("INSERT INTO domain_history failed");
+        }
     }
 }
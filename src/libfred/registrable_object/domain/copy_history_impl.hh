@@ -25,6 +25,7 @@
 
 #include "libfred/opcontext.hh"
 
+#include <cstddef>
 
 namespace LibFred
 {
@@ -39,6 +40,21 @@ namespace LibFred
         unsigned long long _domain_id,
         unsigned long long _historyid
     );
+
+    /**
+     * Same as above, the statements are only added to _pipeline so they can share one round trip with preceding statements.
+     * @return index of 'domain_history' insert result, check it by check_copy_domain_data_to_domain_history_result after exec
+     */
+    std::size_t copy_domain_data_to_domain_history_impl(
+        Database::StandaloneConnection::Pipeline& _pipeline,
+        unsigned long long _domain_id,
+        unsigned long long _historyid
+    );
+
+    /**
+     * @throw std::runtime_error if 'domain_history' record was not inserted
+     */
+    void check_copy_domain_data_to_domain_history_result(const Database::Result& _domain_history_result);
 }
 
 #endif
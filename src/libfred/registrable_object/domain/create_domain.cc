@@ -36,6 +36,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <cstddef>
 #include <set>
 #include <sstream>
 #include <string>
@@ -434,6 +435,8 @@ CreateDomain::Result CreateDomain::exec(const OperationContext& ctx, const std::
         {
             BOOST_THROW_EXCEPTION(create_domain_exception);
         }
+        //enumval and history are sent in one round trip
+        auto pipeline = ctx.get_conn().pipeline();
         if (zone.is_enum)//if ENUM domain, insert enumval
         {
             Database::QueryParams params;//query params
@@ -466,10 +469,15 @@ CreateDomain::Result CreateDomain::exec(const OperationContext& ctx, const std::
             val_sql << ")";
 
             //insert into enumval
-            ctx.get_conn().exec_params(col_sql.str() + val_sql.str(), params);
+            pipeline.add(col_sql.str() + val_sql.str(), params);
         }
 
-        copy_domain_data_to_domain_history_impl(ctx, create_object_result.object_id, create_object_result.history_id);
+        const std::size_t domain_history_idx = copy_domain_data_to_domain_history_impl(
+                pipeline,
+                create_object_result.object_id,
+                create_object_result.history_id);
+        const std::vector<Database::Result> results = pipeline.exec();
+        check_copy_domain_data_to_domain_history_result(results[domain_history_idx]);
         return result;
     }
     catch (ExceptionStack& e)
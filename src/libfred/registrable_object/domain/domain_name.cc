@@ -26,7 +26,10 @@
 #include <boost/foreach.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace LibFred {
@@ -231,7 +234,7 @@ class CheckRFC1035PreferredNameSyntax : public DomainNameChecker
 public:
     bool validate(const DomainName& relative_domain_name)
     {
-        const auto rfc1035_name_syntax = boost::regex{
+        static const auto rfc1035_name_syntax = boost::regex{
             "(([A-Za-z]|[A-Za-z][-A-Za-z0-9]{0,61}[A-Za-z0-9])[.])*"//optional non-highest-level labels
             "([A-Za-z]|[A-Za-z][-A-Za-z0-9]{0,61}[A-Za-z0-9])"};//mandatory highest-level label
         return boost::regex_match(relative_domain_name.get_string(), rfc1035_name_syntax);
@@ -244,8 +247,7 @@ class CheckNoConsecutiveHyphens : public DomainNameChecker
 private:
     bool validate(const DomainName& relative_domain_name) override
     {
-        const auto consecutive_hyphens_syntax = boost::regex{"[-][-]"};
-        return !boost::regex_search(relative_domain_name.get_string(), consecutive_hyphens_syntax);
+        return relative_domain_name.get_string().find("--") == std::string::npos;
     }
 };
 
@@ -255,10 +257,15 @@ class CheckSingleDigitLabelsOnly : public DomainNameChecker
 private:
     bool validate(const DomainName& relative_domain_name) override
     {
-        const auto single_digit_labels_syntax = boost::regex{
-            "([0-9][.])*"//optional non-highest-level single digit labels labels
-            "[0-9]"};//mandatory highest-level single digit label
-        return boost::regex_match(relative_domain_name.get_string(), single_digit_labels_syntax);
+        const std::vector<std::string> labels = relative_domain_name.get_labels();
+        for (const auto& label : labels)
+        {
+            if ((label.length() != 1) || (label[0] < '0') || ('9' < label[0]))
+            {
+                return false;
+            }
+        }
+        return !labels.empty();
     }
 };
 
@@ -328,6 +335,7 @@ void LibFred::Domain::set_domain_name_validation_config_into_database(
                 "SELECT $1::bigint,id FROM enum_domain_name_validation_checker WHERE name=$2::text",
                 Database::query_param_list(zone.id)(*i));
     }//for checker_names
+    invalidate_domain_name_validation_config_cache();
 }
 
 std::vector<std::string> LibFred::Domain::get_domain_name_validation_config_for_zone(
@@ -349,3 +357,74 @@ std::vector<std::string> LibFred::Domain::get_domain_name_validation_config_for_
     }
     return checker_names;
 }
+
+namespace {
+
+class DomainNameValidationConfigCache
+{
+public:
+    static DomainNameValidationConfigCache& get_instance()
+    {
+        static DomainNameValidationConfigCache instance;
+        return instance;
+    }
+
+    std::vector<std::string> get(const LibFred::OperationContext& ctx, const std::string& zone_name)
+    {
+        const std::string key = boost::algorithm::to_lower_copy(zone_name);
+        const auto now = std::chrono::steady_clock::now();
+        unsigned long long generation;
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            const auto cached_itr = config_.find(key);
+            if ((cached_itr != config_.end()) &&
+                (now < (cached_itr->second.loaded_at + domain_name_validation_config_cache_ttl)))
+            {
+                return cached_itr->second.checker_names;
+            }
+            generation = generation_;
+        }
+        //database is queried without lock
+        auto checker_names = get_domain_name_validation_config_for_zone(ctx, zone_name);
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            //do not store configuration which may have been read before invalidation
+            if (generation == generation_)
+            {
+                config_[key] = CachedConfig{checker_names, now};
+            }
+        }
+        return checker_names;
+    }
+
+    void invalidate()
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        config_.clear();
+        ++generation_;
+    }
+private:
+    DomainNameValidationConfigCache() : generation_{0} { }
+    struct CachedConfig
+    {
+        std::vector<std::string> checker_names;
+        std::chrono::steady_clock::time_point loaded_at;
+    };
+    std::mutex mutex_;
+    std::unordered_map<std::string, CachedConfig> config_;
+    unsigned long long generation_;
+};
+
+}//namespace {anonymous}
+
+std::vector<std::string> LibFred::Domain::get_cached_domain_name_validation_config_for_zone(
+        const OperationContext& ctx,
+        const std::string& zone_name)
+{
+    return DomainNameValidationConfigCache::get_instance().get(ctx, zone_name);
+}
+
+void LibFred::Domain::invalidate_domain_name_validation_config_cache()
+{
+    DomainNameValidationConfigCache::get_instance().invalidate();
+}
@@ -29,6 +29,7 @@
 #include "util/factory_check.hh"
 #include "util/optional_value.hh"
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
@@ -151,6 +152,21 @@ std::vector<std::string> get_domain_name_validation_config_for_zone(
         const OperationContext& ctx,
         const std::string& zone_name);
 
+/**
+ * Get domain name checkers for given zone from process-wide cache.
+ * Database is queried only if the zone configuration is not cached yet or it is older than
+ * @ref domain_name_validation_config_cache_ttl. Safe to call from more threads at once.
+ */
+std::vector<std::string> get_cached_domain_name_validation_config_for_zone(
+        const OperationContext& ctx,
+        const std::string& zone_name);
+
+///forget cached domain name checkers of all zones, called by @ref set_domain_name_validation_config_into_database
+void invalidate_domain_name_validation_config_cache();
+
+///max age of cached domain name checkers, changes made by other processes are visible after this period
+constexpr std::chrono::seconds domain_name_validation_config_cache_ttl{60};
+
 }//namespace LibFred::Domain
 }//namespace LibFred
 
@@ -17,6 +17,7 @@
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "libfred/registrable_object/domain/get_domain_data_history.hh"
+#include "libfred/registry_metadata.hh"
 
 #include "libfred/registrable_object/history_interval_impl.hh"
 #include "libfred/registrable_object/exceptions_impl.hh"
@@ -32,12 +33,12 @@ bool does_object_exist(
         const OperationContext& ctx,
         T get_object_id_rule)
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    Database::query_param_list params(get_registry_metadata(ctx)->get_object_type_id(object_type));
     const std::string object_id_rule = get_object_id_rule(params);
     return 0 < ctx.get_conn().exec_params(
             "SELECT 0 "
             "FROM object_registry "
-            "WHERE type=get_object_type_id($1::TEXT) AND "
+            "WHERE type=$1::BIGINT AND "
                   "id=(" + object_id_rule + ")", params).size();
 }
 
@@ -90,7 +91,7 @@ DomainDataHistory get_domain_data_history(
     private:
         Database::query_param_list& params_;
     };
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    Database::query_param_list params(get_registry_metadata(ctx)->get_object_type_id(object_type));
     const std::string object_id_rule = get_object_id_rule(params);
     const auto lower_limit_rule = boost::apply_visitor(LowerLimitVisitor(params), range.lower_limit);
     const auto upper_limit_rule = boost::apply_visitor(UpperLimitVisitor(params), range.upper_limit);
@@ -100,7 +101,7 @@ DomainDataHistory get_domain_data_history(
                        "(" + lower_limit_rule + ") AS lower_limit,"
                        "(" + upper_limit_rule + ") AS upper_limit "
                 "FROM object_registry "
-                "WHERE type=get_object_type_id($1::TEXT) AND "
+                "WHERE type=$1::BIGINT AND "
                       "id=(" + object_id_rule + ")) "
             "SELECT o.uuid,h.uuid,h.valid_from,h.valid_to,h.request_id "
             "FROM o "
@@ -157,7 +158,6 @@ GetDomainDataHistoryById::Result GetDomainDataHistoryById::exec(
         const OperationContext& ctx,
         const HistoryInterval& range)const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
     class OperationById
     {
     public:
@@ -182,12 +182,13 @@ GetDomainDataHistoryByFqdn::Result GetDomainDataHistoryByFqdn::exec(
         const OperationContext& ctx,
         const HistoryInterval& range)const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    const auto object_type_id = get_registry_metadata(ctx)->get_object_type_id(object_type);
     class OperationByFqdn
     {
     public:
-        explicit OperationByFqdn(const std::string& handle)
-            : handle_(handle) { }
+        OperationByFqdn(const std::string& handle, unsigned long long object_type_id)
+            : handle_(handle),
+              object_type_id_(object_type_id) { }
         std::string operator()(Database::query_param_list& params)const
         {
             static const std::string sql_handle_case_normalize_function =
@@ -196,13 +197,14 @@ GetDomainDataHistoryByFqdn::Result GetDomainDataHistoryByFqdn::exec(
             return "SELECT id "
                    "FROM object_registry "
                    "WHERE name=" + sql_handle_case_normalize_function + "($" + params.add(handle_) + "::TEXT) AND "
-                         "type=get_object_type_id($" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT) AND "
+                         "type=$" + params.add(object_type_id_) + "::BIGINT AND "
                          "erdate IS NULL";
         }
     private:
         const std::string handle_;
+        const unsigned long long object_type_id_;
     };
-    return get_domain_data_history(ctx, range, OperationByFqdn(handle_));
+    return get_domain_data_history(ctx, range, OperationByFqdn(handle_, object_type_id));
 }
 
 GetDomainDataHistoryByUuid::GetDomainDataHistoryByUuid(const DomainUuid& domain_uuid)
@@ -213,24 +215,26 @@ GetDomainDataHistoryByUuid::Result GetDomainDataHistoryByUuid::exec(
         const OperationContext& ctx,
         const HistoryInterval& range)const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    const auto object_type_id = get_registry_metadata(ctx)->get_object_type_id(object_type);
     class OperationByUuid
     {
     public:
-        explicit OperationByUuid(const DomainUuid& uuid)
-            : uuid_(uuid) { }
+        OperationByUuid(const DomainUuid& uuid, unsigned long long object_type_id)
+            : uuid_(uuid),
+              object_type_id_(object_type_id) { }
         std::string operator()(Database::query_param_list& params)const
         {
-            const auto object_type_param_text = "$" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT";
+            const auto object_type_param_text = "$" + params.add(object_type_id_) + "::BIGINT";
             return "SELECT id "
                    "FROM object_registry "
                    "WHERE uuid=$" + params.add(uuid_) + "::UUID AND "
-                         "type=get_object_type_id(" + object_type_param_text + ")";
+                         "type=" + object_type_param_text;
         }
     private:
         const DomainUuid uuid_;
+        const unsigned long long object_type_id_;
     };
-    return get_domain_data_history(ctx, range, OperationByUuid(uuid_));
+    return get_domain_data_history(ctx, range, OperationByUuid(uuid_, object_type_id));
 }
 
 } // namespace LibFred::RegistrableObject::Domain
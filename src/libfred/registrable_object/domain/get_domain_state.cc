@@ -17,6 +17,7 @@
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "libfred/registrable_object/domain/get_domain_state.hh"
+#include "libfred/registry_metadata.hh"
 #include "libfred/registrable_object/state_flag_setter.hh"
 #include "libfred/registrable_object/exceptions_impl.hh"
 
@@ -31,12 +32,12 @@ GetDomainStateById::GetDomainStateById(unsigned long long domain_id)
 
 GetDomainStateById::Result GetDomainStateById::exec(const OperationContext& ctx) const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    Database::query_param_list params(get_registry_metadata(ctx)->get_object_type_id(object_type));
     const std::string sql =
             "WITH o AS ("
                 "SELECT id,type "
                 "FROM object_registry "
-                "WHERE type=get_object_type_id($1::TEXT) AND "
+                "WHERE type=$1::BIGINT AND "
                       "id=$" + params.add(domain_id_) + "::BIGINT) "
             "SELECT eos.name "
             "FROM o "
@@ -78,7 +79,7 @@ GetDomainStateByFqdn::Result GetDomainStateByFqdn::exec(const OperationContext&
             "WITH o AS ("
                 "SELECT id,type "
                 "FROM object_registry "
-                "WHERE type=get_object_type_id($" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT) AND "
+                "WHERE type=$" + params.add(get_registry_metadata(ctx)->get_object_type_id(object_type)) + "::BIGINT AND "
                       "name=" + sql_handle_case_normalize_function + "($" + params.add(fqdn_) + "::TEXT) AND "
                       "erdate IS NULL) "
             "SELECT eos.name "
@@ -114,13 +115,13 @@ GetDomainStateByUuid::GetDomainStateByUuid(const DomainUuid& domain_uuid)
 GetDomainStateByUuid::Result GetDomainStateByUuid::exec(const OperationContext& ctx) const
 {
     Database::query_param_list params;
-    const auto object_type_param_text = "$" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT";
+    const auto object_type_param_text = "$" + params.add(get_registry_metadata(ctx)->get_object_type_id(object_type)) + "::BIGINT";
     const std::string sql =
             "WITH o AS ("
                 "SELECT id,type "
                 "FROM object_registry "
                 "WHERE uuid=$" + params.add(uuid_) + "::UUID AND "
-                      "type=get_object_type_id(" + object_type_param_text + ")) "
+                      "type=" + object_type_param_text + ") "
             "SELECT eos.name "
             "FROM o "
             "LEFT JOIN object_state os ON os.object_id=o.id AND "
@@ -37,7 +37,9 @@
 #include <boost/date_time/posix_time/time_period.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace LibFred {
@@ -155,6 +157,162 @@ std::string InfoDomainById::to_string() const
                     (std::make_pair("lock", lock_ ? "true" : "false")));
 }
 
+InfoDomainByFqdns::InfoDomainByFqdns(std::vector<std::string> fqdns)
+    : fqdns_(std::move(fqdns)),
+      lock_(false)
+{}
+
+InfoDomainByFqdns& InfoDomainByFqdns::set_lock()
+{
+    lock_ = true;
+    return *this;
+}
+
+InfoDomainByFqdns::Result InfoDomainByFqdns::exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name)
+{
+    Result result;
+    try
+    {
+        //the same domain may be requested by differently written names
+        std::map<std::string, std::vector<const std::string*>> requested_fqdns;
+        for (const auto& fqdn : fqdns_)
+        {
+            requested_fqdns[boost::algorithm::to_lower_copy(LibFred::Zone::rem_trailing_dot(fqdn))].push_back(&fqdn);
+        }
+        if (requested_fqdns.empty())
+        {
+            return result;
+        }
+        std::vector<std::string> normalized_fqdns;
+        normalized_fqdns.reserve(requested_fqdns.size());
+        for (const auto& requested_fqdn : requested_fqdns)
+        {
+            normalized_fqdns.push_back(requested_fqdn.first);
+        }
+
+        InfoDomain id;
+        id.set_inline_view_filter(
+                Database::ParamQuery(InfoDomain::GetAlias::fqdn())
+                (" = ANY(").param_text_array(normalized_fqdns)(")"))
+                .set_history_query(false);
+
+        if (lock_)
+        {
+            id.set_lock();
+        }
+
+        const std::vector<InfoDomainOutput> domain_res = id.exec(ctx, local_timestamp_pg_time_zone_name);
+        for (const auto& info_domain_output : domain_res)
+        {
+            const auto requested_fqdn_itr = requested_fqdns.find(info_domain_output.info_domain_data.fqdn);
+            if (requested_fqdn_itr == requested_fqdns.end())
+            {
+                BOOST_THROW_EXCEPTION(InternalError("unexpected domain " + info_domain_output.info_domain_data.fqdn));
+            }
+            for (const auto* fqdn : requested_fqdn_itr->second)
+            {
+                if (!result.info.insert(std::make_pair(*fqdn, info_domain_output)).second)
+                {
+                    BOOST_THROW_EXCEPTION(InternalError("query result size > 1"));
+                }
+            }
+        }
+        for (const auto& fqdn : fqdns_)
+        {
+            if (result.info.find(fqdn) == result.info.end())
+            {
+                result.unknown_fqdns.insert(fqdn);
+            }
+        }
+    }
+    catch (ExceptionStack& ex)
+    {
+        ex.add_exception_stack_info(to_string());
+        throw;
+    }
+    return result;
+}
+
+std::string InfoDomainByFqdns::to_string() const
+{
+    return Util::format_operation_state(
+            "InfoDomainByFqdns",
+            Util::vector_of<std::pair<std::string, std::string>>
+                    (std::make_pair("handles", boost::algorithm::join(fqdns_, " ")))
+                    (std::make_pair("lock", lock_ ? "true" : "false")));
+}
+
+InfoDomainByIds::InfoDomainByIds(std::vector<unsigned long long> ids)
+    : ids_(std::move(ids)),
+      lock_(false)
+{}
+
+InfoDomainByIds& InfoDomainByIds::set_lock()
+{
+    lock_ = true;
+    return *this;
+}
+
+InfoDomainByIds::Result InfoDomainByIds::exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name)
+{
+    Result result;
+    try
+    {
+        if (ids_.empty())
+        {
+            return result;
+        }
+
+        InfoDomain id;
+        id.set_inline_view_filter(
+                Database::ParamQuery(InfoDomain::GetAlias::id())
+                (" = ANY(").param_bigint_array(ids_)(")"))
+                .set_history_query(false);
+
+        if (lock_)
+        {
+            id.set_lock();
+        }
+
+        const std::vector<InfoDomainOutput> domain_res = id.exec(ctx, local_timestamp_pg_time_zone_name);
+        for (const auto& info_domain_output : domain_res)
+        {
+            if (!result.info.insert(std::make_pair(info_domain_output.info_domain_data.id, info_domain_output)).second)
+            {
+                BOOST_THROW_EXCEPTION(InternalError("query result size > 1"));
+            }
+        }
+        for (const auto id : ids_)
+        {
+            if (result.info.find(id) == result.info.end())
+            {
+                result.unknown_ids.insert(id);
+            }
+        }
+    }
+    catch (ExceptionStack& ex)
+    {
+        ex.add_exception_stack_info(to_string());
+        throw;
+    }
+    return result;
+}
+
+std::string InfoDomainByIds::to_string() const
+{
+    std::vector<std::string> ids;
+    ids.reserve(ids_.size());
+    for (const auto id : ids_)
+    {
+        ids.push_back(boost::lexical_cast<std::string>(id));
+    }
+    return Util::format_operation_state(
+            "InfoDomainByIds",
+            Util::vector_of<std::pair<std::string, std::string>>
+                    (std::make_pair("ids", boost::algorithm::join(ids, " ")))
+                    (std::make_pair("lock", lock_ ? "true" : "false")));
+}
+
 InfoDomainByUuid::InfoDomainByUuid(const RegistrableObject::Domain::DomainUuid& uuid)
     : uuid_(uuid)
 {
@@ -432,18 +590,7 @@ std::vector<InfoDomainOutput> InfoDomainByRegistrantHandle::exec(
 
     try
     {
-        Database::ParamQuery inline_view_filter_query;
-
-        inline_view_filter_query(
-            "SELECT d.id "
-            "FROM domain d "
-            "JOIN object_registry oreg ON oreg.id=d.registrant AND oreg.name=UPPER(").param_text(registrant_handle_)(") AND "
-                                         "oreg.erdate IS NULL");
-
-        if (limit_.isset())
-        {
-            inline_view_filter_query(" ORDER BY d.id LIMIT ").param_bigint(limit_.get_value());
-        }
+        const Database::ParamQuery inline_view_filter_query = make_domain_id_query();
 
         const Database::Result domain_id_res = ctx.get_conn().exec_params(inline_view_filter_query);
 
@@ -482,6 +629,50 @@ std::vector<InfoDomainOutput> InfoDomainByRegistrantHandle::exec(
     return domain_res;
 }
 
+Database::ParamQuery InfoDomainByRegistrantHandle::make_domain_id_query()const
+{
+    Database::ParamQuery inline_view_filter_query;
+
+    inline_view_filter_query(
+        "SELECT d.id "
+        "FROM domain d "
+        "JOIN object_registry oreg ON oreg.id=d.registrant AND oreg.name=UPPER(").param_text(registrant_handle_)(") AND "
+                                     "oreg.erdate IS NULL");
+
+    if (limit_.isset())
+    {
+        inline_view_filter_query(" ORDER BY d.id LIMIT ").param_bigint(limit_.get_value());
+    }
+
+    return inline_view_filter_query;
+}
+
+void InfoDomainByRegistrantHandle::exec_by_chunks(
+        const OperationContext& ctx,
+        const InfoDomainOutputConsumer& consumer,
+        std::size_t chunk_size,
+        const std::string& local_timestamp_pg_time_zone_name)
+{
+    try
+    {
+        InfoDomain id;
+        id.set_cte_id_filter(make_domain_id_query())
+          .set_history_query(false);
+
+        if (lock_)
+        {
+            id.set_lock();
+        }
+
+        id.exec_by_chunks(ctx, consumer, chunk_size, local_timestamp_pg_time_zone_name);
+    }
+    catch (ExceptionStack& ex)
+    {
+        ex.add_exception_stack_info(to_string());
+        throw;
+    }
+}
+
 std::string InfoDomainByRegistrantHandle::to_string() const
 {
     return Util::format_operation_state("InfoDomainByRegistrantHandle",
@@ -518,19 +709,7 @@ std::vector<InfoDomainOutput> InfoDomainByAdminContactHandle::exec(const Operati
 
     try
     {
-        Database::ParamQuery inline_view_filter_query;
-
-        inline_view_filter_query(
-            "SELECT DISTINCT dcm.domainid"
-                " FROM object_registry oreg"
-                    " JOIN  enum_object_type eot ON oreg.type = eot.id AND eot.name = 'contact'"
-                    " JOIN domain_contact_map dcm ON dcm.contactid = oreg.id"
-                " WHERE oreg.name = UPPER(").param_text(admin_contact_handle_)(") AND oreg.erdate IS NULL");
-
-        if (limit_.isset())
-        {
-            inline_view_filter_query (" ORDER BY dcm.domainid LIMIT ").param_bigint(limit_.get_value());
-        }
+        const Database::ParamQuery inline_view_filter_query = make_domain_id_query();
 
         const Database::Result domain_id_res = ctx.get_conn().exec_params(inline_view_filter_query);
 
@@ -568,6 +747,51 @@ std::vector<InfoDomainOutput> InfoDomainByAdminContactHandle::exec(const Operati
     return domain_res;
 }
 
+Database::ParamQuery InfoDomainByAdminContactHandle::make_domain_id_query()const
+{
+    Database::ParamQuery inline_view_filter_query;
+
+    inline_view_filter_query(
+        "SELECT DISTINCT dcm.domainid"
+            " FROM object_registry oreg"
+                " JOIN  enum_object_type eot ON oreg.type = eot.id AND eot.name = 'contact'"
+                " JOIN domain_contact_map dcm ON dcm.contactid = oreg.id"
+            " WHERE oreg.name = UPPER(").param_text(admin_contact_handle_)(") AND oreg.erdate IS NULL");
+
+    if (limit_.isset())
+    {
+        inline_view_filter_query (" ORDER BY dcm.domainid LIMIT ").param_bigint(limit_.get_value());
+    }
+
+    return inline_view_filter_query;
+}
+
+void InfoDomainByAdminContactHandle::exec_by_chunks(
+        const OperationContext& ctx,
+        const InfoDomainOutputConsumer& consumer,
+        std::size_t chunk_size,
+        const std::string& local_timestamp_pg_time_zone_name)
+{
+    try
+    {
+        InfoDomain id;
+        id.set_cte_id_filter(make_domain_id_query())
+          .set_history_query(false);
+
+        if (lock_)
+        {
+            id.set_lock();
+        }
+
+        id.exec_by_chunks(ctx, consumer, chunk_size, local_timestamp_pg_time_zone_name);
+    }
+    catch (ExceptionStack& ex)
+    {
+        ex.add_exception_stack_info(to_string());
+        throw;
+    }
+}
+
 std::string InfoDomainByAdminContactHandle::to_string() const
 {
     return Util::format_operation_state(
@@ -604,19 +828,7 @@ std::vector<InfoDomainOutput> InfoDomainByNssetHandle::exec(
 
     try
     {
-        Database::ParamQuery inline_view_filter_query;
-
-        inline_view_filter_query(
-            "SELECT d.id "
-            "FROM domain d "
-            "JOIN object_registry noreg ON noreg.id=d.nsset AND noreg.name = UPPER(").param_text(nsset_handle_)(") AND "
-                                          "noreg.type=(SELECT id FROM enum_object_type eot WHERE eot.name='nsset'::text) AND "
-                                          "noreg.erdate IS NULL");
-
-        if (limit_.isset())
-        {
-            inline_view_filter_query(" ORDER BY d.id LIMIT ").param_bigint(limit_.get_value());
-        }
+        const Database::ParamQuery inline_view_filter_query = make_domain_id_query();
 
         const Database::Result domain_id_res = ctx.get_conn().exec_params(inline_view_filter_query);
 
@@ -655,6 +867,51 @@ std::vector<InfoDomainOutput> InfoDomainByNssetHandle::exec(
     return domain_res;
 }
 
+Database::ParamQuery InfoDomainByNssetHandle::make_domain_id_query()const
+{
+    Database::ParamQuery inline_view_filter_query;
+
+    inline_view_filter_query(
+        "SELECT d.id "
+        "FROM domain d "
+        "JOIN object_registry noreg ON noreg.id=d.nsset AND noreg.name = UPPER(").param_text(nsset_handle_)(") AND "
+                                      "noreg.type=(SELECT id FROM enum_object_type eot WHERE eot.name='nsset'::text) AND "
+                                      "noreg.erdate IS NULL");
+
+    if (limit_.isset())
+    {
+        inline_view_filter_query(" ORDER BY d.id LIMIT ").param_bigint(limit_.get_value());
+    }
+
+    return inline_view_filter_query;
+}
+
+void InfoDomainByNssetHandle::exec_by_chunks(
+        const OperationContext& ctx,
+        const InfoDomainOutputConsumer& consumer,
+        std::size_t chunk_size,
+        const std::string& local_timestamp_pg_time_zone_name)
+{
+    try
+    {
+        InfoDomain id;
+        id.set_cte_id_filter(make_domain_id_query())
+          .set_history_query(false);
+
+        if (lock_)
+        {
+            id.set_lock();
+        }
+
+        id.exec_by_chunks(ctx, consumer, chunk_size, local_timestamp_pg_time_zone_name);
+    }
+    catch (ExceptionStack& ex)
+    {
+        ex.add_exception_stack_info(to_string());
+        throw;
+    }
+}
+
 std::string InfoDomainByNssetHandle::to_string()const
 {
     return Util::format_operation_state(
@@ -689,18 +946,7 @@ std::vector<InfoDomainOutput> InfoDomainByKeysetHandle::exec(
     std::vector<InfoDomainOutput> domain_res;
     try
     {
-        Database::ParamQuery inline_view_filter_query;
-
-        inline_view_filter_query(
-            "SELECT d.id FROM domain d "
-            "JOIN object_registry koreg ON koreg.id=d.keyset AND koreg.name=UPPER(").param_text(keyset_handle_)(") AND "
-                                          "koreg.type=(SELECT id FROM enum_object_type eot WHERE eot.name='keyset'::text) AND "
-                                          "koreg.erdate IS NULL");
-
-        if (limit_.isset())
-        {
-            inline_view_filter_query(" ORDER BY d.id LIMIT ").param_bigint(limit_.get_value());
-        }
+        const Database::ParamQuery inline_view_filter_query = make_domain_id_query();
 
         const Database::Result domain_id_res = ctx.get_conn().exec_params(inline_view_filter_query);
 
@@ -739,6 +985,50 @@ std::vector<InfoDomainOutput> InfoDomainByKeysetHandle::exec(
     return domain_res;
 }
 
+Database::ParamQuery InfoDomainByKeysetHandle::make_domain_id_query()const
+{
+    Database::ParamQuery inline_view_filter_query;
+
+    inline_view_filter_query(
+        "SELECT d.id FROM domain d "
+        "JOIN object_registry koreg ON koreg.id=d.keyset AND koreg.name=UPPER(").param_text(keyset_handle_)(") AND "
+                                      "koreg.type=(SELECT id FROM enum_object_type eot WHERE eot.name='keyset'::text) AND "
+                                      "koreg.erdate IS NULL");
+
+    if (limit_.isset())
+    {
+        inline_view_filter_query(" ORDER BY d.id LIMIT ").param_bigint(limit_.get_value());
+    }
+
+    return inline_view_filter_query;
+}
+
+void InfoDomainByKeysetHandle::exec_by_chunks(
+        const OperationContext& ctx,
+        const InfoDomainOutputConsumer& consumer,
+        std::size_t chunk_size,
+        const std::string& local_timestamp_pg_time_zone_name)
+{
+    try
+    {
+        InfoDomain id;
+        id.set_cte_id_filter(make_domain_id_query())
+          .set_history_query(false);
+
+        if (lock_)
+        {
+            id.set_lock();
+        }
+
+        id.exec_by_chunks(ctx, consumer, chunk_size, local_timestamp_pg_time_zone_name);
+    }
+    catch (ExceptionStack& ex)
+    {
+        ex.add_exception_stack_info(to_string());
+        throw;
+    }
+}
+
 std::string InfoDomainByKeysetHandle::to_string()const
 {
     return Util::format_operation_state(
@@ -29,11 +29,15 @@
 #include "libfred/registrable_object/domain/domain_uuid.hh"
 #include "libfred/registrable_object/domain/info_domain_output.hh"
 
+#include "util/db/param_query_composition.hh"
 #include "util/optional_value.hh"
 #include "util/printable.hh"
 
 #include <boost/date_time/posix_time/ptime.hpp>
 
+#include <cstddef>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -135,6 +139,104 @@ private:
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
 };
 
+/**
+ * Domains info by many fully qualified domain names at once.
+ * All domains are fetched by a constant number of queries regardless of the number of requested names.
+ * It's executed by @ref exec method with database connection supplied in @ref OperationContext parameter.
+ */
+class InfoDomainByFqdns : public Util::Printable<InfoDomainByFqdns>
+{
+public:
+    /**
+     * Info domains result.
+     */
+    struct Result
+    {
+        std::map<std::string, InfoDomainOutput> info;/**< info data about existing domains keyed by requested fqdn */
+        std::set<std::string> unknown_fqdns;/**< requested fqdns of nonexistent domains */
+    };
+
+    /**
+     * Info domains constructor with mandatory parameter.
+     * @param fqdns sets fully qualified domain names into @ref fqdns_ attribute
+     */
+    explicit InfoDomainByFqdns(std::vector<std::string> fqdns);
+
+    /**
+     * Sets lock for update.
+     * Default, if not set, is lock for share.
+     * Sets true to lock flag in @ref lock_ attribute
+     * @return operation instance reference to allow method chaining
+     */
+    InfoDomainByFqdns& set_lock();
+
+    /**
+     * Executes getting info about the domains.
+     * @param ctx contains reference to database and logging interface
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     * @return info data about existing domains and the list of unknown ones
+     */
+    Result exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
+
+    /**
+     * Dumps state of the instance into the string
+     * @return string with description of the instance state
+     */
+    std::string to_string()const;
+private:
+    const std::vector<std::string> fqdns_;/**< fully qualified domain names */
+    bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
+};
+
+/**
+ * Domains info by many ids at once.
+ * All domains are fetched by a constant number of queries regardless of the number of requested ids.
+ * It's executed by @ref exec method with database connection supplied in @ref OperationContext parameter.
+ */
+class InfoDomainByIds : public Util::Printable<InfoDomainByIds>
+{
+public:
+    /**
+     * Info domains result.
+     */
+    struct Result
+    {
+        std::map<unsigned long long, InfoDomainOutput> info;/**< info data about existing domains keyed by requested id */
+        std::set<unsigned long long> unknown_ids;/**< requested ids of nonexistent domains */
+    };
+
+    /**
+     * Info domains constructor with mandatory parameter.
+     * @param ids sets object ids of the domains into @ref ids_ attribute
+     */
+    explicit InfoDomainByIds(std::vector<unsigned long long> ids);
+
+    /**
+     * Sets lock for update.
+     * Default, if not set, is lock for share.
+     * Sets true to lock flag in @ref lock_ attribute
+     * @return operation instance reference to allow method chaining
+     */
+    InfoDomainByIds& set_lock();
+
+    /**
+     * Executes getting info about the domains.
+     * @param ctx contains reference to database and logging interface
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     * @return info data about existing domains and the list of unknown ones
+     */
+    Result exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
+
+    /**
+     * Dumps state of the instance into the string
+     * @return string with description of the instance state
+     */
+    std::string to_string()const;
+private:
+    const std::vector<unsigned long long> ids_;/**< object ids of the domains */
+    bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
+};
+
 /**
  * Domain info by uuid.
  * Domain uuid to get info about the domain is set via constructor.
@@ -386,12 +488,27 @@ public:
      */
     std::vector<InfoDomainOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
 
+    /**
+     * Executes getting info about domains by chunks with bounded memory consumption.
+     * Domains are fetched through server-side cursor, the same filter, limit and lock apply as in @ref exec.
+     * @param ctx contains reference to database and logging interface
+     * @param consumer is called for each domain
+     * @param chunk_size is number of domains fetched by one round trip
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     */
+    void exec_by_chunks(
+            const OperationContext& ctx,
+            const InfoDomainOutputConsumer& consumer,
+            std::size_t chunk_size = 1000,
+            const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
+
     /**
      * Dumps state of the instance into the string
      * @return string with description of the instance state
      */
     std::string to_string()const;
 private:
+    Database::ParamQuery make_domain_id_query()const;
     const std::string registrant_handle_;/**< registrant handle */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<unsigned long long> limit_;/**< max number of returned InfoDomainOutput structures */
@@ -436,12 +553,27 @@ public:
      */
     std::vector<InfoDomainOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
 
+    /**
+     * Executes getting info about domains by chunks with bounded memory consumption.
+     * Domains are fetched through server-side cursor, the same filter, limit and lock apply as in @ref exec.
+     * @param ctx contains reference to database and logging interface
+     * @param consumer is called for each domain
+     * @param chunk_size is number of domains fetched by one round trip
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     */
+    void exec_by_chunks(
+            const OperationContext& ctx,
+            const InfoDomainOutputConsumer& consumer,
+            std::size_t chunk_size = 1000,
+            const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
+
     /**
      * Dumps state of the instance into the string
      * @return string with description of the instance state
      */
     std::string to_string()const;
 private:
+    Database::ParamQuery make_domain_id_query()const;
     const std::string admin_contact_handle_;/**< administrator contact handle */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<unsigned long long> limit_;/**< max number of returned InfoDomainOutput structures */
@@ -486,12 +618,27 @@ public:
      */
     std::vector<InfoDomainOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
 
+    /**
+     * Executes getting info about domains by chunks with bounded memory consumption.
+     * Domains are fetched through server-side cursor, the same filter, limit and lock apply as in @ref exec.
+     * @param ctx contains reference to database and logging interface
+     * @param consumer is called for each domain
+     * @param chunk_size is number of domains fetched by one round trip
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     */
+    void exec_by_chunks(
+            const OperationContext& ctx,
+            const InfoDomainOutputConsumer& consumer,
+            std::size_t chunk_size = 1000,
+            const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
+
     /**
      * Dumps state of the instance into the string
      * @return string with description of the instance state
      */
     std::string to_string()const;
 private:
+    Database::ParamQuery make_domain_id_query()const;
     const std::string nsset_handle_;/**< nsset handle */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<unsigned long long> limit_;/**< max number of returned InfoDomainOutput structures */
@@ -536,12 +683,27 @@ public:
      */
     std::vector<InfoDomainOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
 
+    /**
+     * Executes getting info about domains by chunks with bounded memory consumption.
+     * Domains are fetched through server-side cursor, the same filter, limit and lock apply as in @ref exec.
+     * @param ctx contains reference to database and logging interface
+     * @param consumer is called for each domain
+     * @param chunk_size is number of domains fetched by one round trip
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     */
+    void exec_by_chunks(
+            const OperationContext& ctx,
+            const InfoDomainOutputConsumer& consumer,
+            std::size_t chunk_size = 1000,
+            const std::string& local_timestamp_pg_time_zone_name = "Europe/Prague");
+
     /**
      * Dumps state of the instance into the string
      * @return string with description of the instance state
      */
     std::string to_string()const;
 private:
+    Database::ParamQuery make_domain_id_query()const;
     const std::string keyset_handle_;/**< keyset handle */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<unsigned long long> limit_;/**< max number of returned InfoDomainOutput structures */
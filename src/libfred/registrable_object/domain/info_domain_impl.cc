@@ -38,7 +38,11 @@
 #include <boost/date_time/posix_time/time_period.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
+#include <atomic>
+#include <map>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace LibFred {
@@ -206,26 +210,33 @@ Database::ParamQuery InfoDomain::make_domain_query(const std::string& local_time
     return info_domain_query;
 }
 
-Database::ParamQuery InfoDomain::make_admin_query(unsigned long long id, unsigned long long historyid)const
+Database::ParamQuery InfoDomain::make_admin_query(
+        const std::vector<unsigned long long>& ids,
+        const std::vector<unsigned long long>& historyids)const
 {
-    //admin contacts
+    //admin contacts of all domains at once
     Database::ParamQuery query;
 
-    query("SELECT cobr.id AS admin_contact_id, cobr.name AS admin_contact_handle, cobr.uuid AS admin_contact_uuid ");
+    query("SELECT dcm.domainid AS domain_id, ");
     if (history_query_)
     {
-        query("FROM domain_contact_map_history dcm "
+        query("dcm.historyid AS domain_historyid, "
+              "cobr.id AS admin_contact_id, cobr.name AS admin_contact_handle, cobr.uuid AS admin_contact_uuid "
+              "FROM domain_contact_map_history dcm "
               "JOIN object_registry cobr ON cobr.id=dcm.contactid "
               "JOIN enum_object_type ceot ON ceot.id=cobr.type AND ceot.name='contact'::text "
-              "WHERE dcm.domainid=").param_bigint(id)(" AND "
-                    "dcm.historyid=").param_bigint(historyid);
+              "WHERE (dcm.domainid, dcm.historyid) IN (SELECT * FROM UNNEST(")
+                    .param_bigint_array(ids)(", ")
+                    .param_bigint_array(historyids)("))");
     }
     else
     {
-        query("FROM domain_contact_map dcm "
+        query("NULL::BIGINT AS domain_historyid, "
+              "cobr.id AS admin_contact_id, cobr.name AS admin_contact_handle, cobr.uuid AS admin_contact_uuid "
+              "FROM domain_contact_map dcm "
               "JOIN object_registry cobr ON cobr.id=dcm.contactid AND cobr.erdate IS NULL "
               "JOIN enum_object_type ceot ON ceot.id=cobr.type AND ceot.name='contact'::text "
-              "WHERE dcm.domainid=").param_bigint(id);
+              "WHERE dcm.domainid = ANY(").param_bigint_array(ids)(")");
     }
     query(" AND dcm.role=1 "// admin contact
           "ORDER BY cobr.name");
@@ -233,6 +244,118 @@ Database::ParamQuery InfoDomain::make_admin_query(unsigned long long id, unsigne
     return query;
 }
 
+namespace {
+
+InfoDomainOutput make_info_domain_output(const Database::Row& row)
+{
+    InfoDomainOutput info_domain_output;
+    info_domain_output.info_domain_data.id = static_cast<unsigned long long>(row[InfoDomain::GetAlias::id()]);
+    info_domain_output.info_domain_data.uuid = row[InfoDomain::GetAlias::uuid()].as<RegistrableObject::Domain::DomainUuid>();
+    info_domain_output.info_domain_data.roid = static_cast<std::string>(row[InfoDomain::GetAlias::roid()]);
+    info_domain_output.info_domain_data.fqdn = static_cast<std::string>(row[InfoDomain::GetAlias::fqdn()]);
+
+    info_domain_output.info_domain_data.delete_time = row[InfoDomain::GetAlias::delete_time()].isnull()
+            ? Nullable<boost::posix_time::ptime>()
+            : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
+                    static_cast<std::string>(row[InfoDomain::GetAlias::delete_time()])));
+
+    info_domain_output.info_domain_data.historyid = static_cast<unsigned long long>(row[InfoDomain::GetAlias::historyid()]);
+    info_domain_output.info_domain_data.history_uuid = row[InfoDomain::GetAlias::history_uuid()].as<RegistrableObject::Domain::DomainHistoryUuid>();
+
+    info_domain_output.next_historyid = row[InfoDomain::GetAlias::next_historyid()].isnull()
+            ? Nullable<unsigned long long>()
+            : Nullable<unsigned long long>(static_cast<unsigned long long>(row[InfoDomain::GetAlias::next_historyid()]));
+
+    info_domain_output.history_valid_from = boost::posix_time::time_from_string(
+            static_cast<std::string>(row[InfoDomain::GetAlias::history_valid_from()]));
+
+    info_domain_output.history_valid_to = row[InfoDomain::GetAlias::history_valid_to()].isnull()
+            ? Nullable<boost::posix_time::ptime>()
+            : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
+                    static_cast<std::string>(row[InfoDomain::GetAlias::history_valid_to()])));
+
+    info_domain_output.info_domain_data.registrant =
+            RegistrableObject::Contact::ContactReference(
+                    static_cast<unsigned long long>(row[InfoDomain::GetAlias::registrant_id()]),
+                    static_cast<std::string>(row[InfoDomain::GetAlias::registrant_handle()]),
+                    row[InfoDomain::GetAlias::registrant_uuid()].as<RegistrableObject::Contact::ContactUuid>());
+
+    info_domain_output.info_domain_data.nsset =
+            (row[InfoDomain::GetAlias::nsset_id()].isnull() ||
+             row[InfoDomain::GetAlias::nsset_handle()].isnull() ||
+             row[InfoDomain::GetAlias::nsset_uuid()].isnull())
+            ? Nullable<RegistrableObject::Nsset::NssetReference>()
+            : Nullable<RegistrableObject::Nsset::NssetReference>(RegistrableObject::Nsset::NssetReference(
+                    static_cast<unsigned long long>(row[InfoDomain::GetAlias::nsset_id()]),
+                    static_cast<std::string>(row[InfoDomain::GetAlias::nsset_handle()]),
+                    row[InfoDomain::GetAlias::nsset_uuid()].as<RegistrableObject::Nsset::NssetUuid>()));
+
+    info_domain_output.info_domain_data.keyset =
+            (row[InfoDomain::GetAlias::keyset_id()].isnull() ||
+             row[InfoDomain::GetAlias::keyset_handle()].isnull() ||
+             row[InfoDomain::GetAlias::keyset_uuid()].isnull())
+            ? Nullable<RegistrableObject::Keyset::KeysetReference>()
+            : Nullable<RegistrableObject::Keyset::KeysetReference>(RegistrableObject::Keyset::KeysetReference(
+                    static_cast<unsigned long long>(row[InfoDomain::GetAlias::keyset_id()]),
+                    static_cast<std::string>(row[InfoDomain::GetAlias::keyset_handle()]),
+                    row[InfoDomain::GetAlias::keyset_uuid()].as<RegistrableObject::Keyset::KeysetUuid>()));
+
+    info_domain_output.info_domain_data.sponsoring_registrar_handle = static_cast<std::string>(
+            row[InfoDomain::GetAlias::sponsoring_registrar_handle()]);
+    info_domain_output.info_domain_data.create_registrar_handle = static_cast<std::string>(
+            row[InfoDomain::GetAlias::creating_registrar_handle()]);
+
+    info_domain_output.info_domain_data.update_registrar_handle =
+            row[InfoDomain::GetAlias::last_updated_by_registrar_handle()].isnull()
+                ? Nullable<std::string>()
+                : Nullable<std::string>(static_cast<std::string>(
+                        row[InfoDomain::GetAlias::last_updated_by_registrar_handle()]));
+
+    info_domain_output.info_domain_data.creation_time = boost::posix_time::time_from_string(
+            static_cast<std::string>(row[InfoDomain::GetAlias::creation_time()]));
+
+    info_domain_output.info_domain_data.transfer_time = row[InfoDomain::GetAlias::transfer_time()].isnull()
+            ? Nullable<boost::posix_time::ptime>()
+            : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
+                    static_cast<std::string>(row[InfoDomain::GetAlias::transfer_time()])));
+
+    info_domain_output.info_domain_data.update_time = row[InfoDomain::GetAlias::update_time()].isnull()
+            ? Nullable<boost::posix_time::ptime>()
+            : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
+                    static_cast<std::string>(row[InfoDomain::GetAlias::update_time()])));
+
+    info_domain_output.info_domain_data.expiration_date = row[InfoDomain::GetAlias::expiration_date()].isnull()
+            ? boost::gregorian::date()
+            : boost::gregorian::from_string(static_cast<std::string>(row[InfoDomain::GetAlias::expiration_date()]));
+
+    info_domain_output.info_domain_data.enum_domain_validation = !static_cast<bool>(row[InfoDomain::GetAlias::is_enum()])//if not ENUM
+            ? Nullable<ENUMValidationExtension>()
+            : Nullable<ENUMValidationExtension>(ENUMValidationExtension(boost::gregorian::from_string(
+                    static_cast<std::string>(row[InfoDomain::GetAlias::enum_validation_expiration()])),
+                    static_cast<bool>(row[InfoDomain::GetAlias::enum_publish()])));
+
+    info_domain_output.info_domain_data.crhistoryid =
+            static_cast<unsigned long long>(row[InfoDomain::GetAlias::first_historyid()]);
+
+    info_domain_output.info_domain_data.zone = ObjectIdHandlePair(
+            static_cast<unsigned long long>(row[InfoDomain::GetAlias::zone_id()]),
+            static_cast<std::string>(row[InfoDomain::GetAlias::zone_fqdn()]));
+
+    info_domain_output.logd_request_id = row[InfoDomain::GetAlias::logd_request_id()].isnull()
+            ? Nullable<unsigned long long>()
+            : Nullable<unsigned long long>(static_cast<unsigned long long>(row[InfoDomain::GetAlias::logd_request_id()]));
+
+    info_domain_output.utc_timestamp = row[InfoDomain::GetAlias::utc_timestamp()].isnull()
+            ? boost::posix_time::ptime(boost::date_time::not_a_date_time)
+            : boost::posix_time::time_from_string(static_cast<std::string>(row[InfoDomain::GetAlias::utc_timestamp()]));
+
+    return info_domain_output;
+}
+
+std::atomic<unsigned long long> cursor_counter(0);
+
+}//namespace LibFred::{anonymous}
+
 std::vector<InfoDomainOutput> InfoDomain::exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name)const
 {
     std::vector<InfoDomainOutput> result;
@@ -243,122 +366,102 @@ std::vector<InfoDomainOutput> InfoDomain::exec(const OperationContext& ctx, cons
 
     for (Database::Result::size_type idx = 0; idx < query_result.size(); ++idx)
     {
-        InfoDomainOutput info_domain_output;
-        info_domain_output.info_domain_data.id = static_cast<unsigned long long>(query_result[idx][GetAlias::id()]);
-        info_domain_output.info_domain_data.uuid = query_result[idx][GetAlias::uuid()].as<RegistrableObject::Domain::DomainUuid>();
-        info_domain_output.info_domain_data.roid = static_cast<std::string>(query_result[idx][GetAlias::roid()]);
-        info_domain_output.info_domain_data.fqdn = static_cast<std::string>(query_result[idx][GetAlias::fqdn()]);
-
-        info_domain_output.info_domain_data.delete_time = query_result[idx][GetAlias::delete_time()].isnull()
-                ? Nullable<boost::posix_time::ptime>()
-                : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
-                        static_cast<std::string>(query_result[idx][GetAlias::delete_time()])));
-
-        info_domain_output.info_domain_data.historyid = static_cast<unsigned long long>(query_result[idx][GetAlias::historyid()]);
-        info_domain_output.info_domain_data.history_uuid = query_result[idx][GetAlias::history_uuid()].as<RegistrableObject::Domain::DomainHistoryUuid>();
-
-        info_domain_output.next_historyid = query_result[idx][GetAlias::next_historyid()].isnull()
-                ? Nullable<unsigned long long>()
-                : Nullable<unsigned long long>(static_cast<unsigned long long>(query_result[idx][GetAlias::next_historyid()]));
-
-        info_domain_output.history_valid_from = boost::posix_time::time_from_string(
-                static_cast<std::string>(query_result[idx][GetAlias::history_valid_from()]));
-
-        info_domain_output.history_valid_to = query_result[idx][GetAlias::history_valid_to()].isnull()
-                ? Nullable<boost::posix_time::ptime>()
-                : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
-                        static_cast<std::string>(query_result[idx][GetAlias::history_valid_to()])));
-
-        info_domain_output.info_domain_data.registrant =
-                RegistrableObject::Contact::ContactReference(
-                        static_cast<unsigned long long>(query_result[idx][GetAlias::registrant_id()]),
-                        static_cast<std::string>(query_result[idx][GetAlias::registrant_handle()]),
-                        query_result[idx][GetAlias::registrant_uuid()].as<RegistrableObject::Contact::ContactUuid>());
-
-        info_domain_output.info_domain_data.nsset =
-                (query_result[idx][GetAlias::nsset_id()].isnull() ||
-                 query_result[idx][GetAlias::nsset_handle()].isnull() ||
-                 query_result[idx][GetAlias::nsset_uuid()].isnull())
-                ? Nullable<RegistrableObject::Nsset::NssetReference>()
-                : Nullable<RegistrableObject::Nsset::NssetReference>(RegistrableObject::Nsset::NssetReference(
-                        static_cast<unsigned long long>(query_result[idx][GetAlias::nsset_id()]),
-                        static_cast<std::string>(query_result[idx][GetAlias::nsset_handle()]),
-                        query_result[idx][GetAlias::nsset_uuid()].as<RegistrableObject::Nsset::NssetUuid>()));
-
-        info_domain_output.info_domain_data.keyset =
-                (query_result[idx][GetAlias::keyset_id()].isnull() ||
-                 query_result[idx][GetAlias::keyset_handle()].isnull() ||
-                 query_result[idx][GetAlias::keyset_uuid()].isnull())
-                ? Nullable<RegistrableObject::Keyset::KeysetReference>()
-                : Nullable<RegistrableObject::Keyset::KeysetReference>(RegistrableObject::Keyset::KeysetReference(
-                        static_cast<unsigned long long>(query_result[idx][GetAlias::keyset_id()]),
-                        static_cast<std::string>(query_result[idx][GetAlias::keyset_handle()]),
-                        query_result[idx][GetAlias::keyset_uuid()].as<RegistrableObject::Keyset::KeysetUuid>()));
-
-        info_domain_output.info_domain_data.sponsoring_registrar_handle = static_cast<std::string>(
-                query_result[idx][GetAlias::sponsoring_registrar_handle()]);
-        info_domain_output.info_domain_data.create_registrar_handle = static_cast<std::string>(
-                query_result[idx][GetAlias::creating_registrar_handle()]);
-
-        info_domain_output.info_domain_data.update_registrar_handle =
-                query_result[idx][GetAlias::last_updated_by_registrar_handle()].isnull()
-                    ? Nullable<std::string>()
-                    : Nullable<std::string>(static_cast<std::string>(
-                            query_result[idx][GetAlias::last_updated_by_registrar_handle()]));
-
-        info_domain_output.info_domain_data.creation_time = boost::posix_time::time_from_string(
-                static_cast<std::string>(query_result[idx][GetAlias::creation_time()]));
-
-        info_domain_output.info_domain_data.transfer_time = query_result[idx][GetAlias::transfer_time()].isnull()
-                ? Nullable<boost::posix_time::ptime>()
-                : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
-                        static_cast<std::string>(query_result[idx][GetAlias::transfer_time()])));
-
-        info_domain_output.info_domain_data.update_time = query_result[idx][GetAlias::update_time()].isnull()
-                ? Nullable<boost::posix_time::ptime>()
-                : Nullable<boost::posix_time::ptime>(boost::posix_time::time_from_string(
-                        static_cast<std::string>(query_result[idx][GetAlias::update_time()])));
-
-        info_domain_output.info_domain_data.expiration_date = query_result[idx][GetAlias::expiration_date()].isnull()
-                ? boost::gregorian::date()
-                : boost::gregorian::from_string(static_cast<std::string>(query_result[idx][GetAlias::expiration_date()]));
-
-        info_domain_output.info_domain_data.enum_domain_validation = !static_cast<bool>(query_result[idx][GetAlias::is_enum()])//if not ENUM
-                ? Nullable<ENUMValidationExtension>()
-                : Nullable<ENUMValidationExtension>(ENUMValidationExtension(boost::gregorian::from_string(
-                        static_cast<std::string>(query_result[idx][GetAlias::enum_validation_expiration()])),
-                        static_cast<bool>(query_result[idx][GetAlias::enum_publish()])));
-
-        info_domain_output.info_domain_data.crhistoryid =
-                static_cast<unsigned long long>(query_result[idx][GetAlias::first_historyid()]);
-
-        info_domain_output.info_domain_data.zone = ObjectIdHandlePair(
-                static_cast<unsigned long long>(query_result[idx][GetAlias::zone_id()]),
-                static_cast<std::string>(query_result[idx][GetAlias::zone_fqdn()]));
-
-        info_domain_output.logd_request_id = query_result[idx][GetAlias::logd_request_id()].isnull()
-                ? Nullable<unsigned long long>()
-                : Nullable<unsigned long long>(static_cast<unsigned long long>(query_result[idx][GetAlias::logd_request_id()]));
-
-        info_domain_output.utc_timestamp = query_result[idx][GetAlias::utc_timestamp()].isnull()
-                ? boost::posix_time::ptime(boost::date_time::not_a_date_time)
-                : boost::posix_time::time_from_string(static_cast<std::string>(query_result[idx][GetAlias::utc_timestamp()]));
-
-        //list of administrative contacts
-        const Database::Result admin_contact_res = ctx.get_conn().exec_params(this->make_admin_query(
-                info_domain_output.info_domain_data.id, info_domain_output.info_domain_data.historyid));
-        info_domain_output.info_domain_data.admin_contacts.reserve(admin_contact_res.size());
-        for (Database::Result::size_type c_idx = 0; c_idx < admin_contact_res.size(); ++c_idx)
+        result.push_back(make_info_domain_output(query_result[idx]));
+    }
+    this->set_admin_contacts(ctx, result);
+    return result;
+}
+
+void InfoDomain::exec_by_chunks(
+        const OperationContext& ctx,
+        const InfoDomainOutputConsumer& consumer,
+        std::size_t chunk_size,
+        const std::string& local_timestamp_pg_time_zone_name)const
+{
+    if (chunk_size == 0)
+    {
+        throw std::invalid_argument("chunk_size must be positive");
+    }
+    const std::string cursor_name = "info_domain_cursor_" + std::to_string(++cursor_counter);
+    const std::string fetch_query = "FETCH FORWARD " + std::to_string(chunk_size) + " FROM " + cursor_name;
+
+    //every DECLARE has its own cursor name so there is no reason to keep it prepared
+    ctx.get_conn().exec_params(
+            Database::ParamQuery("DECLARE " + cursor_name + " NO SCROLL CURSOR FOR ")
+                    (this->make_domain_query(local_timestamp_pg_time_zone_name)),
+            Database::StatementCaching::disabled);
+    try
+    {
+        std::vector<InfoDomainOutput> chunk;
+        chunk.reserve(chunk_size);
+        while (true)
+        {
+            const Database::Result query_result = ctx.get_conn().exec(fetch_query);
+            chunk.clear();
+            for (Database::Result::size_type idx = 0; idx < query_result.size(); ++idx)
+            {
+                chunk.push_back(make_info_domain_output(query_result[idx]));
+            }
+            this->set_admin_contacts(ctx, chunk);
+            for (const auto& info_domain_output : chunk)
+            {
+                consumer(info_domain_output);
+            }
+            if (query_result.size() < chunk_size)
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        try
         {
-            info_domain_output.info_domain_data.admin_contacts.push_back(RegistrableObject::Contact::ContactReference(
-                    static_cast<unsigned long long>(admin_contact_res[c_idx]["admin_contact_id"]),
-                    static_cast<std::string>(admin_contact_res[c_idx]["admin_contact_handle"]),
-                    admin_contact_res[c_idx]["admin_contact_uuid"].as<RegistrableObject::Contact::ContactUuid>()));
+            ctx.get_conn().exec("CLOSE " + cursor_name);
         }
+        catch (...) { }
+        throw;
+    }
+    ctx.get_conn().exec("CLOSE " + cursor_name);
+}
 
-        result.push_back(info_domain_output);
+void InfoDomain::set_admin_contacts(const OperationContext& ctx, std::vector<InfoDomainOutput>& result)const
+{
+    if (result.empty())
+    {
+        return;
+    }
+
+    //lists of administrative contacts, fetched by one query for all domains
+    std::vector<unsigned long long> ids;
+    std::vector<unsigned long long> historyids;
+    ids.reserve(result.size());
+    historyids.reserve(result.size());
+    std::map<std::pair<unsigned long long, unsigned long long>, InfoDomainData*> domain_by_key;
+    for (auto& info_domain_output : result)
+    {
+        ids.push_back(info_domain_output.info_domain_data.id);
+        historyids.push_back(info_domain_output.info_domain_data.historyid);
+        domain_by_key[std::make_pair(
+                info_domain_output.info_domain_data.id,
+                history_query_ ? info_domain_output.info_domain_data.historyid : 0)] = &info_domain_output.info_domain_data;
+    }
+    const Database::Result admin_contact_res = ctx.get_conn().exec_params(this->make_admin_query(ids, historyids));
+    for (Database::Result::size_type c_idx = 0; c_idx < admin_contact_res.size(); ++c_idx)
+    {
+        const auto domain_key = std::make_pair(
+                static_cast<unsigned long long>(admin_contact_res[c_idx]["domain_id"]),
+                history_query_ ? static_cast<unsigned long long>(admin_contact_res[c_idx]["domain_historyid"]) : 0);
+        const auto domain_itr = domain_by_key.find(domain_key);
+        if (domain_itr == domain_by_key.end())
+        {
+            continue;
+        }
+        domain_itr->second->admin_contacts.push_back(RegistrableObject::Contact::ContactReference(
+                static_cast<unsigned long long>(admin_contact_res[c_idx]["admin_contact_id"]),
+                static_cast<std::string>(admin_contact_res[c_idx]["admin_contact_handle"]),
+                admin_contact_res[c_idx]["admin_contact_uuid"].as<RegistrableObject::Contact::ContactUuid>()));
     }
-    return result;
 }
 
 }//namespace LibFred
@@ -29,6 +29,7 @@
 #include <boost/date_time/posix_time/ptime.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -130,9 +131,26 @@ public:
      * @return info data about the domain descendingly ordered by domain historyid
      */
     std::vector<InfoDomainOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "UTC")const;
+
+    /**
+     * Executes getting info about the domains by chunks.
+     * Rows are fetched through server-side cursor so only @ref chunk_size domains are held in memory at once.
+     * @param ctx contains reference to database and logging interface
+     * @param consumer is called for each domain, domains are descendingly ordered by domain historyid
+     * @param chunk_size is number of domains fetched by one round trip
+     * @param local_timestamp_pg_time_zone_name is postgresql time zone name of the returned data
+     */
+    void exec_by_chunks(
+            const OperationContext& ctx,
+            const InfoDomainOutputConsumer& consumer,
+            std::size_t chunk_size,
+            const std::string& local_timestamp_pg_time_zone_name = "UTC")const;
 private:
+    void set_admin_contacts(const OperationContext& ctx, std::vector<InfoDomainOutput>& result)const;
     Database::ParamQuery make_domain_query(const std::string& local_timestamp_pg_time_zone_name)const;
-    Database::ParamQuery make_admin_query(unsigned long long id, unsigned long long historyid)const;
+    Database::ParamQuery make_admin_query(
+            const std::vector<unsigned long long>& ids,
+            const std::vector<unsigned long long>& historyids)const;
     bool history_query_;/**< flag to query history records of the domain */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<Database::ParamQuery> info_domain_inline_view_filter_expr_;/**< where clause of the info domain query where projection is inline view sub-select */
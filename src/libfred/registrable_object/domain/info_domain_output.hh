@@ -31,6 +31,7 @@
 
 #include <boost/date_time/posix_time/ptime.hpp>
 
+#include <functional>
 #include <string>
 
 namespace LibFred {
@@ -76,6 +77,11 @@ struct InfoDomainOutput : Util::Printable<InfoDomainOutput>
     Nullable<unsigned long long> logd_request_id; /**< id of the request that changed domain data*/
 };
 
+/**
+ * Receiver of domain info data returned one by one.
+ */
+using InfoDomainOutputConsumer = std::function<void(const InfoDomainOutput&)>;
+
 } // namespace LibFred
 
 #endif
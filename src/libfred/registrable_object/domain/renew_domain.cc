@@ -35,8 +35,10 @@
 
 #include <boost/date_time/gregorian/gregorian.hpp>
 
+#include <cstddef>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace LibFred {
 
@@ -130,40 +132,38 @@ unsigned long long RenewDomain::exec(const OperationContext& ctx)
             }
         }
 
-        const unsigned long long history_id = LibFred::InsertHistory(logd_request_id_, domain_id).exec(ctx);
-
-        //object_registry historyid
-        const Database::Result update_historyid_res = ctx.get_conn().exec_params(
-            "UPDATE object_registry SET historyid = $1::bigint "
-                " WHERE id = $2::integer RETURNING id"
-                , Database::query_param_list(history_id)(domain_id));
-        if (update_historyid_res.size() != 1)
-        {
-            BOOST_THROW_EXCEPTION(LibFred::InternalError("historyid update failed"));
-        }
-
-        //set new domain exdate
+        //check new domain exdate
         if (expiration_date_.is_special())
         {
             BOOST_THROW_EXCEPTION(Exception().set_invalid_expiration_date(expiration_date_));
         }
 
-        const Database::Result update_domain_res = ctx.get_conn().exec_params(
-            "UPDATE domain SET exdate = $1::date WHERE id = $2::integer RETURNING id",
-                Database::query_param_list(expiration_date_)(domain_id));
-        if (update_domain_res.size() != 1)
-        {
-            BOOST_THROW_EXCEPTION(InternalError("failed to update domain"));
-        }
-
         //check valexdate if set
         if (enum_validation_expiration_.isset() && enum_validation_expiration_.get_value().is_special())
         {
             BOOST_THROW_EXCEPTION(Exception().set_invalid_enum_validation_expiration_date(enum_validation_expiration_.get_value()));
         }
 
+        const unsigned long long history_id = LibFred::InsertHistory(logd_request_id_, domain_id).exec(ctx);
+
+        //remaining statements do not depend on each other, send them in one round trip
+        auto pipeline = ctx.get_conn().pipeline();
+
+        //object_registry historyid
+        const std::size_t update_historyid_idx = pipeline.add(
+            "UPDATE object_registry SET historyid = $1::bigint "
+                " WHERE id = $2::integer RETURNING id"
+                , Database::query_param_list(history_id)(domain_id));
+
+        //set new domain exdate
+        const std::size_t update_domain_idx = pipeline.add(
+            "UPDATE domain SET exdate = $1::date WHERE id = $2::integer RETURNING id",
+                Database::query_param_list(expiration_date_)(domain_id));
+
         //update enumval
-        if (enum_validation_expiration_.isset() || enum_publish_flag_.isset())
+        const bool update_enumval = enum_validation_expiration_.isset() || enum_publish_flag_.isset();
+        std::size_t update_enumval_idx = 0;
+        if (update_enumval)
         {
             Database::QueryParams params;//query params
             std::ostringstream sql;
@@ -188,13 +188,24 @@ unsigned long long RenewDomain::exec(const OperationContext& ctx)
             params.push_back(domain_id);
             sql << " WHERE domainid = $" << params.size() << "::integer RETURNING domainid";
 
-            const Database::Result update_enumval_res = ctx.get_conn().exec_params(sql.str(), params);
-            if (update_enumval_res.size() != 1)
-            {
-                BOOST_THROW_EXCEPTION(InternalError("failed to update enumval"));
-            }
+            update_enumval_idx = pipeline.add(sql.str(), params);
+        }
+        const std::size_t domain_history_idx = copy_domain_data_to_domain_history_impl(pipeline, domain_id, history_id);
+
+        const std::vector<Database::Result> results = pipeline.exec();
+        if (results[update_historyid_idx].size() != 1)
+        {
+            BOOST_THROW_EXCEPTION(LibFred::InternalError("historyid update failed"));
+        }
+        if (results[update_domain_idx].size() != 1)
+        {
+            BOOST_THROW_EXCEPTION(InternalError("failed to update domain"));
+        }
+        if (update_enumval && (results[update_enumval_idx].size() != 1))
+        {
+            BOOST_THROW_EXCEPTION(InternalError("failed to update enumval"));
         }
-        copy_domain_data_to_domain_history_impl(ctx, domain_id, history_id);
+        check_copy_domain_data_to_domain_history_result(results[domain_history_idx]);
         return history_id;
     }
     catch (ExceptionStack& ex)
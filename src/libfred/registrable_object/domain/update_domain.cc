@@ -38,6 +38,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
+#include <cstddef>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -435,8 +436,13 @@ unsigned long long UpdateDomain::exec(const OperationContext& ctx)
             BOOST_THROW_EXCEPTION(update_domain_exception);
 
 
+        //enumval and history are sent in one round trip
+        auto pipeline = ctx.get_conn().pipeline();
+
         //update enumval
-        if (enum_validation_expiration_.isset() || enum_publish_flag_.isset())
+        const bool update_enumval = enum_validation_expiration_.isset() || enum_publish_flag_.isset();
+        std::size_t update_enumval_idx = 0;
+        if (update_enumval)
         {
             Database::QueryParams params;//query params
             std::ostringstream sql;
@@ -461,13 +467,16 @@ unsigned long long UpdateDomain::exec(const OperationContext& ctx)
             params.push_back(domain_id);
             sql << " WHERE domainid=$" << params.size() << "::integer RETURNING domainid";
 
-            const Database::Result update_enumval_res = ctx.get_conn().exec_params(sql.str(), params);
-            if (update_enumval_res.size() != 1)
-            {
-                BOOST_THROW_EXCEPTION(InternalError("failed to update enumval"));
-            }
+            update_enumval_idx = pipeline.add(sql.str(), params);
+        }
+        const std::size_t domain_history_idx = copy_domain_data_to_domain_history_impl(pipeline, domain_id, history_id);
+
+        const std::vector<Database::Result> results = pipeline.exec();
+        if (update_enumval && (results[update_enumval_idx].size() != 1))
+        {
+            BOOST_THROW_EXCEPTION(InternalError("failed to update enumval"));
         }
-        copy_domain_data_to_domain_history_impl(ctx, domain_id, history_id);
+        check_copy_domain_data_to_domain_history_result(results[domain_history_idx]);
         return history_id;
     }
     catch (ExceptionStack& ex)
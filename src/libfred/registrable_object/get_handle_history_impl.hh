@@ -21,6 +21,7 @@
 
 #include "libfred/registrable_object/get_handle_history.hh"
 #include "libfred/registrable_object/exceptions_impl.hh"
+#include "libfred/registry_metadata.hh"
 
 namespace LibFred {
 namespace RegistrableObject {
@@ -38,7 +39,7 @@ constexpr char sql_get_handle_history[] =
         "FROM object_registry obr "
         "JOIN history bh ON bh.id=obr.crhistoryid "
         "JOIN history eh ON eh.id=obr.historyid "
-        "WHERE obr.type=get_object_type_id($1::TEXT) AND "
+        "WHERE obr.type=$1::BIGINT AND "
               "UPPER(obr.name)=UPPER($2::TEXT) "
         "ORDER BY obr.crdate";
 
@@ -48,7 +49,7 @@ constexpr char sql_get_handle_history<Object_Type::domain>[] =
         "FROM object_registry obr "
         "JOIN history bh ON bh.id=obr.crhistoryid "
         "JOIN history eh ON eh.id=obr.historyid "
-        "WHERE obr.type=get_object_type_id($1::TEXT) AND "
+        "WHERE obr.type=$1::BIGINT AND "
               "obr.name=LOWER($2::TEXT) "
         "ORDER BY obr.crdate";
 
@@ -60,7 +61,7 @@ typename GetHandleHistory<o>::Result GetHandleHistory<o>::exec(const OperationCo
     static const std::string sql = sql_get_handle_history<object_type>;
     const Database::QueryParams params =
             {
-                Conversion::Enums::to_db_handle(object_type),
+                get_registry_metadata(ctx)->get_object_type_id(object_type),
                 handle_
             };
     const auto dbres = ctx.get_conn().exec_params(sql, params);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  set-based insertion of keyset data
+ */
+
+#include "libfred/registrable_object/keyset/add_keyset_data_impl.hh"
+
+#include "util/db/param_query_composition.hh"
+
+#include <string>
+#include <vector>
+
+namespace LibFred
+{
+    namespace
+    {
+        std::vector<std::size_t> get_not_added(
+            std::size_t _number_of_items,
+            const Database::Result& _added_idx_res,
+            const std::vector<bool>& _skipped)
+        {
+            std::vector<bool> added(_number_of_items, false);
+            for (std::size_t i = 0; i < _added_idx_res.size(); ++i)
+            {
+                added.at(static_cast<std::size_t>(_added_idx_res[i][0]) - 1) = true;
+            }
+            std::vector<std::size_t> not_added;
+            for (std::size_t i = 0; i < _number_of_items; ++i)
+            {
+                if (!added[i] && !_skipped[i])
+                {
+                    not_added.push_back(i);
+                }
+            }
+            return not_added;
+        }
+    }
+
+    std::vector<std::size_t> add_keyset_dns_keys_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _keyset_id,
+        const std::vector<DnsKey>& _dns_keys)
+    {
+        if (_dns_keys.empty())
+        {
+            return std::vector<std::size_t>();
+        }
+
+        std::vector<unsigned long long> flags;
+        std::vector<unsigned long long> protocols;
+        std::vector<unsigned long long> algs;
+        std::vector<std::string> keys;
+        flags.reserve(_dns_keys.size());
+        protocols.reserve(_dns_keys.size());
+        algs.reserve(_dns_keys.size());
+        keys.reserve(_dns_keys.size());
+        for (const auto& dns_key : _dns_keys)
+        {
+            flags.push_back(dns_key.get_flags());
+            protocols.push_back(dns_key.get_protocol());
+            algs.push_back(dns_key.get_alg());
+            keys.push_back(dns_key.get_key());
+        }
+
+        //only the first occurrence of a key not set yet is inserted
+        const Database::ReusableParameter keyset_id(_keyset_id, "bigint");
+        const Database::Result added_key_res = _ctx.get_conn().exec_params(Database::ParamQuery(
+            "WITH dns_keys AS ("
+                "SELECT k.idx, k.flags::integer AS flags, k.protocol::integer AS protocol, k.alg::integer AS alg, k.key "
+                "FROM UNNEST(").param_bigint_array(flags)(", ")
+                              .param_bigint_array(protocols)(", ")
+                              .param_bigint_array(algs)(", ")
+                              .param_text_array(keys)(") WITH ORDINALITY AS k(flags, protocol, alg, key, idx)), "
+            "new_dns_keys AS ("
+                "SELECT MIN(dk.idx) AS idx, dk.flags, dk.protocol, dk.alg, dk.key "
+                "FROM dns_keys dk "
+                "WHERE NOT EXISTS (SELECT FROM dnskey "
+                                  "WHERE dnskey.keysetid = ").param(keyset_id)(" AND "
+                                        "dnskey.flags = dk.flags AND "
+                                        "dnskey.protocol = dk.protocol AND "
+                                        "dnskey.alg = dk.alg AND "
+                                        "dnskey.key = dk.key) "
+                "GROUP BY dk.flags, dk.protocol, dk.alg, dk.key), "
+            "inserted AS ("
+                "INSERT INTO dnskey (keysetid, flags, protocol, alg, key) "
+                "SELECT ").param(keyset_id)(", flags, protocol, alg, key FROM new_dns_keys ORDER BY idx "
+                "RETURNING flags, protocol, alg, key) "
+            "SELECT ndk.idx "
+            "FROM new_dns_keys ndk "
+            "JOIN inserted i ON i.flags = ndk.flags AND "
+                               "i.protocol = ndk.protocol AND "
+                               "i.alg = ndk.alg AND "
+                               "i.key = ndk.key"));
+        return get_not_added(_dns_keys.size(), added_key_res, std::vector<bool>(_dns_keys.size(), false));
+    }
+
+    std::vector<std::size_t> add_keyset_tech_contacts_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _keyset_id,
+        const std::vector<unsigned long long>& _tech_contact_ids)
+    {
+        if (_tech_contact_ids.empty())
+        {
+            return std::vector<std::size_t>();
+        }
+
+        //only the first occurrence of a contact not set yet is inserted
+        const Database::ReusableParameter keyset_id(_keyset_id, "bigint");
+        const Database::Result added_contact_res = _ctx.get_conn().exec_params(Database::ParamQuery(
+            "WITH contacts AS ("
+                "SELECT c.idx, c.id "
+                "FROM UNNEST(").param_bigint_array(_tech_contact_ids)(") WITH ORDINALITY AS c(id, idx) "
+                "WHERE c.id != 0), "
+            "new_contacts AS ("
+                "SELECT MIN(contacts.idx) AS idx, contacts.id "
+                "FROM contacts "
+                "WHERE NOT EXISTS (SELECT FROM keyset_contact_map kcm "
+                                  "WHERE kcm.keysetid = ").param(keyset_id)(" AND kcm.contactid = contacts.id) "
+                "GROUP BY contacts.id), "
+            "inserted AS ("
+                "INSERT INTO keyset_contact_map (keysetid, contactid) "
+                "SELECT ").param(keyset_id)(", id FROM new_contacts "
+                "RETURNING contactid) "
+            "SELECT nc.idx "
+            "FROM new_contacts nc "
+            "JOIN inserted i ON i.contactid = nc.id"));
+
+        std::vector<bool> unknown_contacts;
+        unknown_contacts.reserve(_tech_contact_ids.size());
+        for (const auto tech_contact_id : _tech_contact_ids)
+        {
+            unknown_contacts.push_back(tech_contact_id == 0);
+        }
+        return get_not_added(_tech_contact_ids.size(), added_contact_res, unknown_contacts);
+    }
+}
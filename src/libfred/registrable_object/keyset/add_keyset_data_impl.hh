@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  set-based insertion of keyset data
+ */
+
+#ifndef ADD_KEYSET_DATA_IMPL_HH_B83D0F6E27C94A1D95E4A2C70B6F18D3
+#define ADD_KEYSET_DATA_IMPL_HH_B83D0F6E27C94A1D95E4A2C70B6F18D3
+
+#include "libfred/opcontext.hh"
+#include "libfred/registrable_object/keyset/keyset_dns_key.hh"
+
+#include <cstddef>
+#include <vector>
+
+namespace LibFred
+{
+    /**
+     * Inserts DNS keys of keyset by one query.
+     * @param _ctx contains reference to database and logging interface
+     * @param _keyset_id database id of the keyset
+     * @param _dns_keys keys to add
+     * @return indexes of given keys which were not inserted because of being set before or given repeatedly
+     */
+    std::vector<std::size_t> add_keyset_dns_keys_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _keyset_id,
+        const std::vector<DnsKey>& _dns_keys
+    );
+
+    /**
+     * Inserts technical contacts of keyset by one query.
+     * @param _ctx contains reference to database and logging interface
+     * @param _keyset_id database id of the keyset
+     * @param _tech_contact_ids database ids of the contacts, zeros (unknown contacts) are skipped
+     * @return indexes of given contacts which were not inserted because of being set before or given repeatedly
+     */
+    std::vector<std::size_t> add_keyset_tech_contacts_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _keyset_id,
+        const std::vector<unsigned long long>& _tech_contact_ids
+    );
+}
+
+#endif
@@ -17,25 +17,130 @@
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "libfred/registrable_object/keyset/check_dns_key.hh"
+
+#include <atomic>
 #include <stdexcept>
 
 namespace LibFred {
 namespace DnsSec {
 
-Algorithm::Usability get_algorithm_usability(const OperationContext& ctx, int algorithm_number)
+namespace {
+
+std::shared_ptr<const DnsKeyRules>& get_dns_key_rules_snapshot()
 {
-    const Database::Result result = ctx.get_conn().exec_params(
-            "SELECT EXISTS(SELECT 1 FROM dnssec_algorithm_blacklist WHERE alg_number=id) "
-            "FROM dnssec_algorithm WHERE id=$1::INTEGER", Database::query_param_list(algorithm_number));
-    if (result.size() == 0)
+    static std::shared_ptr<const DnsKeyRules> snapshot;
+    return snapshot;
+}
+
+constexpr unsigned short zone_key_flag = 0x0100;
+constexpr unsigned short revoke_flag = 0x0080;
+constexpr unsigned short secure_entry_point_flag = 0x0001;
+constexpr unsigned short dnssec_protocol = 3;
+
+}//namespace LibFred::DnsSec::{anonymous}
+
+DnsKeyRules::DnsKeyRules()
+{
+    algorithm_usability_.fill(Algorithm::invalid_value);
+}
+
+std::shared_ptr<const DnsKeyRules> DnsKeyRules::load(const OperationContext& ctx)
+{
+    std::shared_ptr<DnsKeyRules> rules(new DnsKeyRules());
+    const Database::Result result = ctx.get_conn().exec(
+            "SELECT a.id, EXISTS(SELECT 1 FROM dnssec_algorithm_blacklist b WHERE b.alg_number = a.id) "
+            "FROM dnssec_algorithm a");
+    for (std::size_t idx = 0; idx < result.size(); ++idx)
+    {
+        const auto algorithm_number = static_cast<int>(result[idx][0]);
+        if ((algorithm_number < 0) || (static_cast<int>(rules->algorithm_usability_.size()) <= algorithm_number))
+        {
+            continue;
+        }
+        rules->algorithm_usability_[algorithm_number] = static_cast<bool>(result[idx][1]) ? Algorithm::forbidden
+                                                                                          : Algorithm::usable;
+    }
+    return rules;
+}
+
+Algorithm::Usability DnsKeyRules::get_algorithm_usability(int algorithm_number) const
+{
+    if ((algorithm_number < 0) || (static_cast<int>(algorithm_usability_.size()) <= algorithm_number))
     {
         return Algorithm::invalid_value;
     }
-    if (result.size() != 1)
+    return algorithm_usability_[algorithm_number];
+}
+
+bool DnsKeyRules::are_valid_flags(unsigned short flags) const
+{
+    return (flags & ~(zone_key_flag | revoke_flag | secure_entry_point_flag)) == 0;
+}
+
+bool DnsKeyRules::is_valid_protocol(unsigned short protocol) const
+{
+    return protocol == dnssec_protocol;
+}
+
+DnsKeyValidity::Enum DnsKeyRules::validate(const DnsKey& dns_key) const
+{
+    if (!this->are_valid_flags(dns_key.get_flags()))
+    {
+        return DnsKeyValidity::invalid_flags;
+    }
+    if (!this->is_valid_protocol(dns_key.get_protocol()))
+    {
+        return DnsKeyValidity::invalid_protocol;
+    }
+    switch (this->get_algorithm_usability(dns_key.get_alg()))
+    {
+        case Algorithm::usable:
+            return DnsKeyValidity::valid;
+        case Algorithm::forbidden:
+            return DnsKeyValidity::forbidden_algorithm;
+        case Algorithm::invalid_value:
+            return DnsKeyValidity::invalid_algorithm;
+    }
+    throw std::runtime_error("unexpected algorithm usability");
+}
+
+std::shared_ptr<const DnsKeyRules> get_dns_key_rules(const OperationContext& ctx)
+{
+    auto snapshot = std::atomic_load(&get_dns_key_rules_snapshot());
+    if (snapshot != nullptr)
+    {
+        return snapshot;
+    }
+    return refresh_dns_key_rules(ctx);
+}
+
+std::shared_ptr<const DnsKeyRules> refresh_dns_key_rules(const OperationContext& ctx)
+{
+    auto snapshot = DnsKeyRules::load(ctx);
+    std::atomic_store(&get_dns_key_rules_snapshot(), snapshot);
+    return snapshot;
+}
+
+void invalidate_dns_key_rules()
+{
+    std::atomic_store(&get_dns_key_rules_snapshot(), std::shared_ptr<const DnsKeyRules>());
+}
+
+Algorithm::Usability get_algorithm_usability(const OperationContext& ctx, int algorithm_number)
+{
+    return get_dns_key_rules(ctx)->get_algorithm_usability(algorithm_number);
+}
+
+std::vector<DnsKeyValidity::Enum> validate_dns_keys(const OperationContext& ctx, const std::vector<DnsKey>& dns_keys)
+{
+    const auto rules = get_dns_key_rules(ctx);
+    std::vector<DnsKeyValidity::Enum> result;
+    result.reserve(dns_keys.size());
+    for (const auto& dns_key : dns_keys)
     {
-        throw std::runtime_error("SELECT returns too many rows");
+        result.push_back(rules->validate(dns_key));
     }
-    return static_cast< bool >(result[0][0]) ? Algorithm::forbidden : Algorithm::usable;
+    return result;
 }
 
 } // namespace LibFred::DnsSec
@@ -24,6 +24,11 @@
 #define CHECK_DNS_KEY_HH_D116922494E547B5B638A21AB084ACEB
 
 #include "libfred/opcontext.hh"
+#include "libfred/registrable_object/keyset/keyset_dns_key.hh"
+
+#include <array>
+#include <memory>
+#include <vector>
 
 namespace LibFred {
 namespace DnsSec {
@@ -38,8 +43,82 @@ struct Algorithm
     };
 };
 
+struct DnsKeyValidity
+{
+    enum Enum
+    {
+        valid,
+        invalid_flags,
+        invalid_protocol,
+        invalid_algorithm,
+        forbidden_algorithm,
+    };
+};
+
+/**
+ * Immutable snapshot of rules DNSKEY records have to comply with.
+ * Usability of algorithms comes from dnssec_algorithm and dnssec_algorithm_blacklist tables,
+ * flags and protocol rules are given by RFC4034 and RFC5011.
+ */
+class DnsKeyRules
+{
+public:
+    /**
+     * Loads usability of all algorithms by one query.
+     * @param ctx contains reference to database and logging interface
+     * @return new snapshot
+     */
+    static std::shared_ptr<const DnsKeyRules> load(const OperationContext& ctx);
+
+    Algorithm::Usability get_algorithm_usability(int algorithm_number) const;
+    /**
+     * @return true if only ZONE, SEP and REVOKE bits are set
+     */
+    bool are_valid_flags(unsigned short flags) const;
+    /**
+     * @return true if protocol is 3
+     */
+    bool is_valid_protocol(unsigned short protocol) const;
+    /**
+     * Checks flags, protocol and algorithm of the key in this order, the first violated rule is reported.
+     */
+    DnsKeyValidity::Enum validate(const DnsKey& dns_key) const;
+private:
+    DnsKeyRules();
+    std::array<Algorithm::Usability, 256> algorithm_usability_;
+};
+
+/**
+ * Gets process-wide DNSKEY rules snapshot, loads it on the first use.
+ * Reading of already loaded snapshot doesn't lock anything.
+ * @param ctx contains reference to database and logging interface
+ */
+std::shared_ptr<const DnsKeyRules> get_dns_key_rules(const OperationContext& ctx);
+
+/**
+ * Loads new process-wide DNSKEY rules snapshot, snapshots obtained earlier stay valid.
+ * @param ctx contains reference to database and logging interface
+ */
+std::shared_ptr<const DnsKeyRules> refresh_dns_key_rules(const OperationContext& ctx);
+
+/**
+ * Drops process-wide DNSKEY rules snapshot, the next @ref get_dns_key_rules call loads a new one.
+ */
+void invalidate_dns_key_rules();
+
+/**
+ * Gets usability of algorithm from process-wide DNSKEY rules snapshot.
+ */
 Algorithm::Usability get_algorithm_usability(const OperationContext& ctx, int algorithm_number);
 
+/**
+ * Validates all given keys against one DNSKEY rules snapshot.
+ * @param ctx contains reference to database and logging interface
+ * @param dns_keys keys to validate
+ * @return validity of given keys in the same order
+ */
+std::vector<DnsKeyValidity::Enum> validate_dns_keys(const OperationContext& ctx, const std::vector<DnsKey>& dns_keys);
+
 } // namespace LibFred::DnsSec
 } // namespace LibFred
 
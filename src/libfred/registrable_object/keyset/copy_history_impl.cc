@@ -18,6 +18,10 @@
  */
 #include "libfred/registrable_object/keyset/copy_history_impl.hh"
 
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
 namespace LibFred
 {
     void copy_keyset_data_to_keyset_history_impl(
@@ -25,7 +29,8 @@ namespace LibFred
         const unsigned long long _keyset_id,
         const unsigned long long _historyid
     ) {
-        const Database::Result res = _ctx.get_conn().exec_params(
+        auto pipeline = _ctx.get_conn().pipeline();
+        const std::size_t keyset_history_idx = pipeline.add(
             "INSERT INTO keyset_history( "
                 "historyid,  id"
             ") "
@@ -36,11 +41,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_keyset_id)
         );
 
-        if (res.rows_affected() != 1) {
-            throw std::runtime_error("INSERT INTO keyset_history failed");
-        }
-
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO dsrecord_history( "
                 "historyid,  id, keysetid, keytag, alg, digesttype, digest, maxsiglife "
             ") "
@@ -51,7 +52,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_keyset_id)
         );
 
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO dnskey_history( "
                 "historyid,  id, keysetid, flags, protocol, alg, key "
             ") "
@@ -62,7 +63,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_keyset_id)
         );
 
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO keyset_contact_map_history( "
                 "historyid,  keysetid, contactid "
             ") "
@@ -73,5 +74,9 @@ namespace LibFred
             Database::query_param_list(_historyid)(_keyset_id)
         );
 
+        const std::vector<Database::Result> results = pipeline.exec();
+        if (results[keyset_history_idx].rows_affected() != 1) {
+            throw std::runtime_error("INSERT INTO keyset_history failed");
+        }
     }
 }
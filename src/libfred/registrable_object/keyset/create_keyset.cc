@@ -18,6 +18,7 @@
  */
 
 #include "libfred/registrable_object/keyset/create_keyset.hh"
+#include "libfred/registrable_object/keyset/add_keyset_data_impl.hh"
 #include "libfred/registrable_object/keyset/copy_history_impl.hh"
 #include "libfred/object/object.hh"
 #include "libfred/object/object_impl.hh"
@@ -98,87 +99,25 @@ CreateKeyset::Result CreateKeyset::exec(const OperationContext& _ctx,
                     , Database::query_param_list(result.create_object_result.object_id));
 
             //set dns keys
-            if (!dns_keys_.empty())
+            for (const auto idx : add_keyset_dns_keys_impl(_ctx, result.create_object_result.object_id, dns_keys_))
             {
-                for (std::vector<DnsKey>::const_iterator i = dns_keys_.begin(); i != dns_keys_.end(); ++i)
-                {
-                    try
-                    {
-                        _ctx.get_conn().exec("SAVEPOINT dnskey");
-                        _ctx.get_conn().exec_params(
-                        "INSERT INTO dnskey (keysetid, flags, protocol, alg, key) VALUES($1::integer "
-                        ", $2::integer, $3::integer, $4::integer, $5::text)"
-                        , Database::query_param_list(result.create_object_result.object_id)
-                                                    (i->get_flags())
-                                                    (i->get_protocol())
-                                                    (i->get_alg())
-                                                    (i->get_key()));
-                        _ctx.get_conn().exec("RELEASE SAVEPOINT dnskey");
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        std::string what_string(ex.what());
-                        if (what_string.find("dnskey_unique_key") != std::string::npos)
-                        {
-                            create_keyset_exception.add_already_set_dns_key(*i);
-                            _ctx.get_conn().exec("ROLLBACK TO SAVEPOINT dnskey");
-                        }
-                        else {
-                            throw;
-                        }
-                    }
-                }//for i
-            }//if set dns keys
-
+                create_keyset_exception.add_already_set_dns_key(dns_keys_[idx]);
+            }
 
             //set tech contacts
             if (!tech_contacts_.empty())
             {
-                Database::QueryParams params;//query params
-                std::ostringstream sql;
-
-                params.push_back(result.create_object_result.object_id);
-                sql << "INSERT INTO keyset_contact_map(keysetid, contactid) "
-                        " VALUES ($" << params.size() << "::integer, ";
-
-                for (std::vector<std::string>::const_iterator i = tech_contacts_.begin(); i != tech_contacts_.end(); ++i)
+                //lock object_registry rows for share and get ids
+                const std::vector<unsigned long long> tech_contact_ids = get_object_ids_by_handles_and_type_with_lock(
+                        _ctx, false, tech_contacts_,
+                        Conversion::Enums::to_db_handle(Object_Type::contact),
+                        &create_keyset_exception,
+                        &Exception::add_unknown_technical_contact_handle);
+                for (const auto idx : add_keyset_tech_contacts_impl(_ctx, result.create_object_result.object_id, tech_contact_ids))
                 {
-                    //lock object_registry row for share and get id
-                    unsigned long long tech_contact_id = get_object_id_by_handle_and_type_with_lock(
-                            _ctx, false, *i,
-                            Conversion::Enums::to_db_handle(Object_Type::contact),
-                            &create_keyset_exception,
-                            &Exception::add_unknown_technical_contact_handle);
-                    if (tech_contact_id == 0) continue;
-
-                    Database::QueryParams params_i = params;//query params
-                    std::ostringstream sql_i;
-                    sql_i << sql.str();
-
-                    params_i.push_back(tech_contact_id);
-                    sql_i << " $" << params_i.size() << "::integer) ";
-
-                    try
-                    {
-                        _ctx.get_conn().exec("SAVEPOINT tech_contact");
-                        _ctx.get_conn().exec_params(sql_i.str(), params_i);
-                        _ctx.get_conn().exec("RELEASE SAVEPOINT tech_contact");
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        std::string what_string(ex.what());
-                        if (what_string.find("keyset_contact_map_pkey") != std::string::npos)
-                        {
-                            create_keyset_exception.add_already_set_technical_contact_handle(*i);
-                            _ctx.get_conn().exec("ROLLBACK TO SAVEPOINT tech_contact");
-                        }
-                        else {
-                            throw;
-                        }
-                    }
-                }//for i
-            }//if set tech contacts
-
+                    create_keyset_exception.add_already_set_technical_contact_handle(tech_contacts_[idx]);
+                }
+            }
 
             //get crdate from object_registry
             {
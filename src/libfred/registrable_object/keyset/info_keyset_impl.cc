@@ -31,7 +31,10 @@
 #include <boost/date_time/posix_time/time_period.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
+#include <cstddef>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace LibFred {
@@ -153,26 +156,30 @@ Database::ParamQuery InfoKeyset::make_info_keyset_projection_query(const std::st
 }
 
 Database::ParamQuery InfoKeyset::make_tech_contact_query(
-        unsigned long long id,
-        unsigned long long historyid)const
+        const std::vector<unsigned long long>& ids,
+        const std::vector<unsigned long long>& historyids)const
 {
-    //technical contacts
+    //technical contacts of all keysets at once
     Database::ParamQuery query;
 
-    query("SELECT cobr.id AS tech_contact_id,cobr.name AS tech_contact_handle,cobr.uuid AS tech_contact_uuid ");
+    query("SELECT kcm.keysetid AS keyset_id,");
     if (history_query_)
     {
-        query("FROM keyset_contact_map_history kcm "
+        query("kcm.historyid AS keyset_historyid,"
+              "cobr.id AS tech_contact_id,cobr.name AS tech_contact_handle,cobr.uuid AS tech_contact_uuid "
+              "FROM keyset_contact_map_history kcm "
               "JOIN object_registry cobr ON cobr.id=kcm.contactid "
-              "WHERE kcm.keysetid=").param_bigint(id)(" AND "
-                    "kcm.historyid=").param_bigint(historyid)(" AND "
+              "WHERE (kcm.keysetid,kcm.historyid) IN (SELECT * FROM UNNEST(")
+                    .param_bigint_array(ids)(",").param_bigint_array(historyids)(")) AND "
                     "cobr.type=get_object_type_id('contact')");
     }
     else
     {
-        query("FROM keyset_contact_map kcm "
+        query("NULL::BIGINT AS keyset_historyid,"
+              "cobr.id AS tech_contact_id,cobr.name AS tech_contact_handle,cobr.uuid AS tech_contact_uuid "
+              "FROM keyset_contact_map kcm "
               "JOIN object_registry cobr ON cobr.id=kcm.contactid AND cobr.erdate IS NULL "
-              "WHERE kcm.keysetid = ").param_bigint(id)(" AND "
+              "WHERE kcm.keysetid = ANY(").param_bigint_array(ids)(") AND "
                     "cobr.type=get_object_type_id('contact')");
     }
     query(" ORDER BY cobr.name");
@@ -180,21 +187,25 @@ Database::ParamQuery InfoKeyset::make_tech_contact_query(
 }
 
 Database::ParamQuery InfoKeyset::make_dns_keys_query(
-        unsigned long long id, unsigned long long historyid)const
+        const std::vector<unsigned long long>& ids,
+        const std::vector<unsigned long long>& historyids)const
 {
+    //DNS keys of all keysets at once
     Database::ParamQuery query;
 
-    query("SELECT id,flags,protocol,alg,key ");
+    query("SELECT keysetid AS keyset_id,");
     if (history_query_)
     {
-        query("FROM dnskey_history "
-              "WHERE keysetid=").param_bigint(id)(" AND "
-                    "historyid=").param_bigint(historyid);
+        query("historyid AS keyset_historyid,id,flags,protocol,alg,key "
+              "FROM dnskey_history "
+              "WHERE (keysetid,historyid) IN (SELECT * FROM UNNEST(")
+                    .param_bigint_array(ids)(",").param_bigint_array(historyids)("))");
     }
     else
     {
-        query("FROM dnskey "
-              "WHERE keysetid=").param_bigint(id);
+        query("NULL::BIGINT AS keyset_historyid,id,flags,protocol,alg,key "
+              "FROM dnskey "
+              "WHERE keysetid = ANY(").param_bigint_array(ids)(")");
     }
     query(" ORDER BY id");
     return query;
@@ -240,32 +251,68 @@ std::vector<InfoKeysetOutput> InfoKeyset::exec(const OperationContext& ctx, cons
         info_keyset_output.utc_timestamp = query_result[i][GetAlias::utc_timestamp()].isnull() ? boost::posix_time::ptime(boost::date_time::not_a_date_time)
             : boost::posix_time::time_from_string(static_cast<std::string>(query_result[i][GetAlias::utc_timestamp()]));
 
-        //tech contacts
-        const Database::Result tech_contact_res = ctx.get_conn().exec_params(make_tech_contact_query(
-            info_keyset_output.info_keyset_data.id, info_keyset_output.info_keyset_data.historyid));
-        info_keyset_output.info_keyset_data.tech_contacts.reserve(tech_contact_res.size());
-        for (Database::Result::size_type j = 0; j < tech_contact_res.size(); ++j)
+        result.push_back(info_keyset_output);
+    }
+
+    if (result.empty())
+    {
+        return result;
+    }
+
+    //tech contacts and DNS keys of all keysets are fetched in one round trip
+    std::vector<unsigned long long> ids;
+    std::vector<unsigned long long> historyids;
+    ids.reserve(result.size());
+    historyids.reserve(result.size());
+    std::map<std::pair<unsigned long long, unsigned long long>, InfoKeysetData*> keyset_by_key;
+    for (auto& info_keyset_output : result)
+    {
+        ids.push_back(info_keyset_output.info_keyset_data.id);
+        historyids.push_back(info_keyset_output.info_keyset_data.historyid);
+        keyset_by_key[std::make_pair(
+                info_keyset_output.info_keyset_data.id,
+                history_query_ ? info_keyset_output.info_keyset_data.historyid : 0)] = &info_keyset_output.info_keyset_data;
+    }
+    const auto get_keyset = [&](const Database::Row& row)
+    {
+        const auto keyset_itr = keyset_by_key.find(std::make_pair(
+                static_cast<unsigned long long>(row["keyset_id"]),
+                history_query_ ? static_cast<unsigned long long>(row["keyset_historyid"]) : 0));
+        return keyset_itr == keyset_by_key.end() ? nullptr : keyset_itr->second;
+    };
+
+    auto pipeline = ctx.get_conn().pipeline();
+    const std::size_t tech_contact_idx = pipeline.add(make_tech_contact_query(ids, historyids));
+    const std::size_t dns_keys_idx = pipeline.add(make_dns_keys_query(ids, historyids));
+    const std::vector<Database::Result> child_results = pipeline.exec();
+
+    //tech contacts
+    const Database::Result& tech_contact_res = child_results[tech_contact_idx];
+    for (Database::Result::size_type j = 0; j < tech_contact_res.size(); ++j)
+    {
+        InfoKeysetData* const keyset = get_keyset(tech_contact_res[j]);
+        if (keyset != nullptr)
         {
-            info_keyset_output.info_keyset_data.tech_contacts.push_back(RegistrableObject::Contact::ContactReference(
+            keyset->tech_contacts.push_back(RegistrableObject::Contact::ContactReference(
                 static_cast<unsigned long long>(tech_contact_res[j]["tech_contact_id"]),
                 static_cast<std::string>(tech_contact_res[j]["tech_contact_handle"]),
                 tech_contact_res[j]["tech_contact_uuid"].as<RegistrableObject::Contact::ContactUuid>()));
         }
+    }
 
-        //DNS keys
-        const Database::Result dns_keys_res = ctx.get_conn().exec_params(make_dns_keys_query(
-            info_keyset_output.info_keyset_data.id, info_keyset_output.info_keyset_data.historyid));
-        info_keyset_output.info_keyset_data.tech_contacts.reserve(dns_keys_res.size());
-        for (Database::Result::size_type j = 0; j < dns_keys_res.size(); ++j)
+    //DNS keys
+    const Database::Result& dns_keys_res = child_results[dns_keys_idx];
+    for (Database::Result::size_type j = 0; j < dns_keys_res.size(); ++j)
+    {
+        InfoKeysetData* const keyset = get_keyset(dns_keys_res[j]);
+        if (keyset != nullptr)
         {
             unsigned short flags = static_cast<unsigned int>(dns_keys_res[j]["flags"]);
             unsigned short protocol = static_cast<unsigned int>(dns_keys_res[j]["protocol"]);
             unsigned short alg = static_cast<unsigned int>(dns_keys_res[j]["alg"]);
             std::string key = static_cast<std::string>(dns_keys_res[j]["key"]);
-            info_keyset_output.info_keyset_data.dns_keys.push_back(DnsKey(flags, protocol, alg, key));
+            keyset->dns_keys.push_back(DnsKey(flags, protocol, alg, key));
         }
-
-        result.push_back(info_keyset_output);
     }
 
     return result;
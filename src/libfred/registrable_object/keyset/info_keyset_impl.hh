@@ -114,8 +114,12 @@ public:
     std::vector<InfoKeysetOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "UTC")const;
 private:
     Database::ParamQuery make_info_keyset_projection_query(const std::string& local_timestamp_pg_time_zone_name)const;
-    Database::ParamQuery make_tech_contact_query(unsigned long long id, unsigned long long historyid)const;
-    Database::ParamQuery make_dns_keys_query(unsigned long long id, unsigned long long historyid)const;
+    Database::ParamQuery make_tech_contact_query(
+            const std::vector<unsigned long long>& ids,
+            const std::vector<unsigned long long>& historyids)const;
+    Database::ParamQuery make_dns_keys_query(
+            const std::vector<unsigned long long>& ids,
+            const std::vector<unsigned long long>& historyids)const;
     bool history_query_;/**< flag to query history records of the keyset */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<Database::ParamQuery> info_keyset_inline_view_filter_expr_;/**< where clause of the info keyset query where projection is inline view sub-select */
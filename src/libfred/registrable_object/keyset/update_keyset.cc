@@ -22,6 +22,7 @@
  */
 
 #include "libfred/registrable_object/keyset/update_keyset.hh"
+#include "libfred/registrable_object/keyset/add_keyset_data_impl.hh"
 #include "libfred/registrable_object/keyset/copy_history_impl.hh"
 #include "libfred/object/object.hh"
 #include "libfred/object/object_impl.hh"
@@ -148,47 +149,13 @@ unsigned long long UpdateKeyset::exec(const OperationContext& ctx)
         //add tech contacts
         if (!add_tech_contact_.empty())
         {
-            Database::QueryParams params;//query params
-            std::ostringstream sql;
-
-            params.push_back(keyset_id);
-            sql << "INSERT INTO keyset_contact_map(keysetid, contactid) "
-                    " VALUES ($" << params.size() << "::integer, ";
-
-            for (std::vector<std::string>::iterator i = add_tech_contact_.begin(); i != add_tech_contact_.end(); ++i)
+            //lock object_registry rows for share
+            const std::vector<unsigned long long> tech_contact_ids = get_object_ids_by_handles_and_type_with_lock(
+                    ctx, false, add_tech_contact_, "contact", &update_keyset_exception,
+                    &Exception::add_unknown_technical_contact_handle);
+            for (const auto idx : add_keyset_tech_contacts_impl(ctx, keyset_id, tech_contact_ids))
             {
-                //lock object_registry row for share
-                const unsigned long long tech_contact_id = get_object_id_by_handle_and_type_with_lock(
-                        ctx, false, *i, "contact", &update_keyset_exception,
-                        &Exception::add_unknown_technical_contact_handle);
-                if (tech_contact_id == 0) continue;
-
-                Database::QueryParams params_i = params;//query params
-                std::ostringstream sql_i;
-                sql_i << sql.str();
-
-                params_i.push_back(tech_contact_id);
-
-                sql_i << " $" << params_i.size() << "::integer) ";
-
-                try
-                {
-                    ctx.get_conn().exec("SAVEPOINT add_tech_contact");
-                    ctx.get_conn().exec_params(sql_i.str(), params_i);
-                    ctx.get_conn().exec("RELEASE SAVEPOINT add_tech_contact");
-                }
-                catch (const std::exception& ex)
-                {
-                    std::string what_string(ex.what());
-                    if (what_string.find("keyset_contact_map_pkey") != std::string::npos)
-                    {
-                        update_keyset_exception.add_already_set_technical_contact_handle(*i);
-                        ctx.get_conn().exec("ROLLBACK TO SAVEPOINT add_tech_contact");
-                    }
-                    else {
-                        throw;
-                    }
-                }
+                update_keyset_exception.add_already_set_technical_contact_handle(add_tech_contact_[idx]);
             }
         }
 
@@ -253,32 +220,9 @@ unsigned long long UpdateKeyset::exec(const OperationContext& ctx)
         }
 
         //add dns keys
-        if (!add_dns_key_.empty())
+        for (const auto idx : add_keyset_dns_keys_impl(ctx, keyset_id, add_dns_key_))
         {
-            for (std::vector<DnsKey>::iterator i = add_dns_key_.begin(); i != add_dns_key_.end(); ++i)
-            {
-                try
-                {
-                    ctx.get_conn().exec("SAVEPOINT add_dns_key");
-                    ctx.get_conn().exec_params(
-                    "INSERT INTO dnskey (keysetid, flags, protocol, alg, key) VALUES($1::integer "
-                    ", $2::integer, $3::integer, $4::integer, $5::text)"
-                    , Database::query_param_list(keyset_id)(i->get_flags())(i->get_protocol())(i->get_alg())(i->get_key()));
-                    ctx.get_conn().exec("RELEASE SAVEPOINT add_dns_key");
-                }
-                catch (const std::exception& ex)
-                {
-                    std::string what_string(ex.what());
-                    if (what_string.find("dnskey_unique_key") != std::string::npos)
-                    {
-                        update_keyset_exception.add_already_set_dns_key(*i);
-                        ctx.get_conn().exec("ROLLBACK TO SAVEPOINT add_dns_key");
-                    }
-                    else {
-                        throw;
-                    }
-                }
-            }
+            update_keyset_exception.add_already_set_dns_key(add_dns_key_[idx]);
         }
 
         //check exception
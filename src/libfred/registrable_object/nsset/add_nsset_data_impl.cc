@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  set-based insertion of nsset data
+ */
+
+#include "libfred/registrable_object/nsset/add_nsset_data_impl.hh"
+
+#include "util/db/param_query_composition.hh"
+
+#include <boost/asio/ip/address.hpp>
+
+#include <string>
+#include <vector>
+
+namespace LibFred
+{
+    namespace
+    {
+        //address with IPv6 scope id is not valid inet value
+        bool is_acceptable_as_inet(const boost::asio::ip::address& _address)
+        {
+            return !_address.is_v6() || (_address.to_v6().scope_id() == 0);
+        }
+    }
+
+    AddNssetDnsHostsResult add_nsset_dns_hosts_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _nsset_id,
+        const std::vector<DnsHost>& _dns_hosts)
+    {
+        AddNssetDnsHostsResult result;
+        if (_dns_hosts.empty())
+        {
+            return result;
+        }
+
+        std::vector<std::string> fqdns;
+        fqdns.reserve(_dns_hosts.size());
+        for (const auto& dns_host : _dns_hosts)
+        {
+            fqdns.push_back(dns_host.get_fqdn());
+        }
+
+        //only the first occurrence of a host not set yet is inserted
+        const Database::ReusableParameter nsset_id(_nsset_id, "bigint");
+        const Database::Result added_host_res = _ctx.get_conn().exec_params(Database::ParamQuery(
+            "WITH hosts AS ("
+                "SELECT h.idx, LOWER(h.fqdn) AS fqdn "
+                "FROM UNNEST(").param_text_array(fqdns)(") WITH ORDINALITY AS h(fqdn, idx)), "
+            "new_hosts AS ("
+                "SELECT MIN(hosts.idx) AS idx, hosts.fqdn "
+                "FROM hosts "
+                "WHERE NOT EXISTS (SELECT FROM host WHERE host.nssetid = ").param(nsset_id)(" AND host.fqdn = hosts.fqdn) "
+                "GROUP BY hosts.fqdn), "
+            "inserted AS ("
+                "INSERT INTO host (nssetid, fqdn) "
+                "SELECT ").param(nsset_id)(", fqdn FROM new_hosts ORDER BY idx "
+                "RETURNING id, fqdn) "
+            "SELECT nh.idx, i.id "
+            "FROM new_hosts nh "
+            "JOIN inserted i ON i.fqdn = nh.fqdn"));
+
+        std::vector<unsigned long long> host_ids(_dns_hosts.size(), 0);
+        for (std::size_t i = 0; i < added_host_res.size(); ++i)
+        {
+            host_ids.at(static_cast<std::size_t>(added_host_res[i][0]) - 1) = static_cast<unsigned long long>(added_host_res[i][1]);
+        }
+
+        std::vector<unsigned long long> ipaddr_host_ids;
+        std::vector<std::string> ipaddrs;
+        for (std::size_t i = 0; i < _dns_hosts.size(); ++i)
+        {
+            if (host_ids[i] == 0)
+            {
+                result.already_set_dns_hosts.push_back(_dns_hosts[i].get_fqdn());
+                continue;
+            }
+            for (const auto& ipaddr : _dns_hosts[i].get_inet_addr())
+            {
+                if (!is_acceptable_as_inet(ipaddr))
+                {
+                    result.invalid_dns_host_ipaddrs.push_back(ipaddr.to_string());
+                    continue;
+                }
+                ipaddr_host_ids.push_back(host_ids[i]);
+                ipaddrs.push_back(ipaddr.to_string());
+            }
+        }
+
+        if (!ipaddrs.empty())
+        {
+            _ctx.get_conn().exec_params(Database::ParamQuery(
+                "INSERT INTO host_ipaddr_map (hostid, nssetid, ipaddr) "
+                "SELECT a.hostid, ").param_bigint(_nsset_id)(", a.ipaddr::inet "
+                "FROM UNNEST(").param_bigint_array(ipaddr_host_ids)(", ").param_text_array(ipaddrs)(") AS a(hostid, ipaddr)"));
+        }
+        return result;
+    }
+
+    std::vector<std::size_t> add_nsset_tech_contacts_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _nsset_id,
+        const std::vector<unsigned long long>& _tech_contact_ids)
+    {
+        std::vector<std::size_t> already_set;
+        if (_tech_contact_ids.empty())
+        {
+            return already_set;
+        }
+
+        //only the first occurrence of a contact not set yet is inserted
+        const Database::ReusableParameter nsset_id(_nsset_id, "bigint");
+        const Database::Result added_contact_res = _ctx.get_conn().exec_params(Database::ParamQuery(
+            "WITH contacts AS ("
+                "SELECT c.idx, c.id "
+                "FROM UNNEST(").param_bigint_array(_tech_contact_ids)(") WITH ORDINALITY AS c(id, idx) "
+                "WHERE c.id != 0), "
+            "new_contacts AS ("
+                "SELECT MIN(contacts.idx) AS idx, contacts.id "
+                "FROM contacts "
+                "WHERE NOT EXISTS (SELECT FROM nsset_contact_map ncm "
+                                  "WHERE ncm.nssetid = ").param(nsset_id)(" AND ncm.contactid = contacts.id) "
+                "GROUP BY contacts.id), "
+            "inserted AS ("
+                "INSERT INTO nsset_contact_map (nssetid, contactid) "
+                "SELECT ").param(nsset_id)(", id FROM new_contacts "
+                "RETURNING contactid) "
+            "SELECT nc.idx "
+            "FROM new_contacts nc "
+            "JOIN inserted i ON i.contactid = nc.id"));
+
+        std::vector<bool> added(_tech_contact_ids.size(), false);
+        for (std::size_t i = 0; i < added_contact_res.size(); ++i)
+        {
+            added.at(static_cast<std::size_t>(added_contact_res[i][0]) - 1) = true;
+        }
+        for (std::size_t i = 0; i < _tech_contact_ids.size(); ++i)
+        {
+            if ((_tech_contact_ids[i] != 0) && !added[i])
+            {
+                already_set.push_back(i);
+            }
+        }
+        return already_set;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  set-based insertion of nsset data
+ */
+
+#ifndef ADD_NSSET_DATA_IMPL_HH_4E1B7C03A95D4F2A8C6B17E2D90F35A4
+#define ADD_NSSET_DATA_IMPL_HH_4E1B7C03A95D4F2A8C6B17E2D90F35A4
+
+#include "libfred/opcontext.hh"
+#include "libfred/registrable_object/nsset/nsset_dns_host.hh"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace LibFred
+{
+    /**
+     * Problems found by @ref add_nsset_dns_hosts_impl, the rest of DNS hosts is inserted.
+     */
+    struct AddNssetDnsHostsResult
+    {
+        std::vector<std::string> already_set_dns_hosts;/**< fqdns of hosts set before or given repeatedly */
+        std::vector<std::string> invalid_dns_host_ipaddrs;/**< addresses not acceptable as type inet */
+    };
+
+    /**
+     * Inserts DNS hosts of nsset by one query and their addresses by another one.
+     * @param _ctx contains reference to database and logging interface
+     * @param _nsset_id database id of the nsset
+     * @param _dns_hosts hosts to add, fqdns are stored in lower case
+     * @return hosts and addresses which were not inserted
+     */
+    AddNssetDnsHostsResult add_nsset_dns_hosts_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _nsset_id,
+        const std::vector<DnsHost>& _dns_hosts
+    );
+
+    /**
+     * Inserts technical contacts of nsset by one query.
+     * @param _ctx contains reference to database and logging interface
+     * @param _nsset_id database id of the nsset
+     * @param _tech_contact_ids database ids of the contacts, zeros (unknown contacts) are skipped
+     * @return indexes of given contacts which were not inserted because of being set before or given repeatedly
+     */
+    std::vector<std::size_t> add_nsset_tech_contacts_impl(
+        const LibFred::OperationContext& _ctx,
+        unsigned long long _nsset_id,
+        const std::vector<unsigned long long>& _tech_contact_ids
+    );
+}
+
+#endif
@@ -18,6 +18,10 @@
  */
 #include "libfred/registrable_object/nsset/copy_history_impl.hh"
 
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
 namespace LibFred
 {
     void copy_nsset_data_to_nsset_history_impl(
@@ -25,7 +29,8 @@ namespace LibFred
         const unsigned long long _nsset_id,
         const unsigned long long _historyid
     ) {
-        const Database::Result res = _ctx.get_conn().exec_params(
+        auto pipeline = _ctx.get_conn().pipeline();
+        const std::size_t nsset_history_idx = pipeline.add(
             "INSERT INTO nsset_history( "
                 "historyid,  id, checklevel "
             ") "
@@ -36,11 +41,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_nsset_id)
         );
 
-        if (res.rows_affected() != 1) {
-            throw std::runtime_error("INSERT INTO nsset_history failed");
-        }
-
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO host_history( "
                 "historyid,  id, nssetid, fqdn "
             ") "
@@ -51,7 +52,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_nsset_id)
         );
 
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO host_ipaddr_map_history( "
                 "historyid,  id, hostid, nssetid, ipaddr "
             ") "
@@ -62,7 +63,7 @@ namespace LibFred
             Database::query_param_list(_historyid)(_nsset_id)
         );
 
-        _ctx.get_conn().exec_params(
+        pipeline.add(
             "INSERT INTO nsset_contact_map_history( "
                 "historyid,  nssetid, contactid "
             ") "
@@ -72,5 +73,10 @@ namespace LibFred
             "WHERE nssetid = $2::integer ",
             Database::query_param_list(_historyid)(_nsset_id)
         );
+
+        const std::vector<Database::Result> results = pipeline.exec();
+        if (results[nsset_history_idx].rows_affected() != 1) {
+            throw std::runtime_error("INSERT INTO nsset_history failed");
+        }
     }
 }
@@ -18,6 +18,7 @@
  */
 
 #include "libfred/registrable_object/nsset/create_nsset.hh"
+#include "libfred/registrable_object/nsset/add_nsset_data_impl.hh"
 #include "libfred/registrable_object/nsset/copy_history_impl.hh"
 #include "libfred/object/object.hh"
 #include "libfred/object/object_impl.hh"
@@ -151,107 +152,29 @@ CreateNsset::Result CreateNsset::exec(const OperationContext& ctx, const std::st
             ctx.get_conn().exec_params(col_sql.str() + val_sql.str(), params);
 
             //set dns hosts
-            if (!dns_hosts_.empty())
             {
-                for (std::vector<DnsHost>::iterator i = dns_hosts_.begin(); i != dns_hosts_.end(); ++i)
+                const auto add_dns_hosts_result = add_nsset_dns_hosts_impl(
+                        ctx, result.create_object_result.object_id, dns_hosts_);
+                for (const auto& fqdn : add_dns_hosts_result.already_set_dns_hosts)
                 {
-                    unsigned long long add_host_id = 0;
-                    try
-                    {
-                        ctx.get_conn().exec("SAVEPOINT dnshost");
-                        const Database::Result add_host_id_res = ctx.get_conn().exec_params(
-                        "INSERT INTO host (nssetid, fqdn) VALUES( "
-                        " $1::integer, LOWER($2::text)) RETURNING id"
-                        , Database::query_param_list(result.create_object_result.object_id)(i->get_fqdn()));
-                        ctx.get_conn().exec("RELEASE SAVEPOINT dnshost");
-
-                        add_host_id = static_cast<unsigned long long>(add_host_id_res[0][0]);
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        std::string what_string(ex.what());
-                        if (what_string.find("host_nssetid_fqdn_key") != std::string::npos)
-                        {
-                            create_nsset_exception.add_already_set_dns_host(i->get_fqdn());
-                            ctx.get_conn().exec("ROLLBACK TO SAVEPOINT dnshost");
-                        }
-                        else {
-                            throw;
-                        }
-                    }
-
-                    std::vector<boost::asio::ip::address> dns_host_ip = i->get_inet_addr();
-
-                    for (std::vector<boost::asio::ip::address>::iterator j = dns_host_ip.begin(); j != dns_host_ip.end(); ++j)
-                    {
-                        try
-                        {
-                            ctx.get_conn().exec("SAVEPOINT dnshostipaddr");
-                            ctx.get_conn().exec_params(
-                            "INSERT INTO host_ipaddr_map (hostid, nssetid, ipaddr) "
-                            " VALUES($1::integer, $2::integer, $3::inet)"
-                            , Database::query_param_list(add_host_id)(result.create_object_result.object_id)(*j));
-                            ctx.get_conn().exec("RELEASE SAVEPOINT dnshostipaddr");
-                        }
-                        catch (const std::exception& ex)
-                        {
-                            std::string what_string(ex.what());
-                            if (what_string.find("syntax for type inet") != std::string::npos)
-                            {
-                                create_nsset_exception.add_invalid_dns_host_ipaddr(j->to_string());
-                                ctx.get_conn().exec("ROLLBACK TO SAVEPOINT dnshostipaddr");
-                            }
-                            else {
-                                throw;
-                            }
-                        }
-                    }
+                    create_nsset_exception.add_already_set_dns_host(fqdn);
+                }
+                for (const auto& ipaddr : add_dns_hosts_result.invalid_dns_host_ipaddrs)
+                {
+                    create_nsset_exception.add_invalid_dns_host_ipaddr(ipaddr);
                 }
             }
 
             //set tech contacts
             if (!tech_contacts_.empty())
             {
-                Database::QueryParams params;//query params
-                std::ostringstream sql;
-
-                params.push_back(result.create_object_result.object_id);
-                sql << "INSERT INTO nsset_contact_map(nssetid, contactid) "
-                        " VALUES ($" << params.size() << "::integer, ";
-
-                for (std::vector<std::string>::iterator i = tech_contacts_.begin(); i != tech_contacts_.end(); ++i)
+                //lock object_registry rows for share and get ids
+                const std::vector<unsigned long long> tech_contact_ids = get_object_ids_by_handles_and_type_with_lock(
+                        ctx, false, tech_contacts_, "contact", &create_nsset_exception,
+                        &Exception::add_unknown_technical_contact_handle);
+                for (const auto idx : add_nsset_tech_contacts_impl(ctx, result.create_object_result.object_id, tech_contact_ids))
                 {
-                    //lock object_registry row for share and get id
-                    const unsigned long long tech_contact_id = get_object_id_by_handle_and_type_with_lock(
-                            ctx, false, *i, "contact", &create_nsset_exception,
-                            &Exception::add_unknown_technical_contact_handle);
-                    if (tech_contact_id == 0) continue;
-
-                    Database::QueryParams params_i = params;//query params
-                    std::ostringstream sql_i;
-                    sql_i << sql.str();
-
-                    params_i.push_back(tech_contact_id);
-                    sql_i << " $"<< params_i.size() << "::integer )";
-
-                    try
-                    {
-                        ctx.get_conn().exec("SAVEPOINT tech_contact");
-                        ctx.get_conn().exec_params(sql_i.str(), params_i);
-                        ctx.get_conn().exec("RELEASE SAVEPOINT tech_contact");
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        std::string what_string(ex.what());
-                        if (what_string.find("nsset_contact_map_pkey") != std::string::npos)
-                        {
-                            create_nsset_exception.add_already_set_technical_contact_handle(*i);
-                            ctx.get_conn().exec("ROLLBACK TO SAVEPOINT tech_contact");
-                        }
-                        else {
-                            throw;
-                        }
-                    }
+                    create_nsset_exception.add_already_set_technical_contact_handle(tech_contacts_[idx]);
                 }
             }
 
@@ -17,6 +17,7 @@
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "libfred/registrable_object/nsset/get_nsset_state_history.hh"
+#include "libfred/registry_metadata.hh"
 
 #include "libfred/registrable_object/history_interval_impl.hh"
 #include "libfred/registrable_object/state_flag_setter.hh"
@@ -77,7 +78,7 @@ NssetStateHistory get_nsset_state_history(
     private:
         Database::query_param_list& params_;
     };
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    Database::query_param_list params(get_registry_metadata(ctx)->get_object_type_id(object_type));
     const std::string object_id_rule = get_object_id_rule(params);
     const auto lower_limit_rule = boost::apply_visitor(LowerLimitVisitor(params), range.lower_limit);
     const auto upper_limit_rule = boost::apply_visitor(UpperLimitVisitor(params), range.upper_limit);
@@ -87,7 +88,7 @@ NssetStateHistory get_nsset_state_history(
                        "(" + lower_limit_rule + ") AS lower_limit,"
                        "(" + upper_limit_rule + ") AS upper_limit "
                 "FROM object_registry "
-                "WHERE type=get_object_type_id($1::TEXT) AND "
+                "WHERE type=$1::BIGINT AND "
                       "id=(" + object_id_rule + ")) "
             "SELECT o.lower_limit IS NULL OR o.upper_limit IS NULL OR o.upper_limit<o.lower_limit AS \"limit is invalid\","
                    "CASE WHEN o.lower_limit<o.crdate THEN o.crdate ELSE o.lower_limit END AS \"looking start\","
@@ -196,7 +197,6 @@ GetNssetStateHistoryById::Result GetNssetStateHistoryById::exec(
         const OperationContext& ctx,
         const HistoryInterval& range) const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
     class OperationById
     {
     public:
@@ -221,12 +221,13 @@ GetNssetStateHistoryByHandle::Result GetNssetStateHistoryByHandle::exec(
         const OperationContext& ctx,
         const HistoryInterval& range) const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    const auto object_type_id = get_registry_metadata(ctx)->get_object_type_id(object_type);
     class OperationByHandle
     {
     public:
-        explicit OperationByHandle(const std::string& _handle)
-            : handle_(_handle) { }
+        OperationByHandle(const std::string& _handle, unsigned long long object_type_id)
+            : handle_(_handle),
+              object_type_id_(object_type_id) { }
         std::string operator()(Database::query_param_list& params) const
         {
             static const std::string sql_handle_case_normalize_function =
@@ -235,13 +236,14 @@ GetNssetStateHistoryByHandle::Result GetNssetStateHistoryByHandle::exec(
             return "SELECT id "
                    "FROM object_registry "
                    "WHERE name=" + sql_handle_case_normalize_function + "($" + params.add(handle_) + "::TEXT) AND "
-                         "type=get_object_type_id($" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT) AND "
+                         "type=$" + params.add(object_type_id_) + "::BIGINT AND "
                          "erdate IS NULL";
         }
     private:
         const std::string handle_;
+        const unsigned long long object_type_id_;
     };
-    return get_nsset_state_history(ctx, range, OperationByHandle(handle_));
+    return get_nsset_state_history(ctx, range, OperationByHandle(handle_, object_type_id));
 }
 
 GetNssetStateHistoryByUuid::GetNssetStateHistoryByUuid(const NssetUuid& _nsset_uuid)
@@ -253,24 +255,26 @@ GetNssetStateHistoryByUuid::Result GetNssetStateHistoryByUuid::exec(
         const OperationContext& ctx,
         const HistoryInterval& range) const
 {
-    Database::query_param_list params(Conversion::Enums::to_db_handle(object_type));
+    const auto object_type_id = get_registry_metadata(ctx)->get_object_type_id(object_type);
     class OperationByUuid
     {
     public:
-        explicit OperationByUuid(const NssetUuid& uuid)
-            : uuid_(uuid) { }
+        OperationByUuid(const NssetUuid& uuid, unsigned long long object_type_id)
+            : uuid_(uuid),
+              object_type_id_(object_type_id) { }
         std::string operator()(Database::query_param_list& params) const
         {
-            const auto object_type_param_text = "$" + params.add(Conversion::Enums::to_db_handle(object_type)) + "::TEXT";
+            const auto object_type_param_text = "$" + params.add(object_type_id_) + "::BIGINT";
             return "SELECT id "
                    "FROM object_registry "
                    "WHERE uuid=$" + params.add(uuid_) + "::UUID AND "
-                         "type=get_object_type_id(" + object_type_param_text + ")";
+                         "type=" + object_type_param_text;
         }
     private:
         const NssetUuid uuid_;
+        const unsigned long long object_type_id_;
     };
-    return get_nsset_state_history(ctx, range, OperationByUuid(uuid_));
+    return get_nsset_state_history(ctx, range, OperationByUuid(uuid_, object_type_id));
 }
 
 } // namespace LibFred::RegistrableObject::Nsset
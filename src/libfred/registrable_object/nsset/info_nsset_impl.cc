@@ -32,6 +32,8 @@
 #include <boost/date_time/posix_time/ptime.hpp>
 #include <boost/date_time/posix_time/time_period.hpp>
 
+#include <cstddef>
+#include <map>
 #include <string>
 #include <vector>
 #include <utility>
@@ -160,27 +162,32 @@ Database::ParamQuery InfoNsset::make_info_nsset_projection_query(const std::stri
 }
 
 Database::ParamQuery InfoNsset::make_tech_contact_query(
-        unsigned long long id,
-        unsigned long long historyid)const
+        const std::vector<unsigned long long>& ids,
+        const std::vector<unsigned long long>& historyids)const
 {
+    //tech contacts of all nssets at once
     Database::ParamQuery technical_contacts;
 
-    technical_contacts("SELECT cobr.id AS tech_contact_id,cobr.name AS tech_contact_handle,cobr.uuid AS tech_contact_uuid ");
+    technical_contacts("SELECT ncm.nssetid AS nsset_id,");
     if (history_query_)
     {
         technical_contacts(
+                "ncm.historyid AS nsset_historyid,"
+                "cobr.id AS tech_contact_id,cobr.name AS tech_contact_handle,cobr.uuid AS tech_contact_uuid "
                 "FROM nsset_contact_map_history ncm "
                 "JOIN object_registry cobr ON cobr.id=ncm.contactid "
-                "WHERE ncm.nssetid=").param_bigint(id)(" AND "
-                      "ncm.historyid=").param_bigint(historyid)(" AND "
+                "WHERE (ncm.nssetid,ncm.historyid) IN (SELECT * FROM UNNEST(")
+                        .param_bigint_array(ids)(",").param_bigint_array(historyids)(")) AND "
                       "cobr.type=get_object_type_id('contact')");
     }
     else
     {
         technical_contacts(
+                "NULL::BIGINT AS nsset_historyid,"
+                "cobr.id AS tech_contact_id,cobr.name AS tech_contact_handle,cobr.uuid AS tech_contact_uuid "
                 "FROM nsset_contact_map ncm "
                 "JOIN object_registry cobr ON cobr.id=ncm.contactid AND cobr.erdate IS NULL "
-                "WHERE ncm.nssetid = ").param_bigint(id)(" AND "
+                "WHERE ncm.nssetid = ANY(").param_bigint_array(ids)(") AND "
                       "cobr.type=get_object_type_id('contact')");
     }
     technical_contacts(" ORDER BY cobr.name");
@@ -188,47 +195,44 @@ Database::ParamQuery InfoNsset::make_tech_contact_query(
 }
 
 Database::ParamQuery InfoNsset::make_dns_host_query(
-        unsigned long long nssetid,
-        unsigned long long historyid)const
+        const std::vector<unsigned long long>& ids,
+        const std::vector<unsigned long long>& historyids)const
 {
+    //DNS hosts of all nssets at once joined with their ip addresses
     Database::ParamQuery query;
 
-    query("SELECT h.nssetid AS host_nssetid,h.id AS host_id,h.fqdn AS host_fqdn ");
+    query("SELECT h.nssetid AS host_nssetid,");
     if (history_query_)
     {
-        query("FROM host_history h "
-              "WHERE h.nssetid=").param_bigint(nssetid)(" AND "
-                    "h.historyid=").param_bigint(historyid);
+        query("h.historyid AS host_historyid,h.id AS host_id,h.fqdn AS host_fqdn,ip.ipaddr AS host_ipaddr "
+              "FROM host_history h "
+              "LEFT JOIN host_ipaddr_map_history ip ON ip.hostid=h.id AND ip.historyid=h.historyid "
+              "WHERE (h.nssetid,h.historyid) IN (SELECT * FROM UNNEST(")
+                    .param_bigint_array(ids)(",").param_bigint_array(historyids)("))");
     }
     else
     {
-        query("FROM host h "
+        query("NULL::BIGINT AS host_historyid,h.id AS host_id,h.fqdn AS host_fqdn,ip.ipaddr AS host_ipaddr "
+              "FROM host h "
               "JOIN object_registry nobr ON nobr.id=h.nssetid AND nobr.erdate IS NULL "
-              "WHERE h.nssetid=").param_bigint(nssetid)(" AND "
+              "LEFT JOIN host_ipaddr_map ip ON ip.hostid=h.id "
+              "WHERE h.nssetid = ANY(").param_bigint_array(ids)(") AND "
                     "nobr.type=get_object_type_id('nsset')");
     }
-    query(" ORDER BY h.fqdn");
+    query(" ORDER BY h.fqdn,h.id,ip.ipaddr");
     return query;
 }
 
-Database::ParamQuery InfoNsset::make_dns_ip_query(unsigned long long hostid, unsigned long long historyid)const
+namespace {
+
+struct DnsHostData
 {
-    Database::ParamQuery query;
+    unsigned long long id;
+    std::string fqdn;
+    std::vector<boost::asio::ip::address> ip;
+};
 
-    query("SELECT ipaddr AS host_ipaddr ");
-    if (history_query_)
-    {
-        query("FROM host_ipaddr_map_history "
-              "WHERE hostid=").param_bigint(hostid)(" AND "
-                    "historyid=").param_bigint(historyid);
-    }
-    else
-    {
-        query("FROM host_ipaddr_map WHERE hostid=").param_bigint(hostid);
-    }
-    query(" ORDER BY ipaddr");
-    return query;
-}
+}//namespace LibFred::{anonymous}
 
 std::vector<InfoNssetOutput> InfoNsset::exec(
         const OperationContext& ctx,
@@ -274,38 +278,92 @@ std::vector<InfoNssetOutput> InfoNsset::exec(
         info_nsset_output.utc_timestamp = param_query_result[i][GetAlias::utc_timestamp()].isnull() ? boost::posix_time::ptime(boost::date_time::not_a_date_time)
             : boost::posix_time::time_from_string(static_cast<std::string>(param_query_result[i][GetAlias::utc_timestamp()]));
 
-        //tech contacts
-        const Database::Result tech_contact_res = ctx.get_conn().exec_params(make_tech_contact_query(
-                info_nsset_output.info_nsset_data.id, info_nsset_output.info_nsset_data.historyid));
-        info_nsset_output.info_nsset_data.tech_contacts.reserve(tech_contact_res.size());
-        for (Database::Result::size_type j = 0; j < tech_contact_res.size(); ++j)
+        result.push_back(info_nsset_output);
+    }
+
+    if (result.empty())
+    {
+        return result;
+    }
+
+    //tech contacts and DNS hosts of all nssets are fetched in one round trip
+    std::vector<unsigned long long> ids;
+    std::vector<unsigned long long> historyids;
+    ids.reserve(result.size());
+    historyids.reserve(result.size());
+    std::map<std::pair<unsigned long long, unsigned long long>, InfoNssetData*> nsset_by_key;
+    for (auto& info_nsset_output : result)
+    {
+        ids.push_back(info_nsset_output.info_nsset_data.id);
+        historyids.push_back(info_nsset_output.info_nsset_data.historyid);
+        nsset_by_key[std::make_pair(
+                info_nsset_output.info_nsset_data.id,
+                history_query_ ? info_nsset_output.info_nsset_data.historyid : 0)] = &info_nsset_output.info_nsset_data;
+    }
+    const auto get_nsset = [&](const Database::Row& row, const char* id_column, const char* historyid_column)
+    {
+        const auto nsset_itr = nsset_by_key.find(std::make_pair(
+                static_cast<unsigned long long>(row[id_column]),
+                history_query_ ? static_cast<unsigned long long>(row[historyid_column]) : 0));
+        return nsset_itr == nsset_by_key.end() ? nullptr : nsset_itr->second;
+    };
+
+    auto pipeline = ctx.get_conn().pipeline();
+    const std::size_t tech_contact_idx = pipeline.add(make_tech_contact_query(ids, historyids));
+    const std::size_t dns_host_idx = pipeline.add(make_dns_host_query(ids, historyids));
+    const std::vector<Database::Result> child_results = pipeline.exec();
+
+    //tech contacts
+    const Database::Result& tech_contact_res = child_results[tech_contact_idx];
+    for (Database::Result::size_type j = 0; j < tech_contact_res.size(); ++j)
+    {
+        InfoNssetData* const nsset = get_nsset(tech_contact_res[j], "nsset_id", "nsset_historyid");
+        if (nsset != nullptr)
         {
-            info_nsset_output.info_nsset_data.tech_contacts.push_back(RegistrableObject::Contact::ContactReference(
+            nsset->tech_contacts.push_back(RegistrableObject::Contact::ContactReference(
                     static_cast<unsigned long long>(tech_contact_res[j]["tech_contact_id"]),
                     static_cast<std::string>(tech_contact_res[j]["tech_contact_handle"]),
                     tech_contact_res[j]["tech_contact_uuid"].as<RegistrableObject::Contact::ContactUuid>()));
         }
+    }
 
-        //DNS keys
-        const Database::Result dns_hosts_res = ctx.get_conn().exec_params(make_dns_host_query(
-                info_nsset_output.info_nsset_data.id, info_nsset_output.info_nsset_data.historyid));
-        info_nsset_output.info_nsset_data.dns_hosts.reserve(dns_hosts_res.size());
-        for (Database::Result::size_type j = 0; j < dns_hosts_res.size(); ++j)
+    //DNS hosts, one row per ip address (or one row with NULL address)
+    const Database::Result& dns_hosts_res = child_results[dns_host_idx];
+    std::map<const InfoNssetData*, std::vector<DnsHostData>> dns_hosts;
+    for (Database::Result::size_type j = 0; j < dns_hosts_res.size(); ++j)
+    {
+        const InfoNssetData* const nsset = get_nsset(dns_hosts_res[j], "host_nssetid", "host_historyid");
+        if (nsset == nullptr)
         {
-            unsigned long long dns_host_id = static_cast<unsigned long long>(dns_hosts_res[j]["host_id"]);
-            std::string dns_host_fqdn = static_cast<std::string>(dns_hosts_res[j]["host_fqdn"]);
-
-            const Database::Result dns_ip_res = ctx.get_conn().exec_params(make_dns_ip_query(
-                    dns_host_id, info_nsset_output.info_nsset_data.historyid ));
-            std::vector<boost::asio::ip::address> dns_ip;
-            dns_ip.reserve(dns_ip_res.size());
-            for (Database::Result::size_type k = 0; k < dns_ip_res.size(); ++k)
-            {
-                dns_ip.push_back(boost::asio::ip::address::from_string(static_cast<std::string>(dns_ip_res[k]["host_ipaddr"])));
-            }
-            info_nsset_output.info_nsset_data.dns_hosts.push_back(DnsHost(dns_host_fqdn, dns_ip));
+            continue;
+        }
+        std::vector<DnsHostData>& nsset_dns_hosts = dns_hosts[nsset];
+        const unsigned long long dns_host_id = static_cast<unsigned long long>(dns_hosts_res[j]["host_id"]);
+        if (nsset_dns_hosts.empty() || (nsset_dns_hosts.back().id != dns_host_id))
+        {
+            nsset_dns_hosts.push_back(DnsHostData{
+                    dns_host_id,
+                    static_cast<std::string>(dns_hosts_res[j]["host_fqdn"]),
+                    std::vector<boost::asio::ip::address>()});
+        }
+        if (!dns_hosts_res[j]["host_ipaddr"].isnull())
+        {
+            nsset_dns_hosts.back().ip.push_back(boost::asio::ip::address::from_string(
+                    static_cast<std::string>(dns_hosts_res[j]["host_ipaddr"])));
+        }
+    }
+    for (auto& info_nsset_output : result)
+    {
+        const auto dns_hosts_itr = dns_hosts.find(&info_nsset_output.info_nsset_data);
+        if (dns_hosts_itr == dns_hosts.end())
+        {
+            continue;
+        }
+        info_nsset_output.info_nsset_data.dns_hosts.reserve(dns_hosts_itr->second.size());
+        for (const auto& dns_host : dns_hosts_itr->second)
+        {
+            info_nsset_output.info_nsset_data.dns_hosts.push_back(DnsHost(dns_host.fqdn, dns_host.ip));
         }
-        result.push_back(info_nsset_output);
     }
     return result;
 }
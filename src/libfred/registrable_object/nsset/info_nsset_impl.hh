@@ -116,9 +116,12 @@ public:
     std::vector<InfoNssetOutput> exec(const OperationContext& ctx, const std::string& local_timestamp_pg_time_zone_name = "UTC")const;
 private:
     Database::ParamQuery make_info_nsset_projection_query(const std::string& local_timestamp_pg_time_zone_name)const;
-    Database::ParamQuery make_tech_contact_query(unsigned long long id, unsigned long long historyid)const;
-    Database::ParamQuery make_dns_host_query(unsigned long long nssetid, unsigned long long historyid)const;
-    Database::ParamQuery make_dns_ip_query(unsigned long long hostid, unsigned long long historyid)const;
+    Database::ParamQuery make_tech_contact_query(
+            const std::vector<unsigned long long>& ids,
+            const std::vector<unsigned long long>& historyids)const;
+    Database::ParamQuery make_dns_host_query(
+            const std::vector<unsigned long long>& ids,
+            const std::vector<unsigned long long>& historyids)const;
     bool history_query_;/**< flag to query history records of the nsset */
     bool lock_;/**< if set to true lock object_registry row for update, if set to false lock for share */
     Optional<Database::ParamQuery> info_nsset_inline_view_filter_expr_;/**< where clause of the info nsset query where projection is inline view sub-select */
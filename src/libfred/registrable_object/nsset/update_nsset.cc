@@ -22,6 +22,7 @@
  */
 
 #include "libfred/registrable_object/nsset/update_nsset.hh"
+#include "libfred/registrable_object/nsset/add_nsset_data_impl.hh"
 #include "libfred/registrable_object/nsset/copy_history_impl.hh"
 #include "libfred/object/object.hh"
 #include "libfred/object/object_impl.hh"
@@ -110,8 +111,6 @@ UpdateNsset& UpdateNsset::set_tech_check_level(short tech_check_level)
 
 unsigned long long UpdateNsset::exec(const OperationContext& ctx)
 {
-    namespace ip = boost::asio::ip;
-
     try
     {
         //check registrar
@@ -171,47 +170,13 @@ unsigned long long UpdateNsset::exec(const OperationContext& ctx)
         //add tech contacts
         if (!add_tech_contact_.empty())
         {
-            Database::QueryParams params;//query params
-            std::ostringstream sql;
-
-            params.push_back(nsset_id);
-            sql << "INSERT INTO nsset_contact_map(nssetid, contactid) "
-                    " VALUES ($" << params.size() << "::integer, ";
-
-            for (std::vector<std::string>::iterator i = add_tech_contact_.begin(); i != add_tech_contact_.end(); ++i)
+            //lock object_registry rows for share
+            const std::vector<unsigned long long> tech_contact_ids = get_object_ids_by_handles_and_type_with_lock(
+                    ctx, false, add_tech_contact_, "contact", &update_nsset_exception,
+                    &Exception::add_unknown_technical_contact_handle);
+            for (const auto idx : add_nsset_tech_contacts_impl(ctx, nsset_id, tech_contact_ids))
             {
-                //lock object_registry row for share
-                unsigned long long tech_contact_id = get_object_id_by_handle_and_type_with_lock(
-                        ctx, false, *i, "contact",&update_nsset_exception,
-                        &Exception::add_unknown_technical_contact_handle);
-                if (tech_contact_id == 0) continue;
-
-                Database::QueryParams params_i = params;//query params
-                std::ostringstream sql_i;
-                sql_i << sql.str();
-
-                params_i.push_back(tech_contact_id);
-                sql_i << " $" << params_i.size() << "::integer) ";
-
-                try
-                {
-                    ctx.get_conn().exec("SAVEPOINT add_tech_contact");
-                    ctx.get_conn().exec_params(sql_i.str(), params_i);
-                    ctx.get_conn().exec("RELEASE SAVEPOINT add_tech_contact");
-                }
-                catch (const std::exception& ex)
-                {
-                    std::string what_string(ex.what());
-                    if (what_string.find("nsset_contact_map_pkey") != std::string::npos)
-                    {
-                        update_nsset_exception.add_already_set_technical_contact_handle(*i);
-                        ctx.get_conn().exec("ROLLBACK TO SAVEPOINT add_tech_contact");
-                    }
-                    else {
-                        throw;
-                    }
-                }
-
+                update_nsset_exception.add_already_set_technical_contact_handle(add_tech_contact_[idx]);
             }
         }
 
@@ -281,61 +246,15 @@ unsigned long long UpdateNsset::exec(const OperationContext& ctx)
         }
 
         //add dns hosts
-        if (!add_dns_.empty())
         {
-            for (std::vector<DnsHost>::iterator i = add_dns_.begin(); i != add_dns_.end(); ++i)
+            const auto add_dns_hosts_result = add_nsset_dns_hosts_impl(ctx, nsset_id, add_dns_);
+            for (const auto& fqdn : add_dns_hosts_result.already_set_dns_hosts)
             {
-                unsigned long long add_host_id = 0;
-                try
-                {
-                    ctx.get_conn().exec("SAVEPOINT add_dns_host");
-                    const Database::Result add_host_id_res = ctx.get_conn().exec_params(
-                        "INSERT INTO host (nssetid, fqdn) VALUES( "
-                        " $1::integer, LOWER($2::text)) RETURNING id"
-                        , Database::query_param_list(nsset_id)(i->get_fqdn()));
-                    ctx.get_conn().exec("RELEASE SAVEPOINT add_dns_host");
-                    add_host_id = static_cast<unsigned long long>(add_host_id_res[0][0]);
-                }
-                catch (const std::exception& ex)
-                {
-                    std::string what_string(ex.what());
-                    if (what_string.find("host_nssetid_fqdn_key") != std::string::npos)
-                    {
-                        update_nsset_exception.add_already_set_dns_host(i->get_fqdn());
-                        ctx.get_conn().exec("ROLLBACK TO SAVEPOINT add_dns_host");
-                        continue;//for add_dns_
-                    }
-                    else {
-                        throw;
-                    }
-                }
-
-                std::vector<ip::address> dns_host_ip = i->get_inet_addr();
-
-                for (std::vector<ip::address>::iterator j = dns_host_ip.begin(); j != dns_host_ip.end(); ++j)
-                {
-                    try
-                    {
-                        ctx.get_conn().exec("SAVEPOINT add_dns_host_ipaddr");
-                        ctx.get_conn().exec_params(
-                        "INSERT INTO host_ipaddr_map (hostid, nssetid, ipaddr) "
-                        " VALUES($1::integer, $2::integer, $3::inet)"
-                        , Database::query_param_list(add_host_id)(nsset_id)(j->to_string()));
-                        ctx.get_conn().exec("RELEASE SAVEPOINT add_dns_host_ipaddr");
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        std::string what_string(ex.what());
-                        if (what_string.find("syntax for type inet") != std::string::npos)
-                        {
-                            update_nsset_exception.add_invalid_dns_host_ipaddr(j->to_string());
-                            ctx.get_conn().exec("ROLLBACK TO SAVEPOINT add_dns_host_ipaddr");
-                        }
-                        else {
-                            throw;
-                        }
-                    }
-                }
+                update_nsset_exception.add_already_set_dns_host(fqdn);
+            }
+            for (const auto& ipaddr : add_dns_hosts_result.invalid_dns_host_ipaddrs)
+            {
+                update_nsset_exception.add_invalid_dns_host_ipaddr(ipaddr);
             }
         }
 
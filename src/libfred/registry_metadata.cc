@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  snapshot of registry metadata (enum tables)
+ */
+
+#include "libfred/registry_metadata.hh"
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+namespace LibFred {
+
+namespace {
+
+std::atomic<unsigned long long> last_registry_metadata_version{0};
+
+std::shared_ptr<const RegistryMetadata>& get_registry_metadata_snapshot()
+{
+    static std::shared_ptr<const RegistryMetadata> snapshot;
+    return snapshot;
+}
+
+}//namespace LibFred::{anonymous}
+
+bool RegistryMetadata::ObjectState::is_applicable_to(unsigned long long object_type_id) const
+{
+    return std::binary_search(object_type_ids.begin(), object_type_ids.end(), object_type_id);
+}
+
+RegistryMetadata::RegistryMetadata()
+    : version_(++last_registry_metadata_version)
+{ }
+
+std::shared_ptr<const RegistryMetadata> RegistryMetadata::load(const OperationContext& ctx)
+{
+    std::shared_ptr<RegistryMetadata> metadata(new RegistryMetadata());
+    {
+        const Database::Result dbres = ctx.get_conn().exec("SELECT name, id FROM enum_object_type");
+        for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+        {
+            metadata->object_type_ids_.emplace(
+                    static_cast<std::string>(dbres[idx][0]),
+                    static_cast<unsigned long long>(dbres[idx][1]));
+        }
+    }
+    {
+        const Database::Result dbres = ctx.get_conn().exec(
+                "SELECT eos.id, eos.name, eos.manual, eos.external, t.type "
+                "FROM enum_object_states eos "
+                "LEFT JOIN LATERAL UNNEST(eos.types) AS t(type) ON TRUE "
+                "ORDER BY eos.id, t.type");
+        for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+        {
+            const auto state_id = static_cast<unsigned long long>(dbres[idx][0]);
+            if (metadata->object_states_.empty() || (metadata->object_states_.back().id != state_id))
+            {
+                ObjectState state;
+                state.id = state_id;
+                state.name = static_cast<std::string>(dbres[idx][1]);
+                state.manual = static_cast<bool>(dbres[idx][2]);
+                state.external = static_cast<bool>(dbres[idx][3]);
+                metadata->object_state_idx_by_name_.emplace(state.name, metadata->object_states_.size());
+                metadata->object_states_.push_back(std::move(state));
+            }
+            if (!dbres[idx][4].isnull())
+            {
+                metadata->object_states_.back().object_type_ids.push_back(static_cast<unsigned long long>(dbres[idx][4]));
+            }
+        }
+    }
+    {
+        const Database::Result dbres = ctx.get_conn().exec(
+                "SELECT UPPER(lang), state_id, description "
+                "FROM enum_object_states_desc "
+                "ORDER BY state_id");
+        for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+        {
+            ObjectStateDescription description;
+            description.state_id = static_cast<unsigned long long>(dbres[idx][1]);
+            description.description = static_cast<std::string>(dbres[idx][2]);
+            metadata->object_state_descriptions_[static_cast<std::string>(dbres[idx][0])].push_back(std::move(description));
+        }
+    }
+    {
+        const Database::Result dbres = ctx.get_conn().exec("SELECT name, id FROM messagetype");
+        for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+        {
+            metadata->message_type_ids_.emplace(
+                    static_cast<std::string>(dbres[idx][0]),
+                    static_cast<unsigned long long>(dbres[idx][1]));
+        }
+    }
+    {
+        const Database::Result dbres = ctx.get_conn().exec("SELECT name, val FROM enum_parameters WHERE val IS NOT NULL");
+        for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+        {
+            metadata->parameters_.emplace(
+                    static_cast<std::string>(dbres[idx][0]),
+                    static_cast<std::string>(dbres[idx][1]));
+        }
+    }
+    return metadata;
+}
+
+unsigned long long RegistryMetadata::get_version() const
+{
+    return version_;
+}
+
+unsigned long long RegistryMetadata::get_object_type_id(const std::string& object_type) const
+{
+    const auto object_type_id = this->find_object_type_id(object_type);
+    if (object_type_id == boost::none)
+    {
+        BOOST_THROW_EXCEPTION(InternalError("failed to get object type"));
+    }
+    return *object_type_id;
+}
+
+unsigned long long RegistryMetadata::get_object_type_id(Object_Type::Enum object_type) const
+{
+    return this->get_object_type_id(Conversion::Enums::to_db_handle(object_type));
+}
+
+boost::optional<unsigned long long> RegistryMetadata::find_object_type_id(const std::string& object_type) const
+{
+    const auto object_type_itr = object_type_ids_.find(object_type);
+    if (object_type_itr == object_type_ids_.end())
+    {
+        return boost::none;
+    }
+    return object_type_itr->second;
+}
+
+const std::vector<RegistryMetadata::ObjectState>& RegistryMetadata::get_object_states() const
+{
+    return object_states_;
+}
+
+const RegistryMetadata::ObjectState* RegistryMetadata::find_object_state(const std::string& name) const
+{
+    const auto state_idx_itr = object_state_idx_by_name_.find(name);
+    if (state_idx_itr == object_state_idx_by_name_.end())
+    {
+        return nullptr;
+    }
+    return &object_states_[state_idx_itr->second];
+}
+
+const RegistryMetadata::ObjectState* RegistryMetadata::find_object_state(unsigned long long state_id) const
+{
+    const auto state_itr = std::lower_bound(
+            object_states_.begin(),
+            object_states_.end(),
+            state_id,
+            [](const ObjectState& state, unsigned long long id) { return state.id < id; });
+    if ((state_itr == object_states_.end()) || (state_itr->id != state_id))
+    {
+        return nullptr;
+    }
+    return &*state_itr;
+}
+
+const std::vector<RegistryMetadata::ObjectStateDescription>& RegistryMetadata::get_object_state_descriptions(
+        const std::string& lang) const
+{
+    static const std::vector<ObjectStateDescription> no_descriptions;
+    const auto descriptions_itr = object_state_descriptions_.find(boost::algorithm::to_upper_copy(lang));
+    if (descriptions_itr == object_state_descriptions_.end())
+    {
+        return no_descriptions;
+    }
+    return descriptions_itr->second;
+}
+
+unsigned long long RegistryMetadata::get_message_type_id(Poll::MessageType::Enum message_type) const
+{
+    const auto message_type_itr = message_type_ids_.find(Conversion::Enums::to_db_handle(message_type));
+    if (message_type_itr == message_type_ids_.end())
+    {
+        BOOST_THROW_EXCEPTION(InternalError("failed to get message type"));
+    }
+    return message_type_itr->second;
+}
+
+boost::optional<std::string> RegistryMetadata::find_parameter(const std::string& name) const
+{
+    const auto parameter_itr = parameters_.find(name);
+    if (parameter_itr == parameters_.end())
+    {
+        return boost::none;
+    }
+    return parameter_itr->second;
+}
+
+std::shared_ptr<const RegistryMetadata> get_registry_metadata(const OperationContext& ctx)
+{
+    auto snapshot = std::atomic_load(&get_registry_metadata_snapshot());
+    if (snapshot != nullptr)
+    {
+        return snapshot;
+    }
+    return refresh_registry_metadata(ctx);
+}
+
+std::shared_ptr<const RegistryMetadata> refresh_registry_metadata(const OperationContext& ctx)
+{
+    auto snapshot = RegistryMetadata::load(ctx);
+    std::atomic_store(&get_registry_metadata_snapshot(), snapshot);
+    return snapshot;
+}
+
+void invalidate_registry_metadata()
+{
+    std::atomic_store(&get_registry_metadata_snapshot(), std::shared_ptr<const RegistryMetadata>());
+}
+
+}//namespace LibFred
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  snapshot of registry metadata (enum tables)
+ */
+
+#ifndef REGISTRY_METADATA_HH_0F5C7A92D3E64B1B9A8E4D26C13F7B58
+#define REGISTRY_METADATA_HH_0F5C7A92D3E64B1B9A8E4D26C13F7B58
+
+#include "libfred/opexception.hh"
+#include "libfred/opcontext.hh"
+#include "libfred/object/object_type.hh"
+#include "libfred/poll/message_type.hh"
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace LibFred {
+
+/**
+ * Immutable snapshot of registry enum tables: enum_object_type, enum_object_states, enum_object_states_desc,
+ * messagetype and enum_parameters.
+ * Operations use it for binding numeric ids as query parameters instead of resolving names in the database.
+ */
+class RegistryMetadata
+{
+public:
+    struct ObjectState
+    {
+        unsigned long long id;
+        std::string name;
+        std::vector<unsigned long long> object_type_ids;/**< sorted ids of object types the state is applicable to */
+        bool manual;
+        bool external;
+        bool is_applicable_to(unsigned long long object_type_id) const;
+    };
+    struct ObjectStateDescription
+    {
+        unsigned long long state_id;
+        std::string description;
+    };
+
+    /**
+     * Loads the snapshot from the database.
+     * @param ctx contains reference to database and logging interface
+     * @return new snapshot with new (unique in the process) version
+     */
+    static std::shared_ptr<const RegistryMetadata> load(const OperationContext& ctx);
+
+    /**
+     * @return version of the snapshot, the greater the later loaded
+     */
+    unsigned long long get_version() const;
+
+    /**
+     * @throw InternalError if object type does not exist
+     */
+    unsigned long long get_object_type_id(const std::string& object_type) const;
+    unsigned long long get_object_type_id(Object_Type::Enum object_type) const;
+    boost::optional<unsigned long long> find_object_type_id(const std::string& object_type) const;
+
+    /**
+     * @return all object states ordered by id
+     */
+    const std::vector<ObjectState>& get_object_states() const;
+    /**
+     * @return object state of given name or nullptr if does not exist
+     */
+    const ObjectState* find_object_state(const std::string& name) const;
+    /**
+     * @return object state of given id or nullptr if does not exist
+     */
+    const ObjectState* find_object_state(unsigned long long state_id) const;
+    /**
+     * @param lang language of descriptions (case insensitive) like 'EN' or 'CS'
+     * @return object state descriptions in given language ordered by state id
+     */
+    const std::vector<ObjectStateDescription>& get_object_state_descriptions(const std::string& lang) const;
+
+    /**
+     * @throw InternalError if message type does not exist
+     */
+    unsigned long long get_message_type_id(Poll::MessageType::Enum message_type) const;
+
+    /**
+     * @return value of enum_parameters item of given name or none if does not exist
+     */
+    boost::optional<std::string> find_parameter(const std::string& name) const;
+private:
+    RegistryMetadata();
+    unsigned long long version_;
+    std::unordered_map<std::string, unsigned long long> object_type_ids_;
+    std::vector<ObjectState> object_states_;
+    std::unordered_map<std::string, std::size_t> object_state_idx_by_name_;
+    std::map<std::string, std::vector<ObjectStateDescription>> object_state_descriptions_;
+    std::unordered_map<std::string, unsigned long long> message_type_ids_;
+    std::unordered_map<std::string, std::string> parameters_;
+};
+
+/**
+ * Gets process-wide registry metadata snapshot, loads it on the first use.
+ * Reading of already loaded snapshot doesn't lock anything.
+ * @param ctx contains reference to database and logging interface
+ */
+std::shared_ptr<const RegistryMetadata> get_registry_metadata(const OperationContext& ctx);
+
+/**
+ * Loads new process-wide registry metadata snapshot, snapshots obtained earlier stay valid.
+ * @param ctx contains reference to database and logging interface
+ */
+std::shared_ptr<const RegistryMetadata> refresh_registry_metadata(const OperationContext& ctx);
+
+/**
+ * Drops process-wide registry metadata snapshot, the next @ref get_registry_metadata call loads a new one.
+ */
+void invalidate_registry_metadata();
+
+}//namespace LibFred
+
+#endif
@@ -19,6 +19,7 @@
 #include "libfred/zone/create_zone.hh"
 #include "libfred/zone/exceptions.hh"
 #include "libfred/zone/util.hh"
+#include "libfred/zone/zone.hh"
 
 namespace LibFred {
 namespace Zone {
@@ -80,6 +81,7 @@ unsigned long long CreateZone::exec(const OperationContext& _ctx) const
         if (create_result.size() == 1)
         {
             const unsigned long long id = static_cast<unsigned long long>(create_result[0][0]);
+            invalidate_zone_index();
             return id;
         }
     }
@@ -19,6 +19,7 @@
 #include "libfred/zone/exceptions.hh"
 #include "libfred/zone/update_zone.hh"
 #include "libfred/zone/util.hh"
+#include "libfred/zone/zone.hh"
 #include "util/db/query_param.hh"
 #include "util/util.hh"
 
@@ -115,6 +116,7 @@ unsigned long long UpdateZone::exec(const OperationContext& _ctx) const
         if (update_result.size() == 1)
         {
             const unsigned long long id = static_cast<unsigned long long>(update_result[0][0]);
+            invalidate_zone_index();
             return id;
         }
         else if (update_result.size() < 1)
@@ -24,10 +24,187 @@
 
 #include "libfred/zone/zone.hh"
 
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/optional.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
 
 namespace LibFred {
 namespace Zone {
 
+    namespace {
+
+    Data make_zone_data(const Database::Row& row)
+    {
+        return Data(static_cast<unsigned long long>(row[0])// zone.id
+            , static_cast<bool>(row[1])//is_enum_zone
+            , static_cast<std::string>(row[2])//zone_name
+            , static_cast<unsigned>(row[3])//dots_max
+            , static_cast<unsigned>(row[4])//ex_period_min
+            , static_cast<unsigned>(row[5])//ex_period_max
+            , static_cast<unsigned>(row[6])//val_period
+            );
+    }
+
+    constexpr char label_separator = '.';//viz rfc1035
+
+    ///zones organized into trie of reversed labels ("e164.arpa" is stored as "arpa" -> "e164")
+    class ZoneSuffixIndex
+    {
+    public:
+        ZoneSuffixIndex(const Database::Result& zones, std::chrono::steady_clock::time_point loaded_at)
+            : loaded_at_(loaded_at)
+        {
+            for (Database::Result::size_type idx = 0; idx < zones.size(); ++idx)
+            {
+                insert(make_zone_data(zones[idx]));
+            }
+        }
+        ///find the longest zone which is a proper suffix of lower case fqdn without root dot
+        const Data* find(const std::string& domain) const
+        {
+            const Data* longest_match = nullptr;
+            const Node* node = &root_;
+            std::string::size_type label_end = domain.size();
+            while (0 < label_end)
+            {
+                const auto separator_pos = domain.rfind(label_separator, label_end - 1);
+                //the leftmost label of domain can not be a part of its zone
+                if ((separator_pos == std::string::npos) || (separator_pos == 0))
+                {
+                    break;
+                }
+                const auto child_itr = node->children.find(domain.substr(separator_pos + 1, label_end - separator_pos - 1));
+                if (child_itr == node->children.end())
+                {
+                    break;
+                }
+                node = child_itr->second.get();
+                if (node->zone != boost::none)
+                {
+                    longest_match = node->zone.get_ptr();
+                }
+                label_end = separator_pos;
+            }
+            return longest_match;
+        }
+        bool is_loaded_before(std::chrono::steady_clock::time_point time) const
+        {
+            return loaded_at_ < time;
+        }
+        bool is_expired(std::chrono::steady_clock::time_point now) const
+        {
+            return (loaded_at_ + zone_index_ttl) <= now;
+        }
+    private:
+        struct Node
+        {
+            std::map<std::string, std::unique_ptr<Node>> children;
+            boost::optional<Data> zone;
+        };
+        void insert(Data zone)
+        {
+            Node* node = &root_;
+            std::string::size_type label_end = zone.name.size();
+            while (true)
+            {
+                const auto separator_pos = label_end == 0 ? std::string::npos : zone.name.rfind(label_separator, label_end - 1);
+                const auto label_begin = separator_pos == std::string::npos ? 0 : separator_pos + 1;
+                auto& child = node->children[zone.name.substr(label_begin, label_end - label_begin)];
+                if (child == nullptr)
+                {
+                    child.reset(new Node());
+                }
+                node = child.get();
+                if (separator_pos == std::string::npos)
+                {
+                    break;
+                }
+                label_end = separator_pos;
+            }
+            node->zone = std::move(zone);
+        }
+        Node root_;
+        std::chrono::steady_clock::time_point loaded_at_;
+    };
+
+    class ZoneIndexCache
+    {
+    public:
+        static ZoneIndexCache& get_instance()
+        {
+            static ZoneIndexCache instance;
+            return instance;
+        }
+
+        std::shared_ptr<const ZoneSuffixIndex> get(const OperationContext& ctx, bool reload)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            unsigned long long generation;
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                if (!reload && (index_ != nullptr) && !index_->is_expired(now))
+                {
+                    return index_;
+                }
+                generation = generation_;
+            }
+            //database is queried without lock
+            const Database::Result available_zones_res = ctx.get_conn().exec(
+                    "SELECT id, enum_zone, fqdn, dots_max, ex_period_min, ex_period_max, val_period FROM zone");
+            if (available_zones_res.size() == 0)
+            {
+                BOOST_THROW_EXCEPTION(InternalError("missing zone configuration"));
+            }
+            auto index = std::make_shared<const ZoneSuffixIndex>(available_zones_res, now);
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                //do not store zones which may have been read before invalidation
+                if (generation == generation_)
+                {
+                    index_ = index;
+                }
+            }
+            return index;
+        }
+
+        void invalidate()
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            index_.reset();
+            ++generation_;
+        }
+    private:
+        ZoneIndexCache() : generation_{0} { }
+        std::mutex mutex_;
+        std::shared_ptr<const ZoneSuffixIndex> index_;
+        unsigned long long generation_;
+    };
+
+    Data find_zone_in_index(const OperationContext& ctx, const std::string& no_root_dot_fqdn)
+    {
+        const std::string domain = boost::to_lower_copy(no_root_dot_fqdn);
+        const auto lookup_start = std::chrono::steady_clock::now();
+        auto index = ZoneIndexCache::get_instance().get(ctx, false);
+        const Data* zone = index->find(domain);
+        //zone may have been created since the index was loaded
+        if ((zone == nullptr) && index->is_loaded_before(lookup_start))
+        {
+            index = ZoneIndexCache::get_instance().get(ctx, true);
+            zone = index->find(domain);
+        }
+        if (zone == nullptr)
+        {
+            BOOST_THROW_EXCEPTION(Exception().set_unknown_zone_in_fqdn(no_root_dot_fqdn));
+        }
+        return *zone;
+    }
+
+    }//namespace LibFred::Zone::{anonymous}
+
     std::string rem_trailing_dot(const std::string& fqdn)
     {
         if (!fqdn.empty() && fqdn.at(fqdn.size()-1) == '.') return fqdn.substr(0, fqdn.size()-1);
@@ -43,14 +220,7 @@ namespace Zone {
 
         if (zone_res.size() == 1)
         {
-            return Data(static_cast<unsigned long long>(zone_res[0][0])// zone.id
-                , static_cast<bool>(zone_res[0][1])//is_enum_zone
-                , static_cast<std::string>(zone_res[0][2])//zone_name
-                , static_cast<unsigned>(zone_res[0][3])//dots_max
-                , static_cast<unsigned>(zone_res[0][4])//ex_period_min
-                , static_cast<unsigned>(zone_res[0][5])//ex_period_max
-                , static_cast<unsigned>(zone_res[0][6])//val_period
-                );
+            return make_zone_data(zone_res[0]);
         }
         throw std::runtime_error("not found");
     }
@@ -60,40 +230,30 @@ namespace Zone {
     {
         try
         {
-            const std::string label_separator(".");//viz rfc1035
-
-            std::string domain(boost::to_lower_copy(no_root_dot_fqdn));
-
-            const Database::Result available_zones_res = ctx.get_conn().exec(
-                "SELECT fqdn FROM zone ORDER BY length(fqdn) DESC");
-
-            if (available_zones_res.size() == 0)
+            const Data zone = find_zone_in_index(ctx, no_root_dot_fqdn);
+            try
             {
-                BOOST_THROW_EXCEPTION(InternalError("missing zone configuration"));
+                return get_zone(ctx, zone.name);
             }
-
-            for (Database::Result::size_type i = 0 ; i < available_zones_res.size(); ++i)
+            catch (const std::exception& ex)
             {
-                std::string zone  = static_cast<std::string>(available_zones_res[i][0]);
-                std::string dot_zone  = label_separator + zone;
-                int from = domain.length() - dot_zone.length();
-                if (from >= 1)
-                {
-                    if (domain.find(dot_zone, from) != std::string::npos)
-                    {
-                        try
-                        {
-                            return get_zone(ctx, zone);
-                        }
-                        catch (const std::exception& ex)
-                        {
-                            BOOST_THROW_EXCEPTION(Exception().set_unknown_zone_in_fqdn(no_root_dot_fqdn));
-                        }
-                    }
-                }
-            }//for available_zones_res
+                //zone removed since the index was loaded
+                invalidate_zone_index();
+                BOOST_THROW_EXCEPTION(Exception().set_unknown_zone_in_fqdn(no_root_dot_fqdn));
+            }
+        }
+        catch (ExceptionStack& ex)
+        {
+            ex.add_exception_stack_info(std::string("fqdn: ")+no_root_dot_fqdn);
+            throw;
+        }
+    }
 
-            BOOST_THROW_EXCEPTION(Exception().set_unknown_zone_in_fqdn(no_root_dot_fqdn));
+    Data find_zone_in_fqdn_cached(const OperationContext& ctx, const std::string& no_root_dot_fqdn)
+    {
+        try
+        {
+            return find_zone_in_index(ctx, no_root_dot_fqdn);
         }
         catch (ExceptionStack& ex)
         {
@@ -102,6 +262,10 @@ namespace Zone {
         }
     }
 
+    void invalidate_zone_index()
+    {
+        ZoneIndexCache::get_instance().invalidate();
+    }
+
 } // namespace Zone
 } // namespace LibFred
-
@@ -24,6 +24,7 @@
 #ifndef ZONE_HH_D056E14F955D424794E54083116DA917
 #define ZONE_HH_D056E14F955D424794E54083116DA917
 
+#include <chrono>
 #include <string>
 
 #include "libfred/opexception.hh"
@@ -65,8 +66,17 @@ namespace Zone {
     , ExceptionData_unknown_zone_in_fqdn<Exception>
     {};
 
-    ///look for zone in domain name and return zone data
+    ///look for zone in domain name, lock zone for share and return zone data
     Data find_zone_in_fqdn(const OperationContext& ctx, const std::string& fqdn);
+    /**
+     * Look for zone in domain name using process-wide zone index, no database lock is taken.
+     * Zone data may be up to @ref zone_index_ttl old unless @ref invalidate_zone_index is called.
+     */
+    Data find_zone_in_fqdn_cached(const OperationContext& ctx, const std::string& fqdn);
+    ///drop process-wide zone index, it is reloaded from database by the next lookup
+    void invalidate_zone_index();
+    ///maximal age of process-wide zone index
+    constexpr std::chrono::seconds zone_index_ttl{60};
     ///lock zone for share and get zone data
     Data get_zone(const OperationContext& ctx, const std::string& zone_name);
 
@@ -21,10 +21,185 @@
 #include "src/libfred/opcontext.hh"
 #include "util/db/query_param.hh"
 
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 
 namespace Util {
 
+namespace {
+
+//lower case letters first..last (every step-th one) have upper case counterpart at code point + delta
+struct CaseMappingRange
+{
+    char32_t first;
+    char32_t last;
+    int delta;
+    unsigned step;
+};
+
+//sorted by code points, ranges do not overlap
+constexpr CaseMappingRange upper_case_mapping[] =
+{
+    { 0x0061, 0x007a, -32, 1 },//Basic Latin
+    { 0x00b5, 0x00b5, 0x039c - 0x00b5, 1 },//micro sign
+    { 0x00e0, 0x00f6, -32, 1 },//Latin-1 Supplement
+    { 0x00f8, 0x00fe, -32, 1 },
+    { 0x00ff, 0x00ff, 0x0178 - 0x00ff, 1 },
+    { 0x0101, 0x012f, -1, 2 },//Latin Extended-A
+    { 0x0131, 0x0131, 0x0049 - 0x0131, 1 },//dotless i
+    { 0x0133, 0x0137, -1, 2 },
+    { 0x013a, 0x0148, -1, 2 },
+    { 0x014b, 0x0177, -1, 2 },
+    { 0x017a, 0x017e, -1, 2 },
+    { 0x017f, 0x017f, 0x0053 - 0x017f, 1 },//long s
+    { 0x01c5, 0x01c5, 0x01c4 - 0x01c5, 1 },//Latin Extended-B, digraphs map to their upper case form
+    { 0x01c6, 0x01c6, 0x01c4 - 0x01c6, 1 },
+    { 0x01c8, 0x01c8, 0x01c7 - 0x01c8, 1 },
+    { 0x01c9, 0x01c9, 0x01c7 - 0x01c9, 1 },
+    { 0x01cb, 0x01cb, 0x01ca - 0x01cb, 1 },
+    { 0x01cc, 0x01cc, 0x01ca - 0x01cc, 1 },
+    { 0x01ce, 0x01dc, -1, 2 },
+    { 0x01df, 0x01ef, -1, 2 },
+    { 0x01f2, 0x01f2, 0x01f1 - 0x01f2, 1 },
+    { 0x01f3, 0x01f3, 0x01f1 - 0x01f3, 1 },
+    { 0x01f5, 0x01f5, -1, 1 },
+    { 0x01f9, 0x021f, -1, 2 },
+    { 0x0223, 0x0233, -1, 2 },
+    { 0x03ac, 0x03ac, 0x0386 - 0x03ac, 1 },//Greek
+    { 0x03ad, 0x03af, 0x0388 - 0x03ad, 1 },
+    { 0x03b1, 0x03c1, -32, 1 },
+    { 0x03c2, 0x03c2, 0x03a3 - 0x03c2, 1 },//final sigma
+    { 0x03c3, 0x03cb, -32, 1 },
+    { 0x03cc, 0x03cc, 0x038c - 0x03cc, 1 },
+    { 0x03cd, 0x03ce, 0x038e - 0x03cd, 1 },
+    { 0x0430, 0x044f, -32, 1 },//Cyrillic
+    { 0x0450, 0x045f, -80, 1 },
+    { 0x0461, 0x0481, -1, 2 },
+    { 0x048b, 0x04bf, -1, 2 },
+    { 0x04c2, 0x04ce, -1, 2 },
+    { 0x04cf, 0x04cf, 0x04c0 - 0x04cf, 1 },
+    { 0x04d1, 0x052f, -1, 2 },
+    { 0x0561, 0x0586, -48, 1 },//Armenian
+    { 0x1e01, 0x1e95, -1, 2 },//Latin Extended Additional
+    { 0x1ea1, 0x1eff, -1, 2 },
+    { 0x2170, 0x217f, -16, 1 },//small roman numerals
+    { 0x24d0, 0x24e9, -26, 1 },//circled latin small letters
+    { 0xff41, 0xff5a, -32, 1 }//fullwidth latin small letters
+};
+
+char32_t to_upper_case(char32_t code_point)
+{
+    const auto range_itr = std::lower_bound(
+            std::begin(upper_case_mapping),
+            std::end(upper_case_mapping),
+            code_point,
+            [](const CaseMappingRange& range, char32_t value) { return range.last < value; });
+    if ((range_itr != std::end(upper_case_mapping)) &&
+        (range_itr->first <= code_point) &&
+        (((code_point - range_itr->first) % range_itr->step) == 0))
+    {
+        return code_point + range_itr->delta;
+    }
+    return code_point;
+}
+
+//bytes of invalid UTF-8 sequences are distinguished from valid code points by this flag
+constexpr char32_t invalid_byte_flag = 0x80000000;
+
+//sequence of upper case code points of UTF-8 string, no allocation needed
+class UpperCaseCodePoints
+{
+public:
+    explicit UpperCaseCodePoints(const std::string& utf8_str)
+        : pos_(reinterpret_cast<const unsigned char*>(utf8_str.data())),
+          end_(pos_ + utf8_str.size())
+    { }
+    bool at_end()const
+    {
+        return pos_ == end_;
+    }
+    char32_t next()
+    {
+        const unsigned char lead_byte = *pos_;
+        if (lead_byte < 0x80)
+        {
+            ++pos_;
+            return to_upper_case(static_cast<char32_t>(lead_byte));
+        }
+        const int number_of_continuation_bytes = (0xc2 <= lead_byte) && (lead_byte <= 0xdf) ? 1
+                                               : (0xe0 <= lead_byte) && (lead_byte <= 0xef) ? 2
+                                               : (0xf0 <= lead_byte) && (lead_byte <= 0xf4) ? 3
+                                               : 0;
+        if ((number_of_continuation_bytes == 0) ||
+            ((end_ - pos_) <= number_of_continuation_bytes))
+        {
+            ++pos_;
+            return invalid_byte_flag | lead_byte;
+        }
+        char32_t code_point = lead_byte & (0x3f >> number_of_continuation_bytes);
+        for (int idx = 1; idx <= number_of_continuation_bytes; ++idx)
+        {
+            const unsigned char continuation_byte = pos_[idx];
+            if ((continuation_byte & 0xc0) != 0x80)
+            {
+                ++pos_;
+                return invalid_byte_flag | lead_byte;
+            }
+            code_point = (code_point << 6) | (continuation_byte & 0x3f);
+        }
+        pos_ += 1 + number_of_continuation_bytes;
+        return to_upper_case(code_point);
+    }
+private:
+    const unsigned char* pos_;
+    const unsigned char* end_;
+};
+
+void append_utf8(std::string& dst, char32_t code_point)
+{
+    if ((code_point & invalid_byte_flag) != 0)
+    {
+        dst.push_back(static_cast<char>(code_point & 0xff));
+    }
+    else if (code_point < 0x80)
+    {
+        dst.push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800)
+    {
+        dst.push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+        dst.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    }
+    else if (code_point < 0x10000)
+    {
+        dst.push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+        dst.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+        dst.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    }
+    else
+    {
+        dst.push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+        dst.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+        dst.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+        dst.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    }
+}
+
+}//namespace Util::{anonymous}
+
+std::string to_upper_case(const std::string& utf8_str)
+{
+    std::string result;
+    result.reserve(utf8_str.size());
+    UpperCaseCodePoints code_points(utf8_str);
+    while (!code_points.at_end())
+    {
+        append_utf8(result, code_points.next());
+    }
+    return result;
+}
+
 template <typename T>
 CaseInsensitiveEqualTo<T>::CaseInsensitiveEqualTo(CaseInsensitiveEqualTo&& src)
     : db_conn_(std::move(src).db_conn_)
@@ -46,7 +221,16 @@ bool CaseInsensitiveEqualTo<T>::operator()(const std::string& lhs, const std::st
 
 bool CaseInsensitiveEqualTo<void>::operator()(const std::string& lhs, const std::string& rhs)const
 {
-    return case_insensitive_equal_to(LibFred::OperationContextCreator().get_conn())(lhs, rhs);
+    UpperCaseCodePoints lhs_code_points(lhs);
+    UpperCaseCodePoints rhs_code_points(rhs);
+    while (!lhs_code_points.at_end() && !rhs_code_points.at_end())
+    {
+        if (lhs_code_points.next() != rhs_code_points.next())
+        {
+            return false;
+        }
+    }
+    return lhs_code_points.at_end() && rhs_code_points.at_end();
 }
 
 CaseInsensitiveEqualTo<void> case_insensitive_equal_to()
@@ -54,6 +238,35 @@ CaseInsensitiveEqualTo<void> case_insensitive_equal_to()
     return CaseInsensitiveEqualTo<void>();
 }
 
+bool CaseInsensitiveLess::operator()(const std::string& lhs, const std::string& rhs)const
+{
+    UpperCaseCodePoints lhs_code_points(lhs);
+    UpperCaseCodePoints rhs_code_points(rhs);
+    while (!lhs_code_points.at_end() && !rhs_code_points.at_end())
+    {
+        const char32_t lhs_code_point = lhs_code_points.next();
+        const char32_t rhs_code_point = rhs_code_points.next();
+        if (lhs_code_point != rhs_code_point)
+        {
+            return lhs_code_point < rhs_code_point;
+        }
+    }
+    return lhs_code_points.at_end() && !rhs_code_points.at_end();
+}
+
+std::size_t CaseInsensitiveHash::operator()(const std::string& str)const
+{
+    //FNV-1a
+    std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+    UpperCaseCodePoints code_points(str);
+    while (!code_points.at_end())
+    {
+        hash ^= static_cast<std::size_t>(code_points.next());
+        hash *= static_cast<std::size_t>(1099511628211ULL);
+    }
+    return hash;
+}
+
 template class CaseInsensitiveEqualTo<std::remove_reference_t<decltype(LibFred::OperationContextCreator().get_conn())>>;
 
 }//namespace Util
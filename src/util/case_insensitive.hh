@@ -20,12 +20,25 @@
 #ifndef CASE_INSENSITIVE_HH_151611729A3F42461E1C9D28A6F1A398//date "+%s.%N"|md5sum|tr "[a-f]" "[A-F]"
 #define CASE_INSENSITIVE_HH_151611729A3F42461E1C9D28A6F1A398
 
+#include <cstddef>
 #include <string>
 #include <type_traits>
 #include <utility>
 
 namespace Util {
 
+/**
+ * Converts UTF-8 string to upper case by simple (one to one) Unicode case mapping like UPPER() of database
+ * with UTF-8 encoding does; Latin, Greek, Cyrillic and Armenian letters are covered, other characters and
+ * invalid UTF-8 sequences are kept unchanged.
+ */
+std::string to_upper_case(const std::string& utf8_str);
+
+/**
+ * Comparison of strings by database UPPER() function, one query per comparison.
+ * It is meant for verification of the local comparison provided by case_insensitive_equal_to().
+ */
+
 template <typename T>
 auto case_insensitive_equal_to(T&&);
 
@@ -52,6 +65,7 @@ auto case_insensitive_equal_to(T&& db_conn)
     return CaseInsensitiveEqualTo<std::remove_reference_t<T>>(std::forward<T>(db_conn));
 }
 
+///local comparison of UTF-8 strings, equal strings have equal results of to_upper_case()
 template <>
 class CaseInsensitiveEqualTo<void>
 {
@@ -61,6 +75,18 @@ public:
 
 CaseInsensitiveEqualTo<void> case_insensitive_equal_to();
 
+///ordering of UTF-8 strings consistent with CaseInsensitiveEqualTo<void>, usable as std::set/std::map comparator
+struct CaseInsensitiveLess
+{
+    bool operator()(const std::string& lhs, const std::string& rhs)const;
+};
+
+///hash of UTF-8 strings consistent with CaseInsensitiveEqualTo<void>, usable as std::unordered_map hasher
+struct CaseInsensitiveHash
+{
+    std::size_t operator()(const std::string& str)const;
+};
+
 }//namespace Util
 
 #endif//CASE_INSENSITIVE_HH_151611729A3F42461E1C9D28A6F1A398
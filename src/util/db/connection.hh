@@ -31,7 +31,12 @@
 #include "util/db/db_exceptions.hh"
 #include "util/db/query_param.hh"
 #include "util/db/param_query_composition.hh"
+#include "util/db/query_statistics.hh"
+#include "util/db/result.hh"
+#include "util/db/statement_cache.hh"
 
+#include <algorithm>
+#include <chrono>
 #include <istream>
 #include <string>
 #include <vector>
@@ -87,7 +92,7 @@ public:
 #ifdef HAVE_LOGGER
             FREDLOG_DEBUG(boost::format("exec query [%1%]") % _stmt);
 #endif
-            return result_type(this->get_opened_connection().exec(_stmt));
+            return this->instrumented_exec(_stmt, [&]() { return this->get_opened_connection().exec(_stmt); });
         }
         catch (const ResultFailed&)
         {
@@ -101,7 +106,8 @@ public:
 
     result_type exec_params(
             const std::string& _stmt, //one command query
-            const std::vector<std::string>& params)//parameters data
+            const std::vector<std::string>& params, //parameters data
+            StatementCaching caching = StatementCaching::enabled)
     {
         this->check_open();
         try
@@ -109,8 +115,12 @@ public:
 #ifdef HAVE_LOGGER
             FREDLOG_DEBUG(boost::format("exec query [%1%]") % _stmt);
 #endif
-            return result_type(this->get_opened_connection().exec_params(_stmt, //one command query
-                                                                         params));//parameters data
+            return this->instrumented_exec(_stmt, [&]()
+            {
+                return this->get_opened_connection().exec_params(_stmt, //one command query
+                                                                 params, //parameters data
+                                                                 caching);
+            });
         }
         catch (const ResultFailed&)
         {
@@ -123,7 +133,16 @@ public:
     }
 
     result_type exec_params(const std::string& _stmt, //one command query
-                            const QueryParams& params)//parameters data
+                            const QueryParams& params, //parameters data
+                            StatementCaching caching = StatementCaching::enabled)
+    {
+        return this->exec_params(_stmt, params, ResultFormat::text, caching);
+    }
+
+    result_type exec_params(const std::string& _stmt, //one command query
+                            const QueryParams& params, //parameters data
+                            ResultFormat result_format, //requested format of result fields
+                            StatementCaching caching = StatementCaching::enabled)
     {
         this->check_open();
         try
@@ -140,8 +159,13 @@ public:
             }
             FREDLOG_DEBUG(boost::format("exec query [%1%] params %2%") % _stmt % params_dump);
 #endif
-            return result_type(this->get_opened_connection().exec_params(_stmt, //one command query
-                                                                         params));//parameters data
+            return this->instrumented_exec(_stmt, [&]()
+            {
+                return this->get_opened_connection().exec_params(_stmt, //one command query
+                                                                 params, //parameters data
+                                                                 result_format,
+                                                                 caching);
+            });
         }
         catch (const ResultFailed&)
         {
@@ -156,12 +180,128 @@ public:
     /**
      * ParamQuery wrapper
      * @param _q composable query instance
+     * @param caching whether the query may be executed as server-side prepared statement
+     * @return result
+     */
+    result_type exec_params(const ParamQuery& param_query, StatementCaching caching = StatementCaching::enabled)
+    {
+        std::pair<std::string, QueryParams> param_query_pair = param_query.get_query();
+        return this->exec_params(param_query_pair.first, param_query_pair.second, caching);
+    }
+
+    /**
+     * ParamQuery wrapper
+     * @param _q composable query instance
+     * @param result_format requested format of result fields
+     * @param caching whether the query may be executed as server-side prepared statement
      * @return result
      */
-    result_type exec_params(const ParamQuery& param_query)
+    result_type exec_params(
+            const ParamQuery& param_query,
+            ResultFormat result_format,
+            StatementCaching caching = StatementCaching::enabled)
     {
         std::pair<std::string, QueryParams> param_query_pair = param_query.get_query();
-        return this->exec_params(param_query_pair.first, param_query_pair.second);
+        return this->exec_params(param_query_pair.first, param_query_pair.second, result_format, caching);
+    }
+
+    /**
+     * \class Pipeline
+     * \brief Batch of independent statements executed in one network round trip
+     *
+     * Statements must not depend on results of each other, they are executed in order of addition.
+     */
+    class Pipeline
+    {
+    public:
+        explicit Pipeline(Connection_& conn) : conn_(conn) { }
+
+        /**
+         * @return index of the statement result in the vector returned by exec()
+         */
+        std::size_t add(const std::string& _stmt, const QueryParams& params)
+        {
+            statements_.emplace_back(_stmt, params);
+            return statements_.size() - 1;
+        }
+
+        std::size_t add(const ParamQuery& param_query)
+        {
+            statements_.push_back(param_query.get_query());
+            return statements_.size() - 1;
+        }
+
+        std::size_t size()const
+        {
+            return statements_.size();
+        }
+
+        /**
+         * Executes all added statements
+         * @return results in order of addition
+         * @throw ResultFailed describing the first failed statement
+         *
+         * Query statistics get the round trip time split evenly among the statements,
+         * all of them are counted as failed if the batch fails.
+         */
+        std::vector<result_type> exec()
+        {
+            conn_.check_open();
+            try
+            {
+#ifdef HAVE_LOGGER
+                for (const auto& statement : statements_)
+                {
+                    FREDLOG_DEBUG(boost::format("pipeline query [%1%]") % statement.first);
+                }
+#endif
+                const auto start = std::chrono::steady_clock::now();
+                try
+                {
+                    const auto driver_results = conn_.get_opened_connection().exec_pipeline(statements_);
+                    std::vector<result_type> results(driver_results.begin(), driver_results.end());
+                    const auto duration = (std::chrono::steady_clock::now() - start) / std::max<std::size_t>(statements_.size(), 1);
+                    for (std::size_t idx = 0; idx < results.size(); ++idx)
+                    {
+                        record_query_execution(
+                                statements_[idx].first,
+                                duration,
+                                results[idx].size(),
+                                results[idx].rows_affected());
+                    }
+                    statements_.clear();
+                    return results;
+                }
+                catch (...)
+                {
+                    const auto duration = (std::chrono::steady_clock::now() - start) / std::max<std::size_t>(statements_.size(), 1);
+                    for (const auto& statement : statements_)
+                    {
+                        record_failed_query_execution(statement.first, duration);
+                    }
+                    throw;
+                }
+            }
+            catch (const ResultFailed&)
+            {
+                throw;
+            }
+            catch (...)
+            {
+                throw ResultFailed("pipeline");
+            }
+        }
+    private:
+        Connection_& conn_;
+        typename connection_driver::PipelineStatements statements_;
+    };
+
+    /**
+     * @return empty batch of statements to be executed in one round trip
+     */
+    Pipeline pipeline()
+    {
+        return Pipeline(*this);
     }
 
     result_type copy_from(std::istream& input_data, const std::string& table_name, std::size_t buffer_size=8192)
@@ -204,13 +344,26 @@ public:
     }
 
     /**
-     * Reset connection to state after connect
+     * Reset connection to state after connect, invalidates prepared statements
      */
     void reset()
     {
         this->get_opened_connection().reset();
     }
 
+    /**
+     * Set maximal number of server-side prepared statements, 0 disables statement caching
+     */
+    void set_statement_cache_capacity(std::size_t capacity)
+    {
+        this->get_opened_connection().set_statement_cache_capacity(capacity);
+    }
+
+    StatementCacheStatistics get_statement_cache_statistics()const
+    {
+        return this->get_opened_connection().get_statement_cache_statistics();
+    }
+
     void setQueryTimeout(unsigned t)
     {
         this->get_opened_connection().setQueryTimeout(t);
@@ -225,6 +378,22 @@ public:
         return dynamic_cast<T*>(conn_) != nullptr;
     }
 private:
+    template <typename Exec>
+    result_type instrumented_exec(const std::string& _stmt, Exec&& exec)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            result_type result(exec());
+            record_query_execution(_stmt, std::chrono::steady_clock::now() - start, result.size(), result.rows_affected());
+            return result;
+        }
+        catch (...)
+        {
+            record_failed_query_execution(_stmt, std::chrono::steady_clock::now() - start);
+            throw;
+        }
+    }
     void check_open()const
     {
         if (conn_ == nullptr)
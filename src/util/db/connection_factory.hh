@@ -33,8 +33,19 @@
 #include "util/log/log.hh"
 #endif
 
+#include "util/db/db_exceptions.hh"
+
 #include <boost/format.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
 namespace Database {
 namespace Factory {
 
@@ -93,6 +104,328 @@ private:
     typename connection_driver::OpenType need_to_open_;
 };
 
+/**
+ * \class  Pool
+ * \brief  Bounded thread-safe pool of connection_driver instances
+ *
+ * Released connections are kept open and handed out again by subsequent acquire() calls,
+ * so the connection handshake is paid only once per pooled connection.
+ * Connections idle longer than max_idle_time are closed (down to min_size connections),
+ * broken connections are reset or dropped.
+ */
+template <class T>
+class Pool
+{
+public:
+    using connection_driver = T;//PSQLConnection
+
+    struct Parameters
+    {
+        Parameters()
+            : min_size{0},
+              max_size{16},
+              max_idle_time{std::chrono::seconds{60}},
+              acquire_timeout{std::chrono::seconds{30}}
+        { }
+        std::size_t min_size;///< number of connections opened in advance and never evicted as idle
+        std::size_t max_size;///< upper bound of simultaneously opened connections
+        std::chrono::steady_clock::duration max_idle_time;///< idle connections above min_size are closed after this time
+        std::chrono::steady_clock::duration acquire_timeout;///< how long acquire() waits for a free connection
+    };
+
+    explicit Pool(const typename connection_driver::OpenType& need_to_open, const Parameters& parameters = Parameters{})
+        : impl_(std::make_shared<Impl>(need_to_open, parameters))
+    {
+#ifdef HAVE_LOGGER
+        FREDLOG_TRACE(boost::format("<CALL> Database::Factory::Pool::Pool('%1%', min_size=%2%, max_size=%3%)") %
+                  T::to_publicable_string(need_to_open) %
+                  parameters.min_size %
+                  parameters.max_size);
+#endif
+        impl_->fill_up_to_min_size();
+    }
+
+    ~Pool()
+    {
+#ifdef HAVE_LOGGER
+        FREDLOG_TRACE("<CALL> Database::Factory::Pool::~Pool()");
+#endif
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * Takes connection from pool, opens a new one if the pool is not exhausted
+     *
+     * @return  connection
+     * @throw ConnectionPoolExhausted if no connection becomes available within acquire_timeout
+     * @throw ConnectionFailed if a new connection can not be opened
+     */
+    connection_driver* acquire()const
+    {
+        connection_driver* const conn = impl_->acquire();
+        register_lease(conn, impl_);
+        return conn;
+    }
+
+    /**
+     * Returns connection into the pool it was acquired from, connections of foreign origin are deleted
+     *
+     * @param _conn  connection pointer
+     */
+    static void release(connection_driver*& _conn)
+    {
+        if (_conn == nullptr)
+        {
+            return;
+        }
+        const std::shared_ptr<Impl> owner = unregister_lease(_conn);
+        if (owner != nullptr)
+        {
+            owner->release(_conn);
+        }
+        else
+        {
+            delete _conn;
+        }
+        _conn = nullptr;
+    }
+
+    /**
+     * @return  number of opened connections (idle and acquired)
+     */
+    std::size_t size()const
+    {
+        return impl_->size();
+    }
+
+    /**
+     * @return  number of idle connections
+     */
+    std::size_t idle_size()const
+    {
+        return impl_->idle_size();
+    }
+private:
+    class Impl
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        Impl(const typename connection_driver::OpenType& need_to_open, const Parameters& parameters)
+            : need_to_open_(need_to_open),
+              parameters_(parameters),
+              opened_(0)
+        {
+            if ((parameters_.max_size == 0) || (parameters_.max_size < parameters_.min_size))
+            {
+                throw std::runtime_error("Invalid connection pool size limits");
+            }
+        }
+
+        ~Impl()
+        {
+            for (auto& item : idle_)
+            {
+                delete item.conn;
+            }
+        }
+
+        void fill_up_to_min_size()
+        {
+            while (this->size() < parameters_.min_size)
+            {
+                connection_driver* conn = this->acquire();
+                this->release(conn);
+            }
+        }
+
+        connection_driver* acquire()
+        {
+            const auto deadline = Clock::now() + parameters_.acquire_timeout;
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                this->evict_expired(lock);
+                if (!idle_.empty())
+                {
+                    connection_driver* const conn = idle_.back().conn;
+                    idle_.pop_back();
+                    lock.unlock();
+                    if (is_usable(conn))
+                    {
+                        return conn;
+                    }
+                    delete conn;
+                    lock.lock();
+                    --opened_;
+                    continue;
+                }
+                if (opened_ < parameters_.max_size)
+                {
+                    ++opened_;
+                    lock.unlock();
+                    try
+                    {
+                        return new connection_driver(need_to_open_);
+                    }
+                    catch (...)
+                    {
+                        lock.lock();
+                        --opened_;
+                        released_.notify_one();
+                        throw;
+                    }
+                }
+                if (released_.wait_until(lock, deadline) == std::cv_status::timeout)
+                {
+                    if (idle_.empty() && (parameters_.max_size <= opened_))
+                    {
+                        throw ConnectionPoolExhausted(parameters_.max_size);
+                    }
+                }
+            }
+        }
+
+        void release(connection_driver* conn)
+        {
+            const bool reusable = rollback_pending_transaction(conn) && conn->is_connection_ok();
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (reusable)
+            {
+                idle_.push_back(IdleConnection{conn, Clock::now()});
+            }
+            else
+            {
+                --opened_;
+            }
+            lock.unlock();
+            if (!reusable)
+            {
+                delete conn;
+            }
+            released_.notify_one();
+        }
+
+        std::size_t size()const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return opened_;
+        }
+
+        std::size_t idle_size()const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return idle_.size();
+        }
+    private:
+        struct IdleConnection
+        {
+            connection_driver* conn;
+            Clock::time_point released_at;
+        };
+
+        // the least recently used connections are at the front of idle_
+        void evict_expired(std::unique_lock<std::mutex>& lock)
+        {
+            const auto expired_before = Clock::now() - parameters_.max_idle_time;
+            std::deque<connection_driver*> expired;
+            while (!idle_.empty() &&
+                   (parameters_.min_size < opened_) &&
+                   (idle_.front().released_at < expired_before))
+            {
+                expired.push_back(idle_.front().conn);
+                idle_.pop_front();
+                --opened_;
+            }
+            if (!expired.empty())
+            {
+                lock.unlock();
+                for (auto* conn : expired)
+                {
+                    delete conn;
+                }
+                lock.lock();
+            }
+        }
+
+        static bool is_usable(connection_driver* conn)
+        {
+            if (conn->is_connection_ok())
+            {
+                return true;
+            }
+#ifdef HAVE_LOGGER
+            FREDLOG_WARNING("pooled connection is broken, try to reset it");
+#endif
+            conn->reset();
+            return conn->is_connection_ok();
+        }
+
+        static bool rollback_pending_transaction(connection_driver* conn)
+        {
+            if (!conn->is_in_transaction())
+            {
+                return true;
+            }
+            try
+            {
+                conn->exec("ROLLBACK");
+                return !conn->is_in_transaction();
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        const typename connection_driver::OpenType need_to_open_;
+        const Parameters parameters_;
+        mutable std::mutex mutex_;
+        std::condition_variable released_;
+        std::deque<IdleConnection> idle_;
+        std::size_t opened_;
+    };
+
+    // acquired connections remember the pool they belong to, release() is static
+    using Leases = std::unordered_map<const connection_driver*, std::weak_ptr<Impl>>;
+
+    static std::mutex& get_leases_mutex()
+    {
+        static std::mutex leases_mutex;
+        return leases_mutex;
+    }
+
+    static Leases& get_leases()
+    {
+        static Leases leases;
+        return leases;
+    }
+
+    static void register_lease(const connection_driver* conn, const std::shared_ptr<Impl>& owner)
+    {
+        std::lock_guard<std::mutex> lock(get_leases_mutex());
+        get_leases()[conn] = owner;
+    }
+
+    static std::shared_ptr<Impl> unregister_lease(const connection_driver* conn)
+    {
+        std::lock_guard<std::mutex> lock(get_leases_mutex());
+        auto& leases = get_leases();
+        const auto lease_itr = leases.find(conn);
+        if (lease_itr == leases.end())
+        {
+            return nullptr;
+        }
+        const std::shared_ptr<Impl> owner = lease_itr->second.lock();
+        leases.erase(lease_itr);
+        return owner;
+    }
+
+    std::shared_ptr<Impl> impl_;
+};
+
 }//namespace Database::Factory
 }//namespace Database
 
@@ -22,6 +22,7 @@
 #include "util/base_exception.hh"
 
 #include <sstream>
+#include <string>
 
 namespace Database {
 
@@ -37,6 +38,13 @@ public:
     ConnectionFailed(const std::string& _conn_info) : Exception("Connection failed: " + _conn_info) { }
 };
 
+class ConnectionPoolExhausted : public Database::Exception
+{
+public:
+    ConnectionPoolExhausted(std::size_t _max_size)
+        : Exception("Connection pool exhausted: all " + std::to_string(_max_size) + " connections in use") { }
+};
+
 class ResultFailed : public Database::Exception
 {
 public:
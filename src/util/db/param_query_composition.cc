@@ -185,6 +185,45 @@ namespace Database
         return param(val, "bool");
     }
 
+    ParamQuery& ParamQuery::param_bigint_array(const std::vector<unsigned long long>& values)
+    {
+        std::string array_literal = "{";
+        for (const auto value : values)
+        {
+            if (array_literal.size() > 1)
+            {
+                array_literal += ",";
+            }
+            array_literal += std::to_string(value);
+        }
+        array_literal += "}";
+        return param(array_literal, "bigint[]");
+    }
+
+    ParamQuery& ParamQuery::param_text_array(const std::vector<std::string>& values)
+    {
+        std::string array_literal = "{";
+        for (const auto& value : values)
+        {
+            if (array_literal.size() > 1)
+            {
+                array_literal += ",";
+            }
+            array_literal += "\"";
+            for (const char c : value)
+            {
+                if ((c == '"') || (c == '\\'))
+                {
+                    array_literal += '\\';
+                }
+                array_literal += c;
+            }
+            array_literal += "\"";
+        }
+        array_literal += "}";
+        return param(array_literal, "text[]");
+    }
+
 
     ParamQuery& ParamQuery::param(const Database::ReusableParameter& p)
     {
@@ -145,6 +145,18 @@ namespace Database
          */
         ParamQuery& param_bool(const Database::QueryParam& val);
 
+        /**
+         * Adds query parameter of postgresql type "bigint[]".
+         * Usable with "= ANY(...)" or "UNNEST(...)" to pass many values by one parameter.
+         */
+        ParamQuery& param_bigint_array(const std::vector<unsigned long long>& values);
+
+        /**
+         * Adds query parameter of postgresql type "text[]".
+         * Usable with "= ANY(...)" or "UNNEST(...)" to pass many values by one parameter.
+         */
+        ParamQuery& param_text_array(const std::vector<std::string>& values);
+
         /**
          * Adds independent query parameter instance.
          * The same independent query parameter instance can be added repeatedly.
@@ -30,11 +30,99 @@
 #include <boost/regex.hpp>
 
 #include <algorithm>
+#include <cstring>
 
 namespace Database {
 
+namespace {
+
+constexpr std::size_t default_statement_cache_capacity = 256;
+constexpr unsigned default_statement_prepare_threshold = 2;
+constexpr std::size_t no_statement_cache = 0;
+
+// the same query text may be prepared with different parameter types
+std::string make_statement_cache_key(const std::string& query, int params_count, const Oid* param_types)
+{
+    if (param_types == nullptr)
+    {
+        return query;
+    }
+    std::string key = query;
+    key += '\0';
+    for (int idx = 0; idx < params_count; ++idx)
+    {
+        key += std::to_string(param_types[idx]);
+        key += ',';
+    }
+    return key;
+}
+
+bool is_successful(const PGresult* result)
+{
+    const ExecStatusType status = PQresultStatus(result);
+    return (status == PGRES_COMMAND_OK) || (status == PGRES_TUPLES_OK);
+}
+
+bool has_sqlstate(const PGresult* result, const char* sqlstate)
+{
+    const char* const result_sqlstate = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    return (result_sqlstate != nullptr) && (std::strcmp(result_sqlstate, sqlstate) == 0);
+}
+
+// libpq representation of QueryParams, it refers to data owned by QueryParams
+class LibPqParams
+{
+public:
+    explicit LibPqParams(const QueryParams& params)
+    {
+        constexpr Oid an_untyped_literal_string = 0;
+        constexpr Oid a_binary_data = 17;
+        constexpr int parameter_is_text = 0;
+        constexpr int parameter_is_binary = 1;
+
+        types_.reserve(params.size());
+        values_.reserve(params.size());
+        lengths_.reserve(params.size());
+        formats_.reserve(params.size());
+        for (const auto& param : params)
+        {
+            types_.push_back(param.is_binary() ? a_binary_data : an_untyped_literal_string);
+            values_.push_back(param.is_null() ? nullptr : &(param.get_data())[0]);
+            lengths_.push_back(param.get_data().size());
+            formats_.push_back(param.is_binary() ? parameter_is_binary : parameter_is_text);
+        }
+    }
+    int size()const { return values_.size(); }
+    const Oid* types()const { return types_.empty() ? nullptr : types_.data(); }
+    const char* const* values()const { return values_.data(); }
+    const int* lengths()const { return lengths_.data(); }
+    const int* formats()const { return formats_.data(); }
+private:
+    std::vector<Oid> types_;//types of query parameters
+    std::vector<const char*> values_;//pointer to memory with parameters data
+    std::vector<int> lengths_;//sizes of memory with parameters data
+    std::vector<int> formats_;//format of parameter data
+};
+
+std::string dump_params(const QueryParams& params)
+{
+    std::string params_dump;
+    std::size_t params_counter = 0;
+    for (const auto& param : params)
+    {
+        ++params_counter;
+        params_dump += " $" + boost::lexical_cast<std::string>(params_counter) + ": " +
+                       (param.is_null() ? std::string("null")
+                                        : (param.is_binary() ? std::string("binary") : param.get_data()));
+    }
+    return params_dump;
+}
+
+}//namespace Database::{anonymous}
+
 PSQLConnection::PSQLConnection(const OpenType& need_to_open)
-    : psql_conn_(PQconnectdb(need_to_open.c_str()))
+    : psql_conn_(PQconnectdb(need_to_open.c_str())),
+      statement_cache_(default_statement_cache_capacity, default_statement_prepare_threshold)
 {
     if (PQstatus(psql_conn_) != CONNECTION_OK)
     {
@@ -58,8 +146,10 @@ PSQLConnection::PSQLConnection(const OpenType& need_to_open)
 #endif
 }
 
+// prepared statements of a foreign connection are out of our control
 PSQLConnection::PSQLConnection(PGconn* conn)
-    : psql_conn_{conn}
+    : psql_conn_{conn},
+      statement_cache_{no_statement_cache, default_statement_prepare_threshold}
 {}
 
 PSQLConnection::~PSQLConnection()
@@ -94,15 +184,122 @@ PSQLConnection::ResultType PSQLConnection::exec(const std::string& _query)
     throw ResultFailed(_query + " (" + PQerrorMessage(psql_conn_) + ")");
 }
 
+std::shared_ptr<PGresult> PSQLConnection::exec_params_(
+        const std::string& query,
+        int params_count,
+        const Oid* param_types,
+        const char* const* param_values,
+        const int* param_lengths,
+        const int* param_formats,
+        ResultFormat result_format,
+        StatementCaching caching)
+{
+    const int results_format = result_format == ResultFormat::binary ? 1 : 0;
+    const bool use_statement_cache = (caching == StatementCaching::enabled) && statement_cache_.is_enabled();
+    if (!use_statement_cache)
+    {
+        return std::shared_ptr<PGresult>(
+                PQexecParams(
+                        psql_conn_,
+                        query.c_str(),
+                        params_count,
+                        param_types,
+                        param_values,
+                        param_lengths,
+                        param_formats,
+                        results_format),
+                PQclear);
+    }
+
+    const std::string key = make_statement_cache_key(query, params_count, param_types);
+    const StatementCache::Lookup lookup = statement_cache_.use(key);
+    std::string statement_name;
+    if (lookup.statement_name != nullptr)
+    {
+        statement_name = *lookup.statement_name;
+    }
+    else if (lookup.should_be_prepared)
+    {
+        statement_name = statement_cache_.make_statement_name();
+        const auto prepared = std::shared_ptr<PGresult>(
+                PQprepare(psql_conn_, statement_name.c_str(), query.c_str(), params_count, param_types),
+                PQclear);
+        if (!is_successful(prepared.get()))
+        {
+            return prepared;
+        }
+        statement_cache_.set_prepared(key, statement_name);
+    }
+    else
+    {
+        const auto result = std::shared_ptr<PGresult>(
+                PQexecParams(
+                        psql_conn_,
+                        query.c_str(),
+                        params_count,
+                        param_types,
+                        param_values,
+                        param_lengths,
+                        param_formats,
+                        results_format),
+                PQclear);
+        if (is_successful(result.get()))
+        {
+            this->deallocate_obsolete_statements();
+        }
+        return result;
+    }
+
+    const auto result = std::shared_ptr<PGresult>(
+            PQexecPrepared(
+                    psql_conn_,
+                    statement_name.c_str(),
+                    params_count,
+                    param_values,
+                    param_lengths,
+                    param_formats,
+                    results_format),
+            PQclear);
+    if (is_successful(result.get()))
+    {
+        this->deallocate_obsolete_statements();
+    }
+    else
+    {
+        static constexpr auto feature_not_supported = "0A000";// cached plan must not change result type
+        if (has_sqlstate(result.get(), feature_not_supported))
+        {
+            statement_cache_.forget(key);
+        }
+    }
+    return result;
+}
+
+void PSQLConnection::deallocate_obsolete_statements()
+{
+    for (const auto& statement_name : statement_cache_.pop_obsolete_statements())
+    {
+        // the statement name is generated by StatementCache so it needs no quoting
+        const std::string query = "DEALLOCATE " + statement_name;
+        const auto result = std::shared_ptr<PGresult>(PQexec(psql_conn_, query.c_str()), PQclear);
+#ifdef HAVE_LOGGER
+        if (!is_successful(result.get()))
+        {
+            FREDLOG_WARNING(query + " failed: " + PQerrorMessage(psql_conn_));
+        }
+#endif
+    }
+}
+
 PSQLConnection::ResultType PSQLConnection::exec_params(
         const std::string& query,
-        const std::vector<std::string>& params)
+        const std::vector<std::string>& params,
+        StatementCaching caching)
 {
     std::vector<const char*> param_values; //pointer to memory with parameters data
     constexpr const Oid* untyped_literal_strings = nullptr;
     std::vector<int> param_lengths;
     constexpr const int* all_parameters_are_text_strings = nullptr;
-    constexpr int results_in_text_format = 0;
 
     param_values.reserve(params.size());
     param_lengths.reserve(params.size());
@@ -112,20 +309,17 @@ PSQLConnection::ResultType PSQLConnection::exec_params(
         param_lengths.push_back(param.size());
     }
 
-    const auto tmp = std::shared_ptr<PGresult>(
-            PQexecParams(
-                    psql_conn_,
-                    query.c_str(),
-                    param_values.size(),
-                    untyped_literal_strings,
-                    param_values.data(),
-                    param_lengths.data(),
-                    all_parameters_are_text_strings,
-                    results_in_text_format),
-            PQclear);
-
-    const ExecStatusType status = PQresultStatus(tmp.get());
-    if ((status == PGRES_COMMAND_OK) || (status == PGRES_TUPLES_OK))
+    const auto tmp = this->exec_params_(
+            query,
+            param_values.size(),
+            untyped_literal_strings,
+            param_values.data(),
+            param_lengths.data(),
+            all_parameters_are_text_strings,
+            ResultFormat::text,
+            caching);
+
+    if (is_successful(tmp.get()))
     {
         return PSQLResult(tmp);
     }
@@ -144,64 +338,141 @@ PSQLConnection::ResultType PSQLConnection::exec_params(
 
 PSQLConnection::ResultType PSQLConnection::exec_params(
         const std::string& query,
-        const QueryParams& params)
+        const QueryParams& params,
+        StatementCaching caching)
 {
-    constexpr Oid an_untyped_literal_string = 0;
-    constexpr Oid a_binary_data = 17;
-    constexpr int results_in_text_format = 0;
-    constexpr int parameter_is_text = 0;
-    constexpr int parameter_is_binary = 1;
-
-    std::vector<Oid> param_types;//types of query parameters
-    std::vector<const char*> param_values; //pointer to memory with parameters data
-    std::vector<int> param_lengths; //sizes of memory with parameters data
-    std::vector<int> param_formats; //format of parameter data
+    return this->exec_params(query, params, ResultFormat::text, caching);
+}
 
-    param_types.reserve(params.size());
-    param_values.reserve(params.size());
-    param_lengths.reserve(params.size());
-    param_formats.reserve(params.size());
-    for (const auto& param : params)
+PSQLConnection::ResultType PSQLConnection::exec_params(
+        const std::string& query,
+        const QueryParams& params,
+        ResultFormat result_format,
+        StatementCaching caching)
+{
+    const LibPqParams libpq_params(params);
+    const auto tmp = this->exec_params_(
+            query,
+            libpq_params.size(),
+            libpq_params.types(),
+            libpq_params.values(),
+            libpq_params.lengths(),
+            libpq_params.formats(),
+            result_format,
+            caching);
+
+    if (is_successful(tmp.get()))
     {
-        param_types.push_back(param.is_binary() ? a_binary_data : an_untyped_literal_string);
-        param_values.push_back(param.is_null() ? nullptr : &(param.get_data())[0]);
-        param_lengths.push_back(param.get_data().size());
-        param_formats.push_back(param.is_binary() ? parameter_is_binary : parameter_is_text);
+        return PSQLResult(tmp);
     }
 
-    const auto tmp = std::shared_ptr<PGresult>(
-            PQexecParams(
-                    psql_conn_,
-                    query.c_str(),
-                    param_values.size(),
-                    param_types.size() != 0 ? param_types.data() : nullptr,
-                    param_values.data(),
-                    param_lengths.data(),
-                    param_formats.data(),
-                    results_in_text_format),
-            PQclear);
+    throw ResultFailed("query: " + query + " "
+                       "Params:" + dump_params(params) + " (" + PQerrorMessage(psql_conn_) + ")");
+}
 
-    const ExecStatusType status = PQresultStatus(tmp.get());
-    if ((status == PGRES_COMMAND_OK) || (status == PGRES_TUPLES_OK))
+std::vector<PSQLConnection::ResultType> PSQLConnection::exec_pipeline(const PipelineStatements& statements)
+{
+    std::vector<ResultType> results;
+    results.reserve(statements.size());
+#ifdef LIBPQ_HAS_PIPELINING
+    const bool use_pipeline_mode = 1 < statements.size();
+#else
+    const bool use_pipeline_mode = false;// libpq older than 14
+#endif
+    if (!use_pipeline_mode)
     {
-        return PSQLResult(tmp);
+        for (const auto& statement : statements)
+        {
+            results.push_back(this->exec_params(statement.first, statement.second));
+        }
+        return results;
+    }
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQenterPipelineMode(psql_conn_) != 1)
+    {
+        throw ResultFailed(std::string("unable to enter pipeline mode (") + PQerrorMessage(psql_conn_) + ")");
     }
+    constexpr int results_in_text_format = 0;
+    std::size_t statements_sent = 0;
+    std::string send_error;
+    for (const auto& statement : statements)
+    {
+        const LibPqParams libpq_params(statement.second);
+        const int sent = PQsendQueryParams(
+                psql_conn_,
+                statement.first.c_str(),
+                libpq_params.size(),
+                libpq_params.types(),
+                libpq_params.values(),
+                libpq_params.lengths(),
+                libpq_params.formats(),
+                results_in_text_format);
+        if (sent != 1)
+        {
+            send_error = PQerrorMessage(psql_conn_);
+            break;
+        }
+        ++statements_sent;
+    }
+    const bool synced = PQpipelineSync(psql_conn_) == 1;
 
-    std::string params_dump;
-    std::size_t params_counter = 0;
-    for (const auto& param : params)
+    // each statement yields its result followed by nullptr, the whole pipeline ends with PGRES_PIPELINE_SYNC
+    std::vector<std::shared_ptr<PGresult>> raw_results;
+    raw_results.reserve(statements_sent);
+    std::shared_ptr<PGresult> statement_result;
+    while (synced)
     {
-        ++params_counter;
-        params_dump += " $" + boost::lexical_cast<std::string>(params_counter) + ": " +
-                       (param.is_null() ? std::string("null")
-                                        : (param.is_binary() ? std::string("binary") : param.get_data()));
+        PGresult* const raw_result = PQgetResult(psql_conn_);
+        if (raw_result == nullptr)
+        {
+            if (statement_result == nullptr)
+            {
+                break;// nothing more to read, connection is probably broken
+            }
+            raw_results.push_back(statement_result);
+            statement_result = nullptr;
+            continue;
+        }
+        if (PQresultStatus(raw_result) == PGRES_PIPELINE_SYNC)
+        {
+            PQclear(raw_result);
+            break;
+        }
+        statement_result = std::shared_ptr<PGresult>(raw_result, PQclear);
     }
+    PQexitPipelineMode(psql_conn_);
 
-    throw ResultFailed("query: " + query + " "
-                       "Params:" + params_dump + " (" + PQerrorMessage(psql_conn_) + ")");
+    for (std::size_t idx = 0; idx < raw_results.size(); ++idx)
+    {
+        const PGresult* const raw_result = raw_results[idx].get();
+        if (is_successful(raw_result))
+        {
+            results.push_back(PSQLResult(raw_results[idx]));
+            continue;
+        }
+        if (PQresultStatus(raw_result) == PGRES_PIPELINE_ABORTED)
+        {
+            break;
+        }
+        throw ResultFailed("pipeline statement " + std::to_string(idx + 1) + " of " + std::to_string(statements.size()) + " "
+                           "query: " + statements[idx].first + " "
+                           "Params:" + dump_params(statements[idx].second) + " "
+                           "(" + PQresultErrorMessage(raw_result) + ")");
+    }
+    if (results.size() != statements.size())
+    {
+        const std::size_t failed_idx = results.size();
+        const std::string reason = !send_error.empty() ? send_error
+                                                       : std::string(PQerrorMessage(psql_conn_));
+        throw ResultFailed("pipeline statement " + std::to_string(failed_idx + 1) + " of " + std::to_string(statements.size()) + " "
+                           "query: " + statements[failed_idx].first + " "
+                           "Params:" + dump_params(statements[failed_idx].second) + " "
+                           "(" + reason + ")");
+    }
+#endif
+    return results;
 }
 
-
 PSQLConnection::ResultType PSQLConnection::copy_from(std::istream& input_data, const std::string& table_name, std::size_t buffer_size)
 {
     auto get_last_result = [](const auto conn) {
@@ -284,6 +555,26 @@ void PSQLConnection::reset()
     {
         PQreset(psql_conn_);
     }
+    statement_cache_.clear();
+}
+
+void PSQLConnection::set_statement_cache_capacity(std::size_t capacity)
+{
+    statement_cache_.set_capacity(capacity);
+    if (!this->is_in_transaction() || this->is_in_valid_transaction())
+    {
+        this->deallocate_obsolete_statements();
+    }
+}
+
+void PSQLConnection::set_statement_prepare_threshold(unsigned threshold)
+{
+    statement_cache_.set_prepare_threshold(threshold);
+}
+
+StatementCacheStatistics PSQLConnection::get_statement_cache_statistics()const
+{
+    return statement_cache_.get_statistics();
 }
 
 std::string PSQLConnection::escape(const std::string& from)const
@@ -333,4 +624,9 @@ bool PSQLConnection::is_in_valid_transaction()const
     throw std::runtime_error("PQtransactionStatus() failure: unexpected return value");
 }
 
+bool PSQLConnection::is_connection_ok()const
+{
+    return (psql_conn_ != nullptr) && (PQstatus(psql_conn_) == CONNECTION_OK);
+}
+
 }//namespace Database
@@ -26,11 +26,15 @@
 
 #include "util/db/psql/psql_result.hh"
 #include "util/db/query_param.hh"
+#include "util/db/statement_cache.hh"
 
 #include <libpq-fe.h>
 
 #include <istream>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace Database {
 
@@ -62,26 +66,77 @@ public:
 
     ResultType exec_params(
             const std::string& query, //one command query
-            const std::vector<std::string>& params);//parameters data
+            const std::vector<std::string>& params, //parameters data
+            StatementCaching caching = StatementCaching::enabled);
 
     ResultType exec_params(
             const std::string& _query, //one command query
-            const QueryParams& params);//parameters data
+            const QueryParams& params, //parameters data
+            StatementCaching caching = StatementCaching::enabled);
+
+    ResultType exec_params(
+            const std::string& _query, //one command query
+            const QueryParams& params, //parameters data
+            ResultFormat result_format, //requested format of result fields
+            StatementCaching caching = StatementCaching::enabled);
+
+    using PipelineStatements = std::vector<std::pair<std::string, QueryParams>>;
+
+    /**
+     * Executes independent statements in one network round trip (libpq pipeline mode).
+     * Statements are executed in given order, the first failure aborts all following statements.
+     * All statements are sent before any result is read so keep the pipeline short.
+     * @param statements one command queries with their parameters
+     * @return results in order of statements
+     * @throw ResultFailed describing the first failed statement
+     */
+    std::vector<ResultType> exec_pipeline(const PipelineStatements& statements);
 
     ResultType copy_from(std::istream& input_data, const std::string& table_name, std::size_t buffer_size);
 
     void setQueryTimeout(unsigned t);
 
+    /**
+     * Reset connection to state after connect, all prepared statements are lost
+     */
     void reset();
 
+    /**
+     * Set maximal number of prepared statements kept on the server side, 0 disables statement caching
+     */
+    void set_statement_cache_capacity(std::size_t capacity);
+
+    /**
+     * Set how many times a query has to be executed before it is prepared on the server side
+     */
+    void set_statement_prepare_threshold(unsigned threshold);
+
+    StatementCacheStatistics get_statement_cache_statistics()const;
+
     std::string escape(const std::string& in)const;
 
     bool is_in_transaction()const;
 
     bool is_in_valid_transaction()const;
+
+    /**
+     * @return true if connection to the server is established (PQstatus() is CONNECTION_OK)
+     */
+    bool is_connection_ok()const;
 private:
     explicit PSQLConnection(PGconn* conn);// used by the EncapsulationBreachHack class
+    std::shared_ptr<PGresult> exec_params_(
+            const std::string& query,
+            int params_count,
+            const Oid* param_types,
+            const char* const* param_values,
+            const int* param_lengths,
+            const int* param_formats,
+            ResultFormat result_format,
+            StatementCaching caching);
+    void deallocate_obsolete_statements();
     PGconn* psql_conn_; ///< wrapped connection structure from libpq library
+    StatementCache statement_cache_; ///< server-side prepared statements of this connection
     friend class EncapsulationBreachHack;
 };
 
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file psql_field_decoder.hh
+ *  Direct conversions of PSQL result fields (text or binary format) into C++ types.
+ */
+
+#ifndef PSQL_FIELD_DECODER_HH_6B2E5CCF83DB4804BCBC2BCB63B880A9
+#define PSQL_FIELD_DECODER_HH_6B2E5CCF83DB4804BCBC2BCB63B880A9
+
+#include "util/types/convert_common.hh"
+#include "util/types/convert_sql_std_chrono_types.hh"
+
+#include <boost/date_time/posix_time/ptime.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <boost/uuid/string_generator.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include <libpq-fe.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace Database {
+
+/**
+ * One field of PSQL result as returned by libpq, the data are owned by PGresult.
+ */
+struct PSQLField
+{
+    const char* data;///< PQgetvalue(), terminated by '\0' in both formats
+    int length;///< PQgetlength()
+    Oid type;///< PQftype()
+    bool is_binary;///< PQfformat() == 1
+};
+
+namespace PSQLFieldDecoderImpl {
+
+// type Oids from server/catalog/pg_type_d.h
+constexpr Oid bool_oid = 16;
+constexpr Oid bytea_oid = 17;
+constexpr Oid char_oid = 18;
+constexpr Oid name_oid = 19;
+constexpr Oid int8_oid = 20;
+constexpr Oid int2_oid = 21;
+constexpr Oid int4_oid = 23;
+constexpr Oid text_oid = 25;
+constexpr Oid oid_oid = 26;
+constexpr Oid bpchar_oid = 1042;
+constexpr Oid varchar_oid = 1043;
+constexpr Oid timestamp_oid = 1114;
+constexpr Oid timestamptz_oid = 1184;
+constexpr Oid uuid_oid = 2950;
+
+[[noreturn]] inline void conversion_failed(const char* type_name)
+{
+    throw ConversionError("from sql field", type_name);
+}
+
+// binary values are sent in network byte order
+inline std::uint64_t big_endian_to_uint(const char* data, int length)
+{
+    std::uint64_t result = 0;
+    for (int idx = 0; idx < length; ++idx)
+    {
+        result = (result << 8) | static_cast<unsigned char>(data[idx]);
+    }
+    return result;
+}
+
+inline std::int64_t decode_binary_integer(const PSQLField& field, const char* type_name)
+{
+    switch (field.type)
+    {
+        case int2_oid:
+            if (field.length == 2)
+            {
+                return static_cast<std::int16_t>(big_endian_to_uint(field.data, 2));
+            }
+            break;
+        case int4_oid:
+            if (field.length == 4)
+            {
+                return static_cast<std::int32_t>(big_endian_to_uint(field.data, 4));
+            }
+            break;
+        case oid_oid:
+            if (field.length == 4)
+            {
+                return static_cast<std::uint32_t>(big_endian_to_uint(field.data, 4));
+            }
+            break;
+        case int8_oid:
+            if (field.length == 8)
+            {
+                return static_cast<std::int64_t>(big_endian_to_uint(field.data, 8));
+            }
+            break;
+    }
+    conversion_failed(type_name);
+}
+
+template <typename T>
+T narrow_integer(std::int64_t value, const char* type_name)
+{
+    const bool fits = std::is_signed<T>::value
+            ? ((static_cast<std::int64_t>(std::numeric_limits<T>::min()) <= value) &&
+               (value <= static_cast<std::int64_t>(std::numeric_limits<T>::max())))
+            : ((0 <= value) &&
+               (static_cast<std::uint64_t>(value) <= static_cast<std::uint64_t>(std::numeric_limits<T>::max())));
+    if (!fits)
+    {
+        conversion_failed(type_name);
+    }
+    return static_cast<T>(value);
+}
+
+inline bool is_text_type(Oid type)
+{
+    switch (type)
+    {
+        case char_oid:
+        case name_oid:
+        case text_oid:
+        case bpchar_oid:
+        case varchar_oid:
+            return true;
+    }
+    return false;
+}
+
+// microseconds between 1970-01-01 and 2000-01-01 (PostgreSQL epoch)
+constexpr std::int64_t postgres_epoch_usec = 946684800LL * 1000000LL;
+
+}//namespace Database::PSQLFieldDecoderImpl
+
+/**
+ * Decodes result field into T without intermediate Value object.
+ * Only non-NULL fields are passed to decode().
+ */
+template <typename T, typename Enable = void>
+struct PSQLFieldDecoder;
+
+template <typename T>
+struct PSQLFieldDecoder<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+{
+    static T decode(const PSQLField& field)
+    {
+        using namespace PSQLFieldDecoderImpl;
+        static constexpr auto type_name = "PSQLFieldDecoder<integer>";
+        if (field.is_binary)
+        {
+            return narrow_integer<T>(decode_binary_integer(field, type_name), type_name);
+        }
+        char* end = nullptr;
+        errno = 0;
+        const long long value = std::strtoll(field.data, &end, 10);
+        if ((errno != 0) || (end == field.data) || (*end != '\0'))
+        {
+            conversion_failed(type_name);
+        }
+        return narrow_integer<T>(value, type_name);
+    }
+};
+
+template <>
+struct PSQLFieldDecoder<bool>
+{
+    static bool decode(const PSQLField& field)
+    {
+        if (field.is_binary)
+        {
+            if ((field.type == PSQLFieldDecoderImpl::bool_oid) && (field.length == 1))
+            {
+                return field.data[0] != 0;
+            }
+        }
+        else if (field.length == 1)
+        {
+            switch (field.data[0])
+            {
+                case 't':
+                    return true;
+                case 'f':
+                    return false;
+            }
+        }
+        PSQLFieldDecoderImpl::conversion_failed("PSQLFieldDecoder<bool>");
+    }
+};
+
+/**
+ * Zero-copy access, valid as long as the result exists.
+ */
+template <>
+struct PSQLFieldDecoder<boost::string_ref>
+{
+    static boost::string_ref decode(const PSQLField& field)
+    {
+        if (field.is_binary &&
+            !PSQLFieldDecoderImpl::is_text_type(field.type) &&
+            (field.type != PSQLFieldDecoderImpl::bytea_oid))
+        {
+            PSQLFieldDecoderImpl::conversion_failed("PSQLFieldDecoder<boost::string_ref>");
+        }
+        return boost::string_ref(field.data, field.length);
+    }
+};
+
+template <>
+struct PSQLFieldDecoder<std::string>
+{
+    static std::string decode(const PSQLField& field)
+    {
+        const boost::string_ref value = PSQLFieldDecoder<boost::string_ref>::decode(field);
+        return std::string(value.data(), value.size());
+    }
+};
+
+template <>
+struct PSQLFieldDecoder<boost::uuids::uuid>
+{
+    static boost::uuids::uuid decode(const PSQLField& field)
+    {
+        static constexpr auto type_name = "PSQLFieldDecoder<boost::uuids::uuid>";
+        if (field.is_binary)
+        {
+            boost::uuids::uuid result;
+            if ((field.type != PSQLFieldDecoderImpl::uuid_oid) || (field.length != static_cast<int>(boost::uuids::uuid::static_size())))
+            {
+                PSQLFieldDecoderImpl::conversion_failed(type_name);
+            }
+            std::copy(field.data, field.data + field.length, result.begin());
+            return result;
+        }
+        try
+        {
+            return boost::uuids::string_generator()(field.data, field.data + field.length);
+        }
+        catch (const std::exception&)
+        {
+            PSQLFieldDecoderImpl::conversion_failed(type_name);
+        }
+    }
+};
+
+/**
+ * Timestamps are decoded as UTC, 'infinity' values map to TimePoint::max() and TimePoint::min().
+ */
+template <typename R>
+struct PSQLFieldDecoder<std::chrono::time_point<std::chrono::system_clock, R>>
+{
+    using TimePoint = std::chrono::time_point<std::chrono::system_clock, R>;
+    static TimePoint decode(const PSQLField& field)
+    {
+        if (!field.is_binary)
+        {
+            return SqlConvert<TimePoint>::from(std::string(field.data, field.length));
+        }
+        if (((field.type != PSQLFieldDecoderImpl::timestamp_oid) &&
+             (field.type != PSQLFieldDecoderImpl::timestamptz_oid)) ||
+            (field.length != 8))
+        {
+            PSQLFieldDecoderImpl::conversion_failed("PSQLFieldDecoder<std::chrono::time_point>");
+        }
+        const auto usec = static_cast<std::int64_t>(PSQLFieldDecoderImpl::big_endian_to_uint(field.data, 8));
+        if (usec == std::numeric_limits<std::int64_t>::max())
+        {
+            return TimePoint::max();
+        }
+        if (usec == std::numeric_limits<std::int64_t>::min())
+        {
+            return TimePoint::min();
+        }
+        return TimePoint(std::chrono::duration_cast<R>(
+                std::chrono::microseconds(usec + PSQLFieldDecoderImpl::postgres_epoch_usec)));
+    }
+};
+
+template <>
+struct PSQLFieldDecoder<boost::posix_time::ptime>
+{
+    static boost::posix_time::ptime decode(const PSQLField& field)
+    {
+        if (!field.is_binary)
+        {
+            return SqlConvert<boost::posix_time::ptime>::from(std::string(field.data, field.length));
+        }
+        if (((field.type != PSQLFieldDecoderImpl::timestamp_oid) &&
+             (field.type != PSQLFieldDecoderImpl::timestamptz_oid)) ||
+            (field.length != 8))
+        {
+            PSQLFieldDecoderImpl::conversion_failed("PSQLFieldDecoder<boost::posix_time::ptime>");
+        }
+        const auto usec = static_cast<std::int64_t>(PSQLFieldDecoderImpl::big_endian_to_uint(field.data, 8));
+        if (usec == std::numeric_limits<std::int64_t>::max())
+        {
+            return boost::posix_time::ptime(boost::posix_time::pos_infin);
+        }
+        if (usec == std::numeric_limits<std::int64_t>::min())
+        {
+            return boost::posix_time::ptime(boost::posix_time::neg_infin);
+        }
+        static const boost::posix_time::ptime postgres_epoch(boost::gregorian::date(2000, 1, 1));
+        return postgres_epoch + boost::posix_time::microseconds(usec);
+    }
+};
+
+}//namespace Database
+
+#endif//PSQL_FIELD_DECODER_HH_6B2E5CCF83DB4804BCBC2BCB63B880A9
@@ -159,6 +159,17 @@ void check_increasing_sequence(T a0, T a1, T a2)
     throw OutOfRange(a1, {a0, a2});
 }
 
+constexpr int binary_format = 1;
+
+// binary data can not be interpreted by Value, typed accessors have to be used
+void check_text_format(const PGresult* result, int col_idx)
+{
+    if (PQfformat(result, col_idx) == binary_format)
+    {
+        throw Exception("binary result field accessed as text, use typed accessor Row::get<T>()");
+    }
+}
+
 }//namespace Database::{anonymous}
 
 /**
@@ -179,6 +190,7 @@ void PSQLResult::check_range(size_type row_idx, size_type col_idx)const
 std::string PSQLResult::value_(size_type _r, size_type _c)const
 {
     this->check_range(_r, _c);
+    check_text_format(psql_result_.get(), _c);
     return PQgetvalue(psql_result_.get(), _r, _c);
 }
 
@@ -216,7 +228,9 @@ int PSQLResult::get_column_number(const std::string& column_name)const
 std::string PSQLResult::value_(size_type row_idx, const std::string& column_name)const
 {
     check_increasing_sequence(0u, row_idx, this->rows_());
-    return PQgetvalue(psql_result_.get(), row_idx, this->get_column_number(column_name));
+    const int col_idx = this->get_column_number(column_name);
+    check_text_format(psql_result_.get(), col_idx);
+    return PQgetvalue(psql_result_.get(), row_idx, col_idx);
 }
 
 /**
@@ -230,4 +244,19 @@ bool PSQLResult::value_is_null_(size_type row_idx, const std::string& column_nam
     return PQgetisnull(psql_result_.get(), row_idx, this->get_column_number(column_name));
 }
 
+/**
+ * @param row_idx row number
+ * @param col_idx column number
+ * @return raw field data owned by the result, range must be already checked
+ */
+PSQLField PSQLResult::field_(size_type row_idx, size_type col_idx)const
+{
+    const PGresult* const result = psql_result_.get();
+    return PSQLField{
+            PQgetvalue(result, row_idx, col_idx),
+            PQgetlength(result, row_idx, col_idx),
+            PQftype(result, col_idx),
+            PQfformat(result, col_idx) == binary_format};
+}
+
 }//namespace Database
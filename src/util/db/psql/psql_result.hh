@@ -27,6 +27,9 @@
 #include "util/db/row.hh"
 #include "util/db/value.hh"
 #include "util/db/result.hh"
+#include "util/db/psql/psql_field_decoder.hh"
+
+#include <boost/optional.hpp>
 
 #include <libpq-fe.h>
 
@@ -112,6 +115,43 @@ private:
     int get_column_number(const std::string& column_name)const;// throw(NoSuchField)
     std::string value_(size_type row_idx, const std::string& column_name)const;// throw(NoSuchField)
     bool value_is_null_(size_type row_idx, const std::string& column_name)const;// throw(NoSuchField)
+    PSQLField field_(size_type row_idx, size_type col_idx)const;
+    template <typename T>
+    struct FieldGetter
+    {
+        static T get(const PSQLResult& result, size_type row_idx, size_type col_idx)
+        {
+            result.check_range(row_idx, col_idx);
+            if (PQgetisnull(result.psql_result_.get(), row_idx, col_idx))
+            {
+                throw ConversionError("from sql field", "NULL value");
+            }
+            return PSQLFieldDecoder<T>::decode(result.field_(row_idx, col_idx));
+        }
+    };
+    template <typename T>
+    struct FieldGetter<boost::optional<T>>
+    {
+        static boost::optional<T> get(const PSQLResult& result, size_type row_idx, size_type col_idx)
+        {
+            result.check_range(row_idx, col_idx);
+            if (PQgetisnull(result.psql_result_.get(), row_idx, col_idx))
+            {
+                return boost::none;
+            }
+            return PSQLFieldDecoder<T>::decode(result.field_(row_idx, col_idx));
+        }
+    };
+    template <typename T>
+    T get_(size_type row_idx, size_type col_idx)const// throw(OutOfRange, ConversionError)
+    {
+        return FieldGetter<T>::get(*this, row_idx, col_idx);
+    }
+    template <typename T>
+    T get_(size_type row_idx, const std::string& column_name)const// throw(NoSuchField, ConversionError)
+    {
+        return FieldGetter<T>::get(*this, row_idx, this->get_column_number(column_name));
+    }
     friend class Row_<PSQLResult, value_type>;
     friend class Row_<PSQLResult, value_type>::Iterator;
     friend class Result_<PSQLResult>;
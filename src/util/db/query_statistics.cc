@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file query_statistics.cc
+ *  Process-wide statistics of executed queries aggregated by query shape.
+ */
+
+#include "util/db/query_statistics.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Database {
+
+namespace {
+
+bool is_identifier_char(char c)
+{
+    return (std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '_') || (c == '$');
+}
+
+bool is_digit(char c)
+{
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+bool is_space(char c)
+{
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool ends_with(const std::string& str, const char* suffix)
+{
+    const std::string::size_type suffix_length = std::char_traits<char>::length(suffix);
+    return (suffix_length <= str.size()) && (str.compare(str.size() - suffix_length, suffix_length, suffix) == 0);
+}
+
+struct SlowQueryReporting
+{
+    std::chrono::microseconds threshold;
+    SlowQueryCallback callback;
+};
+
+struct Shard
+{
+    std::mutex mutex;
+    std::unordered_map<unsigned long long, QueryStatistics> statistics;
+};
+
+constexpr std::size_t number_of_shards = 16;
+
+std::array<Shard, number_of_shards>& get_shards()
+{
+    static std::array<Shard, number_of_shards> shards;
+    return shards;
+}
+
+std::atomic<bool>& get_statistics_enabled()
+{
+    static std::atomic<bool> enabled{true};
+    return enabled;
+}
+
+std::shared_ptr<const SlowQueryReporting>& get_slow_query_reporting()
+{
+    static std::shared_ptr<const SlowQueryReporting> reporting;
+    return reporting;
+}
+
+void record(
+        const std::string& query,
+        std::chrono::nanoseconds duration,
+        std::size_t rows_returned,
+        std::size_t rows_affected,
+        bool failed)
+{
+    const bool is_enabled = is_query_statistics_enabled();
+    const auto slow_query_reporting = std::atomic_load(&get_slow_query_reporting());
+    const auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    const bool is_slow = (slow_query_reporting != nullptr) && (slow_query_reporting->threshold <= duration_us);
+    if (!is_enabled && !is_slow)
+    {
+        return;
+    }
+    std::string normalized_query = normalize_query(query);
+    const auto fingerprint = get_query_fingerprint(normalized_query);
+    if (is_enabled)
+    {
+        auto& shard = get_shards()[fingerprint % number_of_shards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto statistics_itr = shard.statistics.find(fingerprint);
+        if (statistics_itr == shard.statistics.end())
+        {
+            QueryStatistics statistics;
+            statistics.fingerprint = fingerprint;
+            statistics.normalized_query = std::move(normalized_query);
+            statistics.calls = 0;
+            statistics.errors = 0;
+            statistics.rows_returned = 0;
+            statistics.rows_affected = 0;
+            statistics.total_time = std::chrono::microseconds::zero();
+            statistics.max_time = std::chrono::microseconds::zero();
+            statistics_itr = shard.statistics.emplace(fingerprint, std::move(statistics)).first;
+        }
+        auto& statistics = statistics_itr->second;
+        ++statistics.calls;
+        if (failed)
+        {
+            ++statistics.errors;
+        }
+        statistics.rows_returned += rows_returned;
+        statistics.rows_affected += rows_affected;
+        statistics.total_time += duration_us;
+        statistics.max_time = std::max(statistics.max_time, duration_us);
+        statistics.latency.record(duration_us);
+    }
+    if (is_slow)
+    {
+        try
+        {
+            slow_query_reporting->callback(SlowQuery{fingerprint, query, duration_us, failed});
+        }
+        catch (...) { }
+    }
+}
+
+}//namespace Database::{anonymous}
+
+std::string normalize_query(const std::string& query)
+{
+    std::string result;
+    result.reserve(query.size());
+    bool pending_space = false;
+    const auto append = [&](char c)
+    {
+        if (pending_space && !result.empty())
+        {
+            result.push_back(' ');
+        }
+        pending_space = false;
+        result.push_back(c);
+    };
+    const auto append_literal = [&]()
+    {
+        if (ends_with(result, "?,"))
+        {
+            result.pop_back();
+            pending_space = false;
+            return;
+        }
+        append('?');
+    };
+    std::size_t idx = 0;
+    while (idx < query.size())
+    {
+        const char c = query[idx];
+        if (is_space(c))
+        {
+            pending_space = true;
+            ++idx;
+        }
+        else if ((c == '-') && ((idx + 1) < query.size()) && (query[idx + 1] == '-'))
+        {
+            while ((idx < query.size()) && (query[idx] != '\n'))
+            {
+                ++idx;
+            }
+            pending_space = true;
+        }
+        else if ((c == '/') && ((idx + 1) < query.size()) && (query[idx + 1] == '*'))
+        {
+            const auto comment_end = query.find("*/", idx + 2);
+            idx = comment_end == std::string::npos ? query.size() : comment_end + 2;
+            pending_space = true;
+        }
+        else if (c == '\'')
+        {
+            ++idx;
+            while (idx < query.size())
+            {
+                if (query[idx] == '\'')
+                {
+                    if (((idx + 1) < query.size()) && (query[idx + 1] == '\''))
+                    {
+                        idx += 2;
+                        continue;
+                    }
+                    ++idx;
+                    break;
+                }
+                ++idx;
+            }
+            append_literal();
+        }
+        else if (c == '"')
+        {
+            append(c);
+            ++idx;
+            while ((idx < query.size()) && (query[idx] != '"'))
+            {
+                result.push_back(query[idx]);
+                ++idx;
+            }
+            if (idx < query.size())
+            {
+                result.push_back(query[idx]);
+                ++idx;
+            }
+        }
+        else if (is_digit(c) && ((idx == 0) || !is_identifier_char(query[idx - 1])))
+        {
+            while ((idx < query.size()) && (is_digit(query[idx]) || (query[idx] == '.')))
+            {
+                ++idx;
+            }
+            if ((idx < query.size()) && ((query[idx] == 'e') || (query[idx] == 'E')))
+            {
+                std::size_t exponent_idx = idx + 1;
+                if ((exponent_idx < query.size()) && ((query[exponent_idx] == '+') || (query[exponent_idx] == '-')))
+                {
+                    ++exponent_idx;
+                }
+                if ((exponent_idx < query.size()) && is_digit(query[exponent_idx]))
+                {
+                    idx = exponent_idx;
+                    while ((idx < query.size()) && is_digit(query[idx]))
+                    {
+                        ++idx;
+                    }
+                }
+            }
+            append_literal();
+        }
+        else
+        {
+            append(c);
+            ++idx;
+        }
+    }
+    return result;
+}
+
+unsigned long long get_query_fingerprint(const std::string& normalized_query)
+{
+    unsigned long long hash = 14695981039346656037ull;
+    for (const char c : normalized_query)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0)
+{
+    counts_.fill(0);
+}
+
+std::size_t LatencyHistogram::get_bucket_index(unsigned long long value)
+{
+    if (value < sub_buckets)
+    {
+        return value;
+    }
+    unsigned exponent = sub_bucket_bits;
+    while ((exponent < 63) && ((value >> (exponent + 1)) != 0))
+    {
+        ++exponent;
+    }
+    if (max_exponent < exponent)
+    {
+        return number_of_buckets - 1;
+    }
+    const auto sub_bucket = (value >> (exponent - sub_bucket_bits)) - sub_buckets;
+    return sub_buckets + (exponent - sub_bucket_bits) * sub_buckets + sub_bucket;
+}
+
+unsigned long long LatencyHistogram::get_bucket_upper_bound(std::size_t index)
+{
+    if (index < sub_buckets)
+    {
+        return index;
+    }
+    const auto shift = (index - sub_buckets) / sub_buckets;
+    const auto sub_bucket = (index - sub_buckets) % sub_buckets;
+    return ((sub_buckets + sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::microseconds duration)
+{
+    const auto value = duration.count() < 0 ? 0ull : static_cast<unsigned long long>(duration.count());
+    ++counts_[get_bucket_index(value)];
+    ++count_;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& src)
+{
+    for (std::size_t idx = 0; idx < counts_.size(); ++idx)
+    {
+        counts_[idx] += src.counts_[idx];
+    }
+    count_ += src.count_;
+}
+
+unsigned long long LatencyHistogram::get_count()const
+{
+    return count_;
+}
+
+std::chrono::microseconds LatencyHistogram::get_percentile(double percent)const
+{
+    if (count_ == 0)
+    {
+        return std::chrono::microseconds::zero();
+    }
+    const auto rank = std::max(1ull, static_cast<unsigned long long>(std::ceil(percent * count_ / 100.0)));
+    unsigned long long cumulative_count = 0;
+    for (std::size_t idx = 0; idx < counts_.size(); ++idx)
+    {
+        cumulative_count += counts_[idx];
+        if (rank <= cumulative_count)
+        {
+            return std::chrono::microseconds(get_bucket_upper_bound(idx));
+        }
+    }
+    return std::chrono::microseconds(get_bucket_upper_bound(counts_.size() - 1));
+}
+
+void set_query_statistics_enabled(bool enabled)
+{
+    get_statistics_enabled() = enabled;
+}
+
+bool is_query_statistics_enabled()
+{
+    return get_statistics_enabled();
+}
+
+void record_query_execution(
+        const std::string& query,
+        std::chrono::nanoseconds duration,
+        std::size_t rows_returned,
+        std::size_t rows_affected)
+{
+    record(query, duration, rows_returned, rows_affected, false);
+}
+
+void record_failed_query_execution(const std::string& query, std::chrono::nanoseconds duration)
+{
+    record(query, duration, 0, 0, true);
+}
+
+std::vector<QueryStatistics> get_query_statistics()
+{
+    std::vector<QueryStatistics> result;
+    for (auto& shard : get_shards())
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& statistics : shard.statistics)
+        {
+            result.push_back(statistics.second);
+        }
+    }
+    std::sort(begin(result), end(result), [](const QueryStatistics& lhs, const QueryStatistics& rhs)
+    {
+        return rhs.total_time < lhs.total_time;
+    });
+    return result;
+}
+
+void reset_query_statistics()
+{
+    for (auto& shard : get_shards())
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.statistics.clear();
+    }
+}
+
+void set_slow_query_callback(std::chrono::microseconds threshold, SlowQueryCallback callback)
+{
+    std::shared_ptr<const SlowQueryReporting> reporting;
+    if (callback)
+    {
+        reporting = std::make_shared<const SlowQueryReporting>(SlowQueryReporting{threshold, std::move(callback)});
+    }
+    std::atomic_store(&get_slow_query_reporting(), reporting);
+}
+
+}//namespace Database
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file query_statistics.hh
+ *  Process-wide statistics of executed queries aggregated by query shape.
+ */
+
+#ifndef QUERY_STATISTICS_HH_3695C59C7848440FACAD6613868B9C8F
+#define QUERY_STATISTICS_HH_3695C59C7848440FACAD6613868B9C8F
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Database {
+
+/**
+ * Makes query shape from SQL text: whitespace is collapsed, string and numeric literals are replaced by `?`
+ * and lists of replaced literals are shrunk into one `?`, query parameters ($1, $2, ...) are kept.
+ */
+std::string normalize_query(const std::string& query);
+
+/**
+ * @return 64-bit FNV-1a hash of normalized query, stable across processes
+ */
+unsigned long long get_query_fingerprint(const std::string& normalized_query);
+
+/**
+ * \class LatencyHistogram
+ * \brief Log-linear histogram of durations in microseconds
+ *
+ * Every power of two range is split into 16 linear buckets, so the recorded durations are kept
+ * with relative error lower than 1/16. Durations up to 2^40 microseconds are distinguished.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+    void record(std::chrono::microseconds duration);
+    void merge(const LatencyHistogram& src);
+    unsigned long long get_count()const;
+    /**
+     * @param percent in range [0, 100]
+     * @return upper bound of the bucket containing the value at given percentile, 0 if histogram is empty
+     */
+    std::chrono::microseconds get_percentile(double percent)const;
+private:
+    static constexpr unsigned sub_bucket_bits = 4;
+    static constexpr unsigned sub_buckets = 1u << sub_bucket_bits;
+    static constexpr unsigned max_exponent = 40;
+    static constexpr std::size_t number_of_buckets = sub_buckets + (max_exponent - sub_bucket_bits + 1) * sub_buckets;
+    static std::size_t get_bucket_index(unsigned long long value);
+    static unsigned long long get_bucket_upper_bound(std::size_t index);
+    std::array<unsigned long long, number_of_buckets> counts_;
+    unsigned long long count_;
+};
+
+struct QueryStatistics
+{
+    unsigned long long fingerprint;
+    std::string normalized_query;
+    unsigned long long calls;///< executions including failed ones
+    unsigned long long errors;///< failed executions
+    unsigned long long rows_returned;
+    unsigned long long rows_affected;
+    std::chrono::microseconds total_time;
+    std::chrono::microseconds max_time;
+    LatencyHistogram latency;
+};
+
+struct SlowQuery
+{
+    unsigned long long fingerprint;
+    const std::string& query;///< SQL text as executed, without parameter values
+    std::chrono::microseconds duration;
+    bool failed;
+};
+
+using SlowQueryCallback = std::function<void(const SlowQuery&)>;
+
+/**
+ * Turns recording of query statistics on or off, it is on by default.
+ */
+void set_query_statistics_enabled(bool enabled);
+
+bool is_query_statistics_enabled();
+
+/**
+ * Records one execution of given query (called by Connection_).
+ */
+void record_query_execution(
+        const std::string& query,
+        std::chrono::nanoseconds duration,
+        std::size_t rows_returned,
+        std::size_t rows_affected);
+
+/**
+ * Records one failed execution of given query (called by Connection_).
+ */
+void record_failed_query_execution(const std::string& query, std::chrono::nanoseconds duration);
+
+/**
+ * @return statistics of all recorded query shapes ordered by total time descending
+ */
+std::vector<QueryStatistics> get_query_statistics();
+
+/**
+ * Forgets all recorded statistics.
+ */
+void reset_query_statistics();
+
+/**
+ * Sets callback called after each execution taking at least given time, callback exceptions are ignored.
+ * @param threshold minimal duration of reported executions
+ * @param callback called in the thread which executed the query, empty callback disables reporting
+ */
+void set_slow_query_callback(std::chrono::microseconds threshold, SlowQueryCallback callback);
+
+}//namespace Database
+
+#endif//QUERY_STATISTICS_HH_3695C59C7848440FACAD6613868B9C8F
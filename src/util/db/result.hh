@@ -35,6 +35,16 @@
 
 namespace Database {
 
+/**
+ * Format of result fields requested from the server.
+ * Binary fields can be read by typed accessors Row::get<T>() only.
+ */
+enum class ResultFormat
+{
+    text,
+    binary
+};
+
 /**
  * \class Result_
  * \brief Base template class for represent database result object
@@ -168,6 +168,31 @@ public:
     return field_type(result_ptr_->value_(row_, _cn), result_ptr_->value_is_null_(row_, _cn));
   }
 
+  /**
+   * Typed access decoding the field directly from the result (text or binary format),
+   * e.g. get<long long>, get<bool>, get<std::string>, get<boost::string_ref>,
+   * get<boost::uuids::uuid>, get<std::chrono::system_clock::time_point>,
+   * get<boost::optional<T>> for nullable fields
+   *
+   * @param _n  column number
+   * @return    field value at position _n
+   */
+  template <typename T>
+  T get(int _n) const
+  {
+    return result_ptr_->template get_<T>(row_, _n);
+  }
+
+  /**
+   * @param _cn  column name
+   * @return     field value at position _cn
+   */
+  template <typename T>
+  T get(const std::string& _cn) const
+  {
+    return result_ptr_->template get_<T>(row_, _cn);
+  }
+
   Iterator begin() const
   {
     return Iterator(result_ptr_, row_);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file statement_cache.cc
+ *  Bookkeeping of server-side prepared statements of one connection.
+ */
+
+#include "util/db/statement_cache.hh"
+
+#include <utility>
+
+namespace Database {
+
+StatementCache::StatementCache(std::size_t capacity, unsigned prepare_threshold)
+    : capacity_(capacity),
+      prepare_threshold_(prepare_threshold),
+      statement_counter_(0),
+      statistics_{0, 0, 0, 0}
+{ }
+
+StatementCache::Lookup StatementCache::use(const std::string& key)
+{
+    const auto index_itr = index_.find(key);
+    if (index_itr != index_.end())
+    {
+        const auto entry_itr = index_itr->second;
+        entries_.splice(entries_.begin(), entries_, entry_itr);
+        if (!entry_itr->statement_name.empty())
+        {
+            ++statistics_.hits;
+            return Lookup{&entry_itr->statement_name, false};
+        }
+        ++statistics_.misses;
+        ++entry_itr->uses;
+        return Lookup{nullptr, prepare_threshold_ <= entry_itr->uses};
+    }
+    ++statistics_.misses;
+    entries_.push_front(Entry{key, std::string(), 1});
+    index_.emplace(key, entries_.begin());
+    this->evict_over_capacity();
+    return Lookup{nullptr, prepare_threshold_ <= 1};
+}
+
+std::string StatementCache::make_statement_name()
+{
+    ++statement_counter_;
+    return "libfred_stmt_" + std::to_string(statement_counter_);
+}
+
+void StatementCache::set_prepared(const std::string& key, std::string statement_name)
+{
+    const auto index_itr = index_.find(key);
+    if (index_itr == index_.end())
+    {
+        obsolete_statements_.push_back(std::move(statement_name));
+        return;
+    }
+    index_itr->second->statement_name = std::move(statement_name);
+    ++statistics_.size;
+}
+
+void StatementCache::forget(const std::string& key)
+{
+    const auto index_itr = index_.find(key);
+    if (index_itr == index_.end())
+    {
+        return;
+    }
+    const auto entry_itr = index_itr->second;
+    if (!entry_itr->statement_name.empty())
+    {
+        obsolete_statements_.push_back(std::move(entry_itr->statement_name));
+        --statistics_.size;
+    }
+    index_.erase(index_itr);
+    entries_.erase(entry_itr);
+}
+
+std::vector<std::string> StatementCache::pop_obsolete_statements()
+{
+    std::vector<std::string> result;
+    result.swap(obsolete_statements_);
+    return result;
+}
+
+void StatementCache::clear()
+{
+    entries_.clear();
+    index_.clear();
+    obsolete_statements_.clear();
+    statistics_.size = 0;
+}
+
+bool StatementCache::is_enabled()const
+{
+    return 0 < capacity_;
+}
+
+void StatementCache::set_capacity(std::size_t capacity)
+{
+    capacity_ = capacity;
+    this->evict_over_capacity();
+}
+
+void StatementCache::set_prepare_threshold(unsigned prepare_threshold)
+{
+    prepare_threshold_ = prepare_threshold;
+}
+
+StatementCacheStatistics StatementCache::get_statistics()const
+{
+    return statistics_;
+}
+
+void StatementCache::evict_over_capacity()
+{
+    while (capacity_ < entries_.size())
+    {
+        auto& entry = entries_.back();
+        if (!entry.statement_name.empty())
+        {
+            obsolete_statements_.push_back(std::move(entry.statement_name));
+            --statistics_.size;
+            ++statistics_.evictions;
+        }
+        index_.erase(entry.key);
+        entries_.pop_back();
+    }
+}
+
+}//namespace Database
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file statement_cache.hh
+ *  Bookkeeping of server-side prepared statements of one connection.
+ */
+
+#ifndef STATEMENT_CACHE_HH_5E0B6A1C2F8D4E7A9C3B1D0F6A2E4C8B
+#define STATEMENT_CACHE_HH_5E0B6A1C2F8D4E7A9C3B1D0F6A2E4C8B
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Database {
+
+/**
+ * Per-query opt-out of the prepared statement cache.
+ */
+enum class StatementCaching
+{
+    enabled,
+    disabled
+};
+
+struct StatementCacheStatistics
+{
+    unsigned long long hits;///< executions of already prepared statements
+    unsigned long long misses;///< cacheable executions of not yet prepared statements
+    unsigned long long evictions;///< prepared statements dropped due to the capacity limit
+    std::size_t size;///< number of currently prepared statements
+};
+
+/**
+ * \class StatementCache
+ * \brief LRU cache of query texts and names of their server-side prepared statements
+ *
+ * The cache does not talk to the database itself, it only decides which queries are worth preparing
+ * and which prepared statements have to be deallocated. A query is prepared after it was executed
+ * prepare_threshold times.
+ */
+class StatementCache
+{
+public:
+    StatementCache(std::size_t capacity, unsigned prepare_threshold);
+
+    struct Lookup
+    {
+        const std::string* statement_name;///< name of the prepared statement, nullptr if not prepared yet
+        bool should_be_prepared;///< the query was used often enough to be prepared now
+    };
+
+    /**
+     * Records query usage.
+     * @param key query identification
+     * @return how to execute the query
+     */
+    Lookup use(const std::string& key);
+
+    /**
+     * Makes name for a new prepared statement, unique within the connection.
+     */
+    std::string make_statement_name();
+
+    /**
+     * Marks the query as prepared under given name.
+     */
+    void set_prepared(const std::string& key, std::string statement_name);
+
+    /**
+     * Drops the query from the cache, its prepared statement (if any) has to be deallocated.
+     */
+    void forget(const std::string& key);
+
+    /**
+     * @return names of prepared statements which are no longer in the cache and have to be deallocated
+     */
+    std::vector<std::string> pop_obsolete_statements();
+
+    /**
+     * Forgets everything, all server-side prepared statements are gone (e.g. connection reset).
+     */
+    void clear();
+
+    bool is_enabled()const;
+
+    void set_capacity(std::size_t capacity);
+
+    void set_prepare_threshold(unsigned prepare_threshold);
+
+    StatementCacheStatistics get_statistics()const;
+private:
+    struct Entry
+    {
+        std::string key;
+        std::string statement_name;
+        unsigned uses;
+    };
+    using Entries = std::list<Entry>;
+    void evict_over_capacity();
+    std::size_t capacity_;
+    unsigned prepare_threshold_;
+    Entries entries_;///< the most recently used entries are at the front
+    std::unordered_map<std::string, Entries::iterator> index_;
+    std::vector<std::string> obsolete_statements_;
+    unsigned long long statement_counter_;
+    StatementCacheStatistics statistics_;
+};
+
+}//namespace Database
+
+#endif//STATEMENT_CACHE_HH_5E0B6A1C2F8D4E7A9C3B1D0F6A2E4C8B
@@ -18,22 +18,43 @@
  */
 #include "util/password_storage/base64.hh"
 
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
-
-#include <cstring>
-
-#include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <stdexcept>
-#include <sstream>
 
 namespace PasswordStorage {
 
 namespace {
 
+constexpr char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+constexpr unsigned char invalid_sextet = 0xff;
+
+struct Base64DecodingTable
+{
+    Base64DecodingTable()
+    {
+        sextets.fill(invalid_sextet);
+        for (unsigned char idx = 0; idx < 64; ++idx)
+        {
+            sextets[static_cast<unsigned char>(base64_alphabet[idx])] = idx;
+        }
+    }
+    std::array<unsigned char, 256> sextets;
+};
+
+unsigned char get_sextet(char base64_char)
+{
+    static const Base64DecodingTable table;
+    const unsigned char sextet = table.sextets[static_cast<unsigned char>(base64_char)];
+    if (sextet == invalid_sextet)
+    {
+        throw std::runtime_error("invalid base64 encoded data");
+    }
+    return sextet;
+}
+
 struct RawData
 {
     std::unique_ptr<unsigned char[]> data;
@@ -42,33 +63,16 @@ struct RawData
 
 RawData get_raw_binary_data_from_base64_encoded_data(const std::string& src)
 {
-    typedef boost::archive::iterators::transform_width<
-                    boost::archive::iterators::binary_from_base64<const char*>, 8, 6> Base64DecodeIterator;
-
     RawData result;
-    unsigned int size = src.size();
-    // Remove the padding characters, cf. https://svn.boost.org/trac/boost/ticket/5629
-    if ((0 < size) && (src[size - 1] == '='))
+    const auto max_size = get_max_size_of_base64_decoded_data(src.size());
+    if (max_size == 0)
     {
-        --size;
-        if ((0 < size) && (src[size - 1] == '='))
-        {
-            --size;
-        }
-        if (size == 0)
-        {
-            result.data = nullptr;
-            result.size_of_data = 0;
-            return result;
-        }
+        result.data = nullptr;
+        result.size_of_data = 0;
+        return result;
     }
-    std::ostringstream data;
-    std::copy(Base64DecodeIterator(src.c_str()),
-              Base64DecodeIterator(src.c_str() + size),
-              std::ostream_iterator<char>(data));
-    result.data.reset(new unsigned char[data.str().length()]);
-    std::memcpy(result.data.get(), data.str().c_str(), data.str().length());
-    result.size_of_data = data.str().length();
+    result.data.reset(new unsigned char[max_size]);
+    result.size_of_data = decode_base64(src.data(), src.size(), result.data.get());
     return result;
 }
 
@@ -76,27 +80,99 @@ std::string get_base64_encoded_data_from_raw_binary_data(
         const unsigned char* data,
         int size_of_data)
 {
-    typedef boost::archive::iterators::base64_from_binary<
-                    boost::archive::iterators::transform_width<const unsigned char*, 6, 8>> Base64EncodeIterator;
+    std::string result(get_size_of_base64_encoded_data(size_of_data), '\0');
+    encode_base64(data, size_of_data, &result[0]);
+    return result;
+}
 
-    std::ostringstream result;
-    std::copy(Base64EncodeIterator(data),
-              Base64EncodeIterator(data + size_of_data),
-              std::ostream_iterator<char>(result));
+} // namespace PasswordStorage::{anonymous}
 
+std::size_t encode_base64(const unsigned char* data, std::size_t size_of_data, char* dst)
+{
+    char* const dst_begin = dst;
+    const unsigned char* const end_of_triplets = data + (size_of_data - (size_of_data % 3));
+    for (; data != end_of_triplets; data += 3)
+    {
+        const unsigned long triplet = (static_cast<unsigned long>(data[0]) << 16) |
+                                      (static_cast<unsigned long>(data[1]) << 8) |
+                                      static_cast<unsigned long>(data[2]);
+        dst[0] = base64_alphabet[(triplet >> 18) & 0x3f];
+        dst[1] = base64_alphabet[(triplet >> 12) & 0x3f];
+        dst[2] = base64_alphabet[(triplet >> 6) & 0x3f];
+        dst[3] = base64_alphabet[triplet & 0x3f];
+        dst += 4;
+    }
     switch (size_of_data % 3)
     {
-    case 0:
-        return result.str();
-    case 1:
-        return result.str() + "==";
-    case 2:
-        return result.str() + "=";
+        case 0:
+            break;
+        case 1:
+            dst[0] = base64_alphabet[data[0] >> 2];
+            dst[1] = base64_alphabet[(data[0] & 0x03) << 4];
+            dst[2] = '=';
+            dst[3] = '=';
+            dst += 4;
+            break;
+        case 2:
+            dst[0] = base64_alphabet[data[0] >> 2];
+            dst[1] = base64_alphabet[((data[0] & 0x03) << 4) | (data[1] >> 4)];
+            dst[2] = base64_alphabet[(data[1] & 0x0f) << 2];
+            dst[3] = '=';
+            dst += 4;
+            break;
     }
-    throw std::logic_error("unexpected result of modulo 3 operation");
+    return dst - dst_begin;
 }
 
-} // namespace PasswordStorage::{anonymous}
+std::size_t decode_base64(const char* base64_encoded_data, std::size_t size_of_base64_encoded_data, unsigned char* dst)
+{
+    std::size_t size = size_of_base64_encoded_data;
+    //padding characters are optional
+    if ((0 < size) && (base64_encoded_data[size - 1] == '='))
+    {
+        --size;
+        if ((0 < size) && (base64_encoded_data[size - 1] == '='))
+        {
+            --size;
+        }
+    }
+    if ((size % 4) == 1)
+    {
+        throw std::runtime_error("invalid base64 encoded data");
+    }
+    unsigned char* const dst_begin = dst;
+    const char* src = base64_encoded_data;
+    const char* const end_of_quartets = base64_encoded_data + (size - (size % 4));
+    for (; src != end_of_quartets; src += 4)
+    {
+        const unsigned long quartet = (static_cast<unsigned long>(get_sextet(src[0])) << 18) |
+                                      (static_cast<unsigned long>(get_sextet(src[1])) << 12) |
+                                      (static_cast<unsigned long>(get_sextet(src[2])) << 6) |
+                                      static_cast<unsigned long>(get_sextet(src[3]));
+        dst[0] = (quartet >> 16) & 0xff;
+        dst[1] = (quartet >> 8) & 0xff;
+        dst[2] = quartet & 0xff;
+        dst += 3;
+    }
+    switch (size % 4)
+    {
+        case 0:
+            break;
+        case 2:
+            dst[0] = (get_sextet(src[0]) << 2) | (get_sextet(src[1]) >> 4);
+            dst += 1;
+            break;
+        case 3:
+        {
+            const unsigned char sextet = get_sextet(src[1]);
+            dst[0] = (get_sextet(src[0]) << 2) | (sextet >> 4);
+            dst[1] = ((sextet & 0x0f) << 4) | (get_sextet(src[2]) >> 2);
+            dst += 2;
+            break;
+        }
+    }
+    return dst - dst_begin;
+}
 
 BinaryData::BinaryData()
     : size_of_raw_binary_data_()
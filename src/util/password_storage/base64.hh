@@ -19,11 +19,38 @@
 #ifndef BASE64_HH_B846DD2F17074D62AE03C4FAA9A1DE3F
 #define BASE64_HH_B846DD2F17074D62AE03C4FAA9A1DE3F
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
 namespace PasswordStorage {
 
+//number of characters of base64 encoded data (padding included) of given size
+constexpr std::size_t get_size_of_base64_encoded_data(std::size_t size_of_data)
+{
+    return 4 * ((size_of_data + 2) / 3);
+}
+
+//upper bound of size of data encoded by base64 into given number of characters
+constexpr std::size_t get_max_size_of_base64_decoded_data(std::size_t size_of_base64_encoded_data)
+{
+    return 3 * ((size_of_base64_encoded_data + 3) / 4);
+}
+
+/**
+ * Encodes data into caller provided buffer of get_size_of_base64_encoded_data(size_of_data) characters.
+ * @return number of characters written (no terminating null)
+ */
+std::size_t encode_base64(const unsigned char* data, std::size_t size_of_data, char* dst);
+
+/**
+ * Decodes base64 encoded data (padding is optional) into caller provided buffer
+ * of get_max_size_of_base64_decoded_data(size_of_base64_encoded_data) bytes.
+ * @return number of bytes written
+ * @throws std::runtime_error in case of invalid base64 encoded data
+ */
+std::size_t decode_base64(const char* base64_encoded_data, std::size_t size_of_base64_encoded_data, unsigned char* dst);
+
 class BinaryData;
 class Base64EncodedData;
 
@@ -20,14 +20,16 @@
 #include "util/password_storage/impl/check_equality.hh"
 #include "util/password_storage/impl/generate_salt.hh"
 #include "util/password_storage/base64.hh"
-#include "util/enum_conversion.hh"
+
+#include <boost/utility/string_view.hpp>
 
 #include <openssl/evp.h>
 
 #include <cstring>
 
+#include <array>
+#include <limits>
 #include <memory>
-#include <regex>
 #include <stdexcept>
 #include <sstream>
 #include <string>
@@ -59,31 +61,49 @@ int get_size_of_hash(Pbkdf2::HashFunction hash_function)
     throw std::logic_error("unsupported hash function");
 }
 
-BinaryData pbkdf2_compute_hash(
+//hash of get_size_of_hash(hash_function) bytes is written into hash_data
+void pbkdf2_compute_hash(
         int number_of_iterations,
         Pbkdf2::HashFunction hash_function,
-        const BinaryData& salt,
-        const std::string& plaintext_password)
+        const unsigned char* salt,
+        int size_of_salt,
+        const std::string& plaintext_password,
+        unsigned char* hash_data)
 {
-    const int size_of_hash = get_size_of_hash(hash_function);
-    auto hash_data = std::unique_ptr<unsigned char[]>(new unsigned char[size_of_hash]);
     const int result = ::PKCS5_PBKDF2_HMAC(plaintext_password.c_str(),
                                            plaintext_password.length(),
-                                           salt.get_raw_binary_data(),
-                                           salt.get_size_of_raw_binary_data(),
+                                           salt,
+                                           size_of_salt,
                                            number_of_iterations,
                                            call_hash_init_function(hash_function),
-                                           size_of_hash,
-                                           hash_data.get());
+                                           get_size_of_hash(hash_function),
+                                           hash_data);
     const bool hash_was_successfully_computed = result == 1;
     if (!hash_was_successfully_computed)
     {
         throw std::runtime_error("unable to compute hash");
     }
+}
+
+BinaryData pbkdf2_compute_hash(
+        int number_of_iterations,
+        Pbkdf2::HashFunction hash_function,
+        const BinaryData& salt,
+        const std::string& plaintext_password)
+{
+    const int size_of_hash = get_size_of_hash(hash_function);
+    auto hash_data = std::unique_ptr<unsigned char[]>(new unsigned char[size_of_hash]);
+    pbkdf2_compute_hash(
+            number_of_iterations,
+            hash_function,
+            salt.get_raw_binary_data(),
+            salt.get_size_of_raw_binary_data(),
+            plaintext_password,
+            hash_data.get());
     return BinaryData::from_raw_binary_data(std::move(hash_data), size_of_hash);
 }
 
-std::string to_hash_function_tag(Pbkdf2::HashFunction hash_function)
+const char* to_hash_function_tag(Pbkdf2::HashFunction hash_function)
 {
     switch (hash_function)
     {
@@ -93,13 +113,99 @@ std::string to_hash_function_tag(Pbkdf2::HashFunction hash_function)
     throw std::logic_error("unsupported hash function");
 }
 
-Pbkdf2::HashFunction to_hash_function(const std::string& hash_function_tag)
+Pbkdf2::HashFunction to_hash_function(boost::string_view hash_function_tag)
 {
     static const Pbkdf2::HashFunction dst_values[] =
             {
                 Pbkdf2::HashFunction::sha512
             };
-    return Conversion::Enums::inverse_transformation(hash_function_tag, dst_values, to_hash_function_tag);
+    for (const auto hash_function : dst_values)
+    {
+        if (hash_function_tag == to_hash_function_tag(hash_function))
+        {
+            return hash_function;
+        }
+    }
+    throw std::invalid_argument("conversion does not exist");
+}
+
+//single pass splitting of "$item0$item1$...$itemN" without allocation
+class DollarSeparatedItems
+{
+public:
+    explicit DollarSeparatedItems(boost::string_view data)
+        : rest_(data)
+    {
+        if (rest_.empty() || (rest_.front() != delimiter))
+        {
+            throw std::runtime_error("corrupted data");
+        }
+        rest_.remove_prefix(1);
+    }
+    bool has_next()const
+    {
+        return rest_.data() != nullptr;
+    }
+    boost::string_view get_next()
+    {
+        if (!has_next())
+        {
+            throw std::runtime_error("corrupted data");
+        }
+        const auto delimiter_pos = rest_.find(delimiter);
+        if (delimiter_pos == boost::string_view::npos)
+        {
+            const auto item = rest_;
+            rest_ = boost::string_view();
+            return item;
+        }
+        const auto item = rest_.substr(0, delimiter_pos);
+        rest_.remove_prefix(delimiter_pos + 1);
+        return item;
+    }
+private:
+    static constexpr char delimiter = '$';
+    boost::string_view rest_;
+};
+
+constexpr char DollarSeparatedItems::delimiter;
+
+int to_number_of_iterations(boost::string_view data)
+{
+    if (data.empty())
+    {
+        throw std::runtime_error("corrupted data");
+    }
+    int value = 0;
+    for (const char digit : data)
+    {
+        if ((digit < '0') || ('9' < digit) ||
+            (((std::numeric_limits<int>::max() - (digit - '0')) / 10) < value))
+        {
+            throw std::runtime_error("corrupted data");
+        }
+        value = 10 * value + (digit - '0');
+    }
+    return value;
+}
+
+constexpr int max_size_of_hash = 512 / 8;
+constexpr int max_size_of_salt = 1024;
+
+//buffer for decoding of base64 encoded data of given size, padding characters included
+constexpr std::size_t max_size_of_decoded(std::size_t size_of_data)
+{
+    return get_max_size_of_base64_decoded_data(get_size_of_base64_encoded_data(size_of_data));
+}
+
+template <std::size_t max_size>
+int decode_base64_into(boost::string_view base64_encoded_data, std::array<unsigned char, max_size>& dst)
+{
+    if (max_size < get_max_size_of_base64_decoded_data(base64_encoded_data.size()))
+    {
+        throw std::runtime_error("corrupted data");
+    }
+    return decode_base64(base64_encoded_data.data(), base64_encoded_data.size(), dst.data());
 }
 
 } // namespace PasswordStorage::Impl::{anonymous}
@@ -142,78 +248,37 @@ CheckResult Pbkdf2::check_password_correctness(
         const std::string& _plaintext_password,
         const PasswordData& _encrypted_password_data)//"$pbkdf2$<hashed_by>$<number_of_iterations>$<salt::base64>$<hash::base64>"
 {
-    static const std::regex delimiter("\\$");// prevents '$' special meaning in regex
-    const std::string encrypted_password_data = _encrypted_password_data.get_value();
-    auto items_itr = std::sregex_token_iterator(
-            encrypted_password_data.begin(),
-            encrypted_password_data.end(),
-            delimiter,
-            -1);
-    const auto items_end = std::sregex_token_iterator();
-    if ((items_itr == items_end) ||
-        (items_itr->length() != 0))//std::sub_match does not have method empty()
-    {
-        throw std::runtime_error("corrupted data");
-    }
-
-    ++items_itr;
-    if (items_itr == items_end)
-    {
-        throw std::runtime_error("corrupted data");
-    }
-    if (*items_itr != pbkdf2_tag)
+    DollarSeparatedItems items(_encrypted_password_data.get_value());
+    if (items.get_next() != pbkdf2_tag)
     {
         return CheckResult::algorithm_does_not_fit;
     }
-
-    ++items_itr;
-    if (items_itr == items_end)
-    {
-        throw std::runtime_error("corrupted data");
-    }
-    const HashFunction hash_function = to_hash_function(*items_itr);
+    const HashFunction hash_function = to_hash_function(items.get_next());
     const int size_of_hash = get_size_of_hash(hash_function);
+    const int number_of_iterations = to_number_of_iterations(items.get_next());
 
-    ++items_itr;
-    if (items_itr == items_end)
-    {
-        throw std::runtime_error("corrupted data");
-    }
-    const int number_of_iterations = std::stoi(*items_itr, nullptr, 10);
+    std::array<unsigned char, max_size_of_decoded(max_size_of_salt)> salt;
+    const int size_of_salt = decode_base64_into(items.get_next(), salt);
 
-    ++items_itr;
-    if (items_itr == items_end)
-    {
-        throw std::runtime_error("corrupted data");
-    }
-    const BinaryData salt(Base64EncodedData::from_base64_encoded_string(*items_itr));
-
-    ++items_itr;
-    if (items_itr == items_end)
-    {
-        throw std::runtime_error("corrupted data");
-    }
-    const std::string base64_encoded_hash = *items_itr;
-    ++items_itr;
-    if (items_itr != items_end)
-    {
-        throw std::runtime_error("corrupted data");
-    }
-    const BinaryData stored_hash(Base64EncodedData::from_base64_encoded_string(base64_encoded_hash));
-    if (stored_hash.get_size_of_raw_binary_data() != size_of_hash)
+    std::array<unsigned char, max_size_of_decoded(max_size_of_hash)> stored_hash;
+    const int size_of_stored_hash = decode_base64_into(items.get_next(), stored_hash);
+    if (items.has_next() || (size_of_stored_hash != size_of_hash))
     {
         throw std::runtime_error("corrupted data");
     }
 
-    const BinaryData computed_hash = pbkdf2_compute_hash(
-                number_of_iterations,
-                hash_function,
-                salt,
-                _plaintext_password);
+    std::array<unsigned char, max_size_of_hash> computed_hash;
+    pbkdf2_compute_hash(
+            number_of_iterations,
+            hash_function,
+            salt.data(),
+            size_of_salt,
+            _plaintext_password,
+            computed_hash.data());
 
     check_equality(
-            computed_hash.get_raw_binary_data(),
-            stored_hash.get_raw_binary_data(),
+            computed_hash.data(),
+            stored_hash.data(),
             size_of_hash,
             throw_incorrect_password_exception_on_nonezero_value<unsigned char>);
     return CheckResult::password_is_correct;
@@ -60,8 +60,15 @@ CheckResult Plaintext::check_password_correctness(
         return CheckResult::algorithm_does_not_fit;
     }
 
-    const std::string stored_password = alg_tag_start + std::strlen(plaintext_prefix);
-    throw_incorrect_password_exception_on_nonezero_value(_plaintext_password != stored_password);
+    const char* const stored_password = alg_tag_start + std::strlen(plaintext_prefix);
+    const std::size_t size_of_stored_password = std::strlen(stored_password);
+    throw_incorrect_password_exception_on_nonezero_value(
+            static_cast<unsigned char>(_plaintext_password.size() != size_of_stored_password));
+    check_equality(
+            reinterpret_cast<const unsigned char*>(_plaintext_password.c_str()),
+            reinterpret_cast<const unsigned char*>(stored_password),
+            size_of_stored_password,
+            throw_incorrect_password_exception_on_nonezero_value<unsigned char>);
     return CheckResult::password_is_correct;
 }
 
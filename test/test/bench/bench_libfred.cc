@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/bench/benchmark.hh"
+
+#include "libfred/opcontext.hh"
+#include "libfred/poll/create_low_credit_messages.hh"
+#include "libfred/poll/create_state_messages.hh"
+#include "libfred/registrable_object/contact/create_contact.hh"
+#include "libfred/registrable_object/contact/merge_contact.hh"
+#include "libfred/registrable_object/contact/update_contact.hh"
+#include "libfred/registrable_object/domain/check_domain.hh"
+#include "libfred/registrable_object/domain/create_domain.hh"
+#include "libfred/registrable_object/domain/info_domain.hh"
+#include "test/setup/fixtures.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <utility>
+
+namespace {
+
+struct HasBenchObjects : Test::instantiate_db_template
+{
+    HasBenchObjects()
+        : Test::instantiate_db_template{},
+          ctx{},
+          registrar{ctx, "REG-BENCH", false, false},
+          system_registrar{ctx, "REG-CZNIC", true, false},
+          contact{ctx, "CONTACT-BENCH", registrar},
+          domain{ctx, Test::CzZone::fqdn("bench"), registrar, contact}
+    { }
+    LibFred::OperationContextCreator ctx;
+    Test::HasRegistrar registrar;
+    Test::HasRegistrar system_registrar;
+    Test::HasContact contact;
+    Test::HasDomain domain;
+};
+
+std::string make_contact(const LibFred::OperationContext& ctx, const std::string& handle, const Test::HasRegistrar& registrar)
+{
+    LibFred::CreateContact{handle, registrar.handle}
+            .set_name("Contact Bench")
+            .set_email("contact@bench.cz")
+            .exec(ctx);
+    return handle;
+}
+
+}//namespace {anonymous}
+
+BOOST_FIXTURE_TEST_SUITE(BenchLibFred, HasBenchObjects)
+
+BOOST_AUTO_TEST_CASE(info_domain_by_fqdn)
+{
+    Test::Bench::measure("BenchLibFred/info_domain_by_fqdn", Test::Bench::Kind::db, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(LibFred::InfoDomainByFqdn{domain.fqdn}.exec(ctx).info_domain_data.id);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(create_domain)
+{
+    Test::Bench::measure(
+            "BenchLibFred/create_domain",
+            Test::Bench::Kind::db,
+            [](unsigned idx) { return Test::CzZone::fqdn("bench-create-" + std::to_string(idx)); },
+            [&](const std::string& fqdn)
+            {
+                Test::Bench::do_not_optimize(
+                        LibFred::CreateDomain{fqdn, registrar.handle, contact.handle}.exec(ctx).create_object_result.object_id);
+            });
+}
+
+BOOST_AUTO_TEST_CASE(check_domain)
+{
+    const std::string free_fqdn = Test::CzZone::fqdn("bench-free");
+    Test::Bench::measure("BenchLibFred/check_domain_registered", Test::Bench::Kind::db, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(LibFred::CheckDomain{domain.fqdn}.is_registered(ctx));
+    });
+    Test::Bench::measure("BenchLibFred/check_domain_available", Test::Bench::Kind::db, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(LibFred::CheckDomain{free_fqdn}.is_available(ctx));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(update_contact)
+{
+    Test::Bench::measure("BenchLibFred/update_contact", Test::Bench::Kind::db, [&](unsigned idx)
+    {
+        Test::Bench::do_not_optimize(
+                LibFred::UpdateContactByHandle{contact.handle, registrar.handle}
+                        .set_name("Contact Bench " + std::to_string(idx))
+                        .exec(ctx));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(merge_contact)
+{
+    Test::Bench::measure(
+            "BenchLibFred/merge_contact",
+            Test::Bench::Kind::db,
+            [&](unsigned idx)
+            {
+                return std::make_pair(
+                        make_contact(ctx, "BENCH-SRC-" + std::to_string(idx), registrar),
+                        make_contact(ctx, "BENCH-DST-" + std::to_string(idx), registrar));
+            },
+            [&](const std::pair<std::string, std::string>& contacts)
+            {
+                Test::Bench::do_not_optimize(
+                        LibFred::MergeContact{contacts.first, contacts.second, system_registrar.handle}
+                                .exec(ctx).contactid.src_contact_id);
+            });
+}
+
+BOOST_AUTO_TEST_CASE(poll_generators)
+{
+    Test::Bench::measure("BenchLibFred/create_state_messages", Test::Bench::Kind::db, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(LibFred::Poll::CreateStateMessages{{}, boost::none}.exec(ctx));
+    });
+    Test::Bench::measure("BenchLibFred/create_low_credit_messages", Test::Bench::Kind::db, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(LibFred::Poll::CreateLowCreditMessages{}.exec(ctx));
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()//BenchLibFred
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/bench/benchmark.hh"
+
+#include "libfred/registrable_object/domain/domain_name.hh"
+#include "util/db/param_query_composition.hh"
+#include "util/db/value.hh"
+#include "util/decimal/decimal.hh"
+#include "util/flagset.hh"
+#include "util/password_storage.hh"
+#include "util/password_storage/base64.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(BenchUtil)
+
+namespace {
+
+template <const char* name>
+struct Flag
+{
+    static std::string to_string() { return name; }
+};
+
+namespace FlagName {
+
+extern const char linked[] = "linked";
+extern const char validated[] = "validated";
+extern const char server_blocked[] = "serverBlocked";
+extern const char delete_prohibited[] = "serverDeleteProhibited";
+extern const char update_prohibited[] = "serverUpdateProhibited";
+
+}//namespace {anonymous}::FlagName
+
+using States = Util::FlagSet<
+        struct StatesTag,
+        Flag<FlagName::linked>,
+        Flag<FlagName::validated>,
+        Flag<FlagName::server_blocked>,
+        Flag<FlagName::delete_prohibited>,
+        Flag<FlagName::update_prohibited>>;
+
+const std::string fqdn = "some-long-label.second-level.nic.cz";
+
+}//namespace {anonymous}
+
+BOOST_AUTO_TEST_CASE(domain_name_parsing)
+{
+    Test::Bench::measure("BenchUtil/domain_name_parsing", Test::Bench::Kind::cpu, [](unsigned)
+    {
+        Test::Bench::do_not_optimize(LibFred::Domain::DomainName{fqdn});
+    });
+}
+
+BOOST_AUTO_TEST_CASE(domain_name_validator)
+{
+    const LibFred::Domain::DomainName domain_name{fqdn};
+    LibFred::Domain::DomainNameValidator validator;
+    validator.set_checker_names({
+            LibFred::Domain::DNCHECK_RFC1035_PREFERRED_SYNTAX,
+            LibFred::Domain::DNCHECK_NO_CONSECUTIVE_HYPHENS,
+            LibFred::Domain::DNCHECK_SINGLE_DIGIT_LABELS_ONLY,
+            LibFred::Domain::DNCHECK_NO_IDN_PUNYCODE});
+    Test::Bench::measure("BenchUtil/domain_name_validator", Test::Bench::Kind::cpu, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(validator.exec(domain_name, 1));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(check_password)
+{
+    const auto encrypted_password = PasswordStorage::encrypt_password_by_preferred_method("correct password");
+    Test::Bench::measure("BenchUtil/check_password", Test::Bench::Kind::db, [&](unsigned)
+    {
+        PasswordStorage::check_password("correct password", encrypted_password);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(base64)
+{
+    std::array<unsigned char, 48> data;
+    for (std::size_t idx = 0; idx < data.size(); ++idx)
+    {
+        data[idx] = static_cast<unsigned char>(idx * 7);
+    }
+    std::array<char, PasswordStorage::get_size_of_base64_encoded_data(data.size())> encoded;
+    std::array<unsigned char, PasswordStorage::get_max_size_of_base64_decoded_data(encoded.size())> decoded;
+    Test::Bench::measure("BenchUtil/base64_encode", Test::Bench::Kind::cpu, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(PasswordStorage::encode_base64(data.data(), data.size(), encoded.data()));
+    });
+    Test::Bench::measure("BenchUtil/base64_decode", Test::Bench::Kind::cpu, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(PasswordStorage::decode_base64(encoded.data(), encoded.size(), decoded.data()));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(decimal_arithmetic)
+{
+    const Decimal price{"1234.56"};
+    const Decimal vat_rate{"0.21"};
+    const Decimal quantity{"12"};
+    Test::Bench::measure("BenchUtil/decimal_arithmetic", Test::Bench::Kind::cpu, [&](unsigned)
+    {
+        Decimal total = price * quantity;
+        total += total * vat_rate;
+        total /= quantity;
+        Test::Bench::do_not_optimize(total.get_string());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(flagset)
+{
+    Test::Bench::measure("BenchUtil/flagset", Test::Bench::Kind::cpu, [](unsigned idx)
+    {
+        States states;
+        states.set<Flag<FlagName::linked>>((idx & 1) != 0);
+        states.set<Flag<FlagName::server_blocked>, Flag<FlagName::update_prohibited>>((idx & 2) != 0);
+        Test::Bench::do_not_optimize(states.are_set_any_of<Flag<FlagName::server_blocked>, Flag<FlagName::validated>>());
+        Test::Bench::do_not_optimize(states.are_unset_all_of<Flag<FlagName::linked>, Flag<FlagName::delete_prohibited>>());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(database_value_conversions)
+{
+    const Database::Value id{"1234567890", false};
+    const Database::Value flag{"t", false};
+    const Database::Value text{"some text value", false};
+    const Database::Value null;
+    Test::Bench::measure("BenchUtil/database_value_conversions", Test::Bench::Kind::cpu, [&](unsigned)
+    {
+        Test::Bench::do_not_optimize(static_cast<unsigned long long>(id));
+        Test::Bench::do_not_optimize(static_cast<bool>(flag));
+        Test::Bench::do_not_optimize(static_cast<std::string>(text));
+        Test::Bench::do_not_optimize(null.isnull());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(param_query_composition)
+{
+    const std::vector<std::string> handles = {"CONTACT-1", "CONTACT-2", "CONTACT-3", "CONTACT-4"};
+    Test::Bench::measure("BenchUtil/param_query_composition", Test::Bench::Kind::cpu, [&](unsigned idx)
+    {
+        const Database::ReusableParameter object_id(idx, "bigint");
+        const auto query = Database::ParamQuery(
+                "SELECT h.idx, oreg.id FROM UNNEST(").param_text_array(handles)(") WITH ORDINALITY AS h(handle, idx) "
+                "JOIN object_registry oreg ON oreg.name = UPPER(h.handle) AND oreg.id > ").param(object_id)(" "
+                "WHERE oreg.erdate IS NULL AND oreg.id <> ").param(object_id)(" "
+                "AND oreg.type = ").param_bigint(1)(" "
+                "ORDER BY oreg.id").get_query();
+        Test::Bench::do_not_optimize(query.first);
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()//BenchUtil
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/bench/benchmark.hh"
+#include "test/bench/handle_benchmark_args.hh"
+
+#include "test/fake-src/util/cfg/config_handler_decl.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Test {
+namespace Bench {
+
+namespace {
+
+std::vector<Summary>& get_report()
+{
+    static std::vector<Summary> report;
+    return report;
+}
+
+std::chrono::nanoseconds get_percentile(const std::vector<std::chrono::nanoseconds>& sorted_samples, unsigned percent)
+{
+    const auto rank = static_cast<std::size_t>(std::ceil(percent * sorted_samples.size() / 100.0));
+    return sorted_samples[std::max<std::size_t>(rank, 1) - 1];
+}
+
+std::string to_json_string(const std::string& src)
+{
+    std::ostringstream out;
+    out << '"';
+    for (const char c : src)
+    {
+        switch (c)
+        {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                }
+                else
+                {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+}//namespace Test::Bench::{anonymous}
+
+Summary summarize(std::string name, std::vector<std::chrono::nanoseconds> samples)
+{
+    if (samples.empty())
+    {
+        throw std::runtime_error("no samples of benchmark " + name);
+    }
+    std::sort(begin(samples), end(samples));
+    std::chrono::nanoseconds sum{0};
+    for (const auto& sample : samples)
+    {
+        sum += sample;
+    }
+    Summary summary;
+    summary.name = std::move(name);
+    summary.iterations = samples.size();
+    summary.min = samples.front();
+    summary.mean = sum / samples.size();
+    summary.p50 = get_percentile(samples, 50);
+    summary.p90 = get_percentile(samples, 90);
+    summary.p95 = get_percentile(samples, 95);
+    summary.p99 = get_percentile(samples, 99);
+    summary.max = samples.back();
+    return summary;
+}
+
+void add_to_report(Summary summary)
+{
+    get_report().push_back(std::move(summary));
+}
+
+void write_report(std::ostream& out)
+{
+    out << "{\"unit\": \"ns\", \"benchmarks\": [";
+    bool is_first = true;
+    for (const auto& summary : get_report())
+    {
+        out << (is_first ? "\n" : ",\n")
+            << "  {\"name\": " << to_json_string(summary.name) << ", "
+            << "\"iterations\": " << summary.iterations << ", "
+            << "\"min\": " << summary.min.count() << ", "
+            << "\"mean\": " << summary.mean.count() << ", "
+            << "\"p50\": " << summary.p50.count() << ", "
+            << "\"p90\": " << summary.p90.count() << ", "
+            << "\"p95\": " << summary.p95.count() << ", "
+            << "\"p99\": " << summary.p99.count() << ", "
+            << "\"max\": " << summary.max.count() << "}";
+        is_first = false;
+    }
+    out << "\n]}" << std::endl;
+}
+
+void write_report(const std::string& file_name)
+{
+    if (file_name == "-")
+    {
+        write_report(std::cout);
+        return;
+    }
+    std::ofstream out{file_name};
+    if (!out)
+    {
+        throw std::runtime_error("unable to open " + file_name);
+    }
+    write_report(out);
+}
+
+unsigned get_warmup_iterations()
+{
+    return CfgArgs::instance()->get_handler_ptr_by_type<HandleBenchmarkArgs>()->warmup_iterations;
+}
+
+unsigned get_iterations(Kind kind)
+{
+    const auto args = CfgArgs::instance()->get_handler_ptr_by_type<HandleBenchmarkArgs>();
+    switch (kind)
+    {
+        case Kind::cpu:
+            return args->iterations;
+        case Kind::db:
+            return args->db_iterations;
+    }
+    throw std::runtime_error("unexpected kind of benchmark");
+}
+
+}//namespace Test::Bench
+}//namespace Test
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  measuring of benchmarks and reporting of their results
+ */
+
+#ifndef BENCHMARK_HH_23BF80589A2247C18624C50E3814F760
+#define BENCHMARK_HH_23BF80589A2247C18624C50E3814F760
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Test {
+namespace Bench {
+
+enum class Kind
+{
+    cpu,
+    db
+};
+
+struct Summary
+{
+    std::string name;
+    std::size_t iterations;
+    std::chrono::nanoseconds min;
+    std::chrono::nanoseconds mean;
+    std::chrono::nanoseconds p50;
+    std::chrono::nanoseconds p90;
+    std::chrono::nanoseconds p95;
+    std::chrono::nanoseconds p99;
+    std::chrono::nanoseconds max;
+};
+
+/**
+ * Computes statistics of measured durations, percentiles by nearest-rank method.
+ */
+Summary summarize(std::string name, std::vector<std::chrono::nanoseconds> samples);
+
+/**
+ * Appends results of one benchmark into process-wide report.
+ */
+void add_to_report(Summary summary);
+
+/**
+ * Writes process-wide report in JSON format:
+ * {"unit": "ns", "benchmarks": [{"name": ..., "iterations": ..., "min": ..., "mean": ..., "p50": ..., "p90": ..., "p95": ..., "p99": ..., "max": ...}, ...]}
+ */
+void write_report(std::ostream& out);
+
+/**
+ * Writes process-wide report into given file, "-" means standard output.
+ */
+void write_report(const std::string& file_name);
+
+unsigned get_warmup_iterations();
+unsigned get_iterations(Kind kind);
+
+/**
+ * Prevents compiler from optimizing away computation of the value.
+ */
+template <typename T>
+void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Measures durations of given operation, prepared input is not measured.
+ * @param name of the benchmark in the report
+ * @param kind selects number of measured iterations
+ * @param prepare is called with index of iteration and returns input of the operation
+ * @param operation is called with prepared input
+ */
+template <typename Prepare, typename Operation>
+void measure(const std::string& name, Kind kind, Prepare&& prepare, Operation&& operation)
+{
+    const unsigned warmup_iterations = get_warmup_iterations();
+    const unsigned iterations = get_iterations(kind);
+    std::vector<std::chrono::nanoseconds> samples;
+    samples.reserve(iterations);
+    for (unsigned idx = 0; idx < (warmup_iterations + iterations); ++idx)
+    {
+        auto input = prepare(idx);
+        const auto start = std::chrono::steady_clock::now();
+        operation(input);
+        const auto stop = std::chrono::steady_clock::now();
+        if (warmup_iterations <= idx)
+        {
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start));
+        }
+    }
+    add_to_report(summarize(name, std::move(samples)));
+}
+
+/**
+ * Measures durations of given operation called with index of iteration.
+ */
+template <typename Operation>
+void measure(const std::string& name, Kind kind, Operation&& operation)
+{
+    measure(name, kind, [](unsigned idx) { return idx; }, std::forward<Operation>(operation));
+}
+
+}//namespace Test::Bench
+}//namespace Test
+
+#endif//BENCHMARK_HH_23BF80589A2247C18624C50E3814F760
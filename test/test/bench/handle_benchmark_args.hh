@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ *  @file
+ *  benchmark options handler
+ */
+
+#ifndef HANDLE_BENCHMARK_ARGS_HH_90BFE3A9C0394358AA30570FA9E1D453
+#define HANDLE_BENCHMARK_ARGS_HH_90BFE3A9C0394358AA30570FA9E1D453
+
+#include "test/fake-src/util/cfg/faked_args.hh"
+#include "test/fake-src/util/cfg/handle_args.hh"
+
+#include <boost/program_options.hpp>
+
+#include <memory>
+#include <string>
+
+/**
+ * \class HandleBenchmarkArgs
+ * \brief benchmark options handler
+ */
+class HandleBenchmarkArgs : public HandleArgs
+{
+public:
+    unsigned warmup_iterations;
+    unsigned iterations;
+    unsigned db_iterations;
+    std::string output;
+
+    std::shared_ptr<boost::program_options::options_description> get_options_description()
+    {
+        std::shared_ptr<boost::program_options::options_description> cfg_opts(
+                new boost::program_options::options_description(
+                        std::string("Benchmark configuration")));
+        cfg_opts->add_options()
+                ("bench.warmup", boost::program_options
+                         ::value<unsigned>()->default_value(10)
+                          , "number of unmeasured iterations preceding the measured ones")
+                ("bench.iterations", boost::program_options
+                         ::value<unsigned>()->default_value(10000)
+                          , "number of measured iterations of cpu benchmarks")
+                ("bench.db_iterations", boost::program_options
+                         ::value<unsigned>()->default_value(200)
+                          , "number of measured iterations of database benchmarks")
+                ("bench.output", boost::program_options
+                         ::value<std::string>()->default_value("fred-bench.json")
+                          , "file the JSON report is written into, \"-\" for standard output")
+                ;
+        return cfg_opts;
+    }
+    void handle(int argc, char* argv[], FakedArgs& fa)
+    {
+        boost::program_options::variables_map vm;
+        handler_parse_args()(get_options_description(), vm, argc, argv, fa);
+
+        warmup_iterations = vm["bench.warmup"].as<unsigned>();
+        iterations = vm["bench.iterations"].as<unsigned>();
+        db_iterations = vm["bench.db_iterations"].as<unsigned>();
+        output = vm["bench.output"].as<std::string>();
+    }
+};
+
+#endif
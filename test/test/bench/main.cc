@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE FredBench
+
+#include "config.h"
+
+#include "test/bench/benchmark.hh"
+#include "test/bench/handle_benchmark_args.hh"
+
+#include "test/setup/cfg.hh"
+#include "test/setup/fixtures.hh"
+
+#include "test/fake-src/util/cfg/config_handler.hh"
+
+#include "test/fake-src/util/cfg/handle_logging_args.hh"
+#include "test/fake-src/util/cfg/handle_database_args.hh"
+
+#include "src/libfred/opcontext.hh"
+
+// dynamic library version
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+void database_setup()
+{
+    LibFred::OperationContextCreator ctx;
+    Test::CzZone{ctx};
+    Test::CzEnumZone{ctx};
+    Test::InitDomainNameCheckers{ctx};
+    Test::SystemRegistrar{ctx, Test::Setter::system_registrar(
+            LibFred::CreateRegistrar{
+                    "REG-CZNIC",
+                    "Name REG-CZNIC",
+                    "Organization REG-CZNIC",
+                    {"Street REG-CZNIC"},
+                    "City REG-CZNIC",
+                    "PostalCode REG-CZNIC",
+                    "Telephone REG-CZNIC",
+                    "Email REG-CZNIC",
+                    "Url REG-CZNIC",
+                    "Dic REG-CZNIC"})};
+    ctx.get_conn().exec("UPDATE enum_parameters SET val = 'CZ' WHERE name = 'roid_suffix'");
+    ctx.commit_transaction();
+}
+
+class GlobalFixture
+{
+public:
+    GlobalFixture()
+        : database_administrator_{
+                []()
+                {
+                    const HandlerPtrVector config_handlers = {
+                            std::make_shared<HandleLoggingArgs>(),
+                            std::make_shared<HandleDatabaseArgs>(),
+                            std::make_shared<Test::HandleAdminDatabaseArgs>(),
+                            std::make_shared<HandleBenchmarkArgs>()};
+                    return Test::Cfg::handle_command_line_args(config_handlers, database_setup);
+                }()}
+    {
+        FREDLOG_INFO("benchmarks start");
+    }
+    ~GlobalFixture()
+    {
+        try
+        {
+            Test::Bench::write_report(CfgArgs::instance()->get_handler_ptr_by_type<HandleBenchmarkArgs>()->output);
+            FREDLOG_INFO("benchmarks done");
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "unable to write benchmark report: " << e.what() << std::endl;
+        }
+        catch (...) { }
+    }
+private:
+    Test::Cfg::DatabaseAdministrator database_administrator_;
+    Test::create_db_template create_db_template;
+};
+
+}//namespace {anonymous}
+
+BOOST_GLOBAL_FIXTURE(GlobalFixture);
@@ -24,12 +24,14 @@
 #include "libfred/opcontext.hh"
 #include "libfred/registrable_object/contact/find_contact_duplicates.hh"
 #include "libfred/registrable_object/contact/merge_contact.hh"
+#include "libfred/registrable_object/contact/merge_contact_selection.hh"
 
 #include "util/map_at.hh"
 #include "util/printable.hh"
 #include "util/util.hh"
 
 #include <boost/test/unit_test.hpp>
+#include <boost/algorithm/string/join.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include <map>
@@ -2124,6 +2126,67 @@ BOOST_FIXTURE_TEST_CASE(test_find_contact_duplicates, merge_fixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(test_find_all_contact_duplicates, merge_fixture)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const auto all_duplicates = ::LibFred::Contact::FindContactDuplicates{}.exec_all(ctx);
+    BOOST_REQUIRE(!all_duplicates.empty());
+    BOOST_CHECK(all_duplicates.front() == ::LibFred::Contact::FindContactDuplicates{}.exec(ctx));
+    std::set<std::string> seen_contacts;
+    for (const auto& duplicates : all_duplicates)
+    {
+        BOOST_REQUIRE_LT(1, duplicates.size());
+        const auto first_contact = *duplicates.begin();
+        for (const auto& contact : duplicates)
+        {
+            BOOST_CHECK(seen_contacts.insert(contact).second);
+            BOOST_CHECK(!::LibFred::MergeContact::DefaultDiffContacts{}(ctx, first_contact, contact));
+        }
+    }
+
+    const auto excluded_contact = *all_duplicates.front().begin();
+    const auto duplicates_without_excluded = ::LibFred::Contact::FindContactDuplicates{}
+            .set_exclude_contacts({excluded_contact})
+            .exec_all(ctx);
+    BOOST_CHECK_EQUAL(duplicates_without_excluded.size() + 1, all_duplicates.size());
+    for (const auto& duplicates : duplicates_without_excluded)
+    {
+        BOOST_CHECK_EQUAL(duplicates.count(excluded_contact), 0);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_merge_contact_selection, merge_fixture)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const auto duplicates = ::LibFred::Contact::FindContactDuplicates{}.exec(ctx);
+    BOOST_REQUIRE_LT(1, duplicates.size());
+    const std::vector<std::string> candidates(duplicates.begin(), duplicates.end());
+
+    const auto recently_created = ctx.get_conn().exec_params(
+            "SELECT name FROM object_registry "
+            "WHERE name = ANY($1::TEXT[]) AND erdate IS NULL "
+            "ORDER BY crdate DESC, id DESC LIMIT 1",
+            Database::query_param_list("{" + boost::algorithm::join(candidates, ",") + "}"));
+    BOOST_REQUIRE_EQUAL(recently_created.size(), 1);
+    const auto selected = ::LibFred::MergeContactSelection(
+            candidates,
+            { "nonexistent filter", ::LibFred::MCS_FILTER_RECENTLY_CREATED }).exec(ctx);
+    BOOST_CHECK_EQUAL(selected.handle, static_cast<std::string>(recently_created[0][0]));
+    BOOST_CHECK_EQUAL(selected.filter, ::LibFred::MCS_FILTER_RECENTLY_CREATED);
+
+    const auto& filter = ::LibFred::get_default_contact_selection_filter_factory();
+    BOOST_CHECK(filter[::LibFred::MCS_FILTER_RECENTLY_CREATED](ctx, candidates) ==
+                std::vector<std::string>{static_cast<std::string>(recently_created[0][0])});
+    BOOST_CHECK(filter[::LibFred::MCS_FILTER_NOT_REGCZNIC](ctx, candidates) == candidates);
+
+    BOOST_CHECK_THROW(
+            ::LibFred::MergeContactSelection({}, { ::LibFred::MCS_FILTER_RECENTLY_CREATED }).exec(ctx),
+            ::LibFred::MergeContactSelection::NoContactHandles);
+    BOOST_CHECK_THROW(
+            ::LibFred::MergeContactSelection(candidates, { }).exec(ctx),
+            ::LibFred::MergeContactSelection::TooManyContactHandlesLeft);
+}
+
 BOOST_AUTO_TEST_SUITE_END()//ObjectCombinations
 
 /**
@@ -30,6 +30,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <string>
+#include <vector>
 
 BOOST_FIXTURE_TEST_SUITE(TestDomainName, Test::instantiate_db_template)
 
@@ -266,4 +267,20 @@ BOOST_AUTO_TEST_CASE(test_domain_name_validator)
     BOOST_CHECK( !DomainNameValidator().add(::LibFred::Domain::DNCHECK_SINGLE_DIGIT_LABELS_ONLY).add(::LibFred::Domain::DNCHECK_RFC1035_PREFERRED_SYNTAX).exec(DomainName("8.4.1.0.6.4.9.7.4.0.2.4.e164.arpa"), 5));
 }
 
+BOOST_AUTO_TEST_CASE(test_cached_domain_name_validation_config)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const std::string zone = "cz";
+
+    const std::vector<std::string> first_config = { ::LibFred::Domain::DNCHECK_NO_CONSECUTIVE_HYPHENS };
+    ::LibFred::Domain::set_domain_name_validation_config_into_database(ctx, zone, first_config);
+    BOOST_CHECK(::LibFred::Domain::get_cached_domain_name_validation_config_for_zone(ctx, zone) == first_config);
+    BOOST_CHECK(::LibFred::Domain::get_cached_domain_name_validation_config_for_zone(ctx, "CZ") == first_config);
+
+    //changed configuration must not be served from cache
+    const std::vector<std::string> second_config = { ::LibFred::Domain::DNCHECK_RFC1035_PREFERRED_SYNTAX };
+    ::LibFred::Domain::set_domain_name_validation_config_into_database(ctx, zone, second_config);
+    BOOST_CHECK(::LibFred::Domain::get_cached_domain_name_validation_config_for_zone(ctx, zone) == second_config);
+}
+
 BOOST_AUTO_TEST_SUITE_END();//TestDomainName
@@ -52,9 +52,12 @@
 #include "util/random/char_set/char_set.hh"
 #include "util/random/random.hh"
 
+#include <boost/algorithm/string.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(TestInfoDomain)
 
@@ -246,6 +249,60 @@ BOOST_FIXTURE_TEST_CASE(info_domain, test_domain_fixture)
 }
 
 
+BOOST_FIXTURE_TEST_CASE(info_domain_bulk, test_domain_fixture)
+{
+    ::LibFred::OperationContextCreator ctx;
+
+    const std::string unknown_fqdn = "unknown" + xmark + ".cz";
+    const std::string upper_fqdn = boost::algorithm::to_upper_copy(test_fqdn) + ".";
+    const auto by_fqdns = ::LibFred::InfoDomainByFqdns({test_fqdn, unknown_fqdn, upper_fqdn}).exec(ctx);
+    BOOST_REQUIRE_EQUAL(by_fqdns.info.size(), 2);
+    BOOST_CHECK(by_fqdns.info.at(test_fqdn) == test_info_domain_output);
+    BOOST_CHECK(by_fqdns.info.at(upper_fqdn) == test_info_domain_output);
+    BOOST_REQUIRE_EQUAL(by_fqdns.unknown_fqdns.size(), 1);
+    BOOST_CHECK_EQUAL(*by_fqdns.unknown_fqdns.begin(), unknown_fqdn);
+
+    const auto by_ids = ::LibFred::InfoDomainByIds({0, test_info_domain_output.info_domain_data.id}).exec(ctx);
+    BOOST_REQUIRE_EQUAL(by_ids.info.size(), 1);
+    BOOST_CHECK(by_ids.info.at(test_info_domain_output.info_domain_data.id) == test_info_domain_output);
+    BOOST_REQUIRE_EQUAL(by_ids.unknown_ids.size(), 1);
+    BOOST_CHECK_EQUAL(*by_ids.unknown_ids.begin(), 0);
+
+    BOOST_CHECK(::LibFred::InfoDomainByIds({}).exec(ctx).info.empty());
+}
+
+
+BOOST_FIXTURE_TEST_CASE(info_domain_by_chunks, test_domain_fixture)
+{
+    ::LibFred::OperationContextCreator ctx;
+
+    for (const std::size_t chunk_size : {1, 2})
+    {
+        std::vector<::LibFred::InfoDomainOutput> by_registrant;
+        ::LibFred::InfoDomainByRegistrantHandle(registrant_contact_handle).exec_by_chunks(
+                ctx,
+                [&](const ::LibFred::InfoDomainOutput& info) { by_registrant.push_back(info); },
+                chunk_size);
+        BOOST_REQUIRE_EQUAL(by_registrant.size(), 1);
+        BOOST_CHECK(by_registrant.at(0) == test_info_domain_output);
+
+        std::vector<::LibFred::InfoDomainOutput> by_nsset;
+        ::LibFred::InfoDomainByNssetHandle(test_nsset_handle).set_lock().exec_by_chunks(
+                ctx,
+                [&](const ::LibFred::InfoDomainOutput& info) { by_nsset.push_back(info); },
+                chunk_size);
+        BOOST_REQUIRE_EQUAL(by_nsset.size(), 1);
+        BOOST_CHECK(by_nsset.at(0) == test_info_domain_output);
+    }
+
+    std::size_t calls = 0;
+    ::LibFred::InfoDomainByKeysetHandle(xmark + test_keyset_handle).exec_by_chunks(
+            ctx,
+            [&](const ::LibFred::InfoDomainOutput&) { ++calls; });
+    BOOST_CHECK_EQUAL(calls, 0);
+}
+
+
 BOOST_FIXTURE_TEST_CASE(test_info_domain_output_timestamp, test_domain_fixture)
 {
     const std::string timezone = "Europe/Prague";
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "libfred/registrable_object/keyset/check_dns_key.hh"
+#include "libfred/opcontext.hh"
+#include "test/setup/fixtures.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(TestCheckDnsKey, Test::instantiate_db_template)
+
+BOOST_AUTO_TEST_CASE(algorithm_usability_snapshot)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const auto rules = ::LibFred::DnsSec::get_dns_key_rules(ctx);
+    BOOST_REQUIRE(rules != nullptr);
+    BOOST_CHECK(::LibFred::DnsSec::get_dns_key_rules(ctx) == rules);
+    for (int algorithm_number = -1; algorithm_number <= 256; ++algorithm_number)
+    {
+        const Database::Result dbres = ctx.get_conn().exec_params(
+                "SELECT EXISTS(SELECT 1 FROM dnssec_algorithm_blacklist WHERE alg_number=id) "
+                "FROM dnssec_algorithm WHERE id=$1::INTEGER",
+                Database::query_param_list(algorithm_number));
+        const auto expected = dbres.size() == 0 ? ::LibFred::DnsSec::Algorithm::invalid_value
+                                                : static_cast<bool>(dbres[0][0]) ? ::LibFred::DnsSec::Algorithm::forbidden
+                                                                                 : ::LibFred::DnsSec::Algorithm::usable;
+        BOOST_CHECK_EQUAL(rules->get_algorithm_usability(algorithm_number), expected);
+        BOOST_CHECK_EQUAL(::LibFred::DnsSec::get_algorithm_usability(ctx, algorithm_number), expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(refresh_algorithm_usability)
+{
+    ::LibFred::OperationContextCreator ctx;
+    ctx.get_conn().exec("DELETE FROM dnssec_algorithm_blacklist WHERE alg_number = 5");
+    const auto rules = ::LibFred::DnsSec::refresh_dns_key_rules(ctx);
+    BOOST_REQUIRE_EQUAL(rules->get_algorithm_usability(5), ::LibFred::DnsSec::Algorithm::usable);
+
+    ctx.get_conn().exec("INSERT INTO dnssec_algorithm_blacklist (alg_number) VALUES (5)");
+    BOOST_CHECK_EQUAL(::LibFred::DnsSec::get_algorithm_usability(ctx, 5), ::LibFred::DnsSec::Algorithm::usable);
+    BOOST_CHECK_EQUAL(::LibFred::DnsSec::refresh_dns_key_rules(ctx)->get_algorithm_usability(5),
+                      ::LibFred::DnsSec::Algorithm::forbidden);
+    BOOST_CHECK_EQUAL(::LibFred::DnsSec::get_algorithm_usability(ctx, 5), ::LibFred::DnsSec::Algorithm::forbidden);
+    BOOST_CHECK_EQUAL(rules->get_algorithm_usability(5), ::LibFred::DnsSec::Algorithm::usable);
+
+    ::LibFred::DnsSec::invalidate_dns_key_rules();
+    BOOST_CHECK(::LibFred::DnsSec::get_dns_key_rules(ctx) != rules);
+}
+
+BOOST_AUTO_TEST_CASE(validate_dns_keys)
+{
+    ::LibFred::OperationContextCreator ctx;
+    ctx.get_conn().exec("DELETE FROM dnssec_algorithm_blacklist WHERE alg_number IN (5, 8)");
+    ctx.get_conn().exec("INSERT INTO dnssec_algorithm_blacklist (alg_number) VALUES (8)");
+    ::LibFred::DnsSec::refresh_dns_key_rules(ctx);
+    const std::vector<::LibFred::DnsKey> dns_keys = {
+            ::LibFred::DnsKey(257, 3, 5, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8"),
+            ::LibFred::DnsKey(256, 3, 5, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8"),
+            ::LibFred::DnsKey(385, 3, 5, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8"),
+            ::LibFred::DnsKey(2, 3, 5, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8"),
+            ::LibFred::DnsKey(257, 1, 5, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8"),
+            ::LibFred::DnsKey(257, 3, 8, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8"),
+            ::LibFred::DnsKey(257, 3, 256, "AwEAAddt2AkLfYGKgiEZB5SmIF8EvrjxNMH6HtxWEA4RJ9Ao6LCWheg8")};
+    const std::vector<::LibFred::DnsSec::DnsKeyValidity::Enum> expected = {
+            ::LibFred::DnsSec::DnsKeyValidity::valid,
+            ::LibFred::DnsSec::DnsKeyValidity::valid,
+            ::LibFred::DnsSec::DnsKeyValidity::valid,
+            ::LibFred::DnsSec::DnsKeyValidity::invalid_flags,
+            ::LibFred::DnsSec::DnsKeyValidity::invalid_protocol,
+            ::LibFred::DnsSec::DnsKeyValidity::forbidden_algorithm,
+            ::LibFred::DnsSec::DnsKeyValidity::invalid_algorithm};
+    const auto result = ::LibFred::DnsSec::validate_dns_keys(ctx, dns_keys);
+    BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), expected.begin(), expected.end());
+    BOOST_CHECK(::LibFred::DnsSec::validate_dns_keys(ctx, {}).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()//TestCheckDnsKey
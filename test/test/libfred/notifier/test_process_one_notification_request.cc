@@ -29,6 +29,8 @@
 #include <boost/foreach.hpp>
 #include <boost/assign/list_of.hpp>
 
+#include <mutex>
+
 BOOST_AUTO_TEST_SUITE(TestNotifier)
 BOOST_AUTO_TEST_SUITE(SendNotification)
 
@@ -65,6 +67,7 @@ struct MockMailerManager : public ::LibFred::Mailer::Manager {
     };
 
     std::vector<MailData> accumulated_data;
+    std::mutex accumulated_data_mutex;
 
     virtual unsigned long long sendEmail(
       const std::string& _from,
@@ -77,6 +80,7 @@ struct MockMailerManager : public ::LibFred::Mailer::Manager {
       const std::string& _reply_to = std::string("")
 
     ) {
+        const std::lock_guard<std::mutex> lock(accumulated_data_mutex);
         accumulated_data.push_back(
             MailData(
                 _from,
@@ -680,5 +684,47 @@ BOOST_FIXTURE_TEST_CASE(test_process_request_invalid_notify_email, has_domain_bi
     );
 }
 
+BOOST_FIXTURE_TEST_CASE(test_process_batch, has_domain_big_update)
+{
+    Notification::enqueue_notification(
+        ctx,
+        Notification::created,
+        registrar.id,
+        domain_data_post_update.historyid,
+        "Svtrid-008"
+    );
+
+    std::shared_ptr<::LibFred::Mailer::Manager> mocked_mailer(new MockMailerManager);
+    MockMailerManager& mocked_mailer_data_access = *reinterpret_cast<MockMailerManager*>( mocked_mailer.get() );
+
+    const Notification::ProcessedNotificationRequests processed =
+        Notification::process_notification_requests(ctx, mocked_mailer, 10);
+    BOOST_CHECK_EQUAL(processed.number_of_processed_requests, 2);
+    BOOST_CHECK_EQUAL(processed.number_of_requests_returned_to_queue, 0);
+    BOOST_CHECK(processed.failed_to_send.empty());
+
+    std::set<std::string> found_templates;
+    BOOST_FOREACH(const MockMailerManager::MailData& mail, mocked_mailer_data_access.accumulated_data) {
+        found_templates.insert(mail.mailTemplate);
+    }
+    BOOST_CHECK(found_templates == boost::assign::list_of("notification_create")("notification_update").convert_to_container<std::set<std::string>>());
+
+    BOOST_CHECK_EQUAL(
+        Notification::process_notification_requests(ctx, mocked_mailer, 10).number_of_processed_requests,
+        0
+    );
+}
+
+BOOST_FIXTURE_TEST_CASE(test_process_batch_invalid_notify_email, has_domain_big_update)
+{
+    std::shared_ptr<::LibFred::Mailer::Manager> mocked_mailer(new MockThrowingMailerManager);
+
+    const Notification::ProcessedNotificationRequests processed =
+        Notification::process_notification_requests(ctx, mocked_mailer, 10);
+    BOOST_CHECK_EQUAL(processed.number_of_processed_requests, 1);
+    BOOST_REQUIRE_EQUAL(processed.failed_to_send.size(), 1);
+    BOOST_CHECK_EQUAL(processed.failed_to_send.front().template_name, "notification_update");
+}
+
 BOOST_AUTO_TEST_SUITE_END()//TestNotifier/SendNotification
 BOOST_AUTO_TEST_SUITE_END()//TestNotifier
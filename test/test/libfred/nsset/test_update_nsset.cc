@@ -969,6 +969,54 @@ BOOST_FIXTURE_TEST_CASE(update_nsset_add_already_added_dnshost, update_nsset_fix
     BOOST_CHECK(info_data_2.info_nsset_data.delete_time.isnull());
 }
 
+/**
+ * test UpdateNsset add dnshosts and tech contacts given repeatedly and unknown tech contact
+ */
+BOOST_FIXTURE_TEST_CASE(update_nsset_add_repeated_dnshosts_and_tech_contacts, update_nsset_fixture)
+{
+    namespace ip = boost::asio::ip;
+
+    ::LibFred::InfoNssetOutput info_data_1;
+    {
+        ::LibFred::OperationContextCreator ctx;
+        info_data_1 = ::LibFred::InfoNssetByHandle(test_nsset_handle).exec(ctx);
+    }
+
+    try
+    {
+        ::LibFred::OperationContextCreator ctx;//new connection to rollback on error
+        ::LibFred::UpdateNsset(test_nsset_handle, registrar_handle)
+        .add_dns(::LibFred::DnsHost("c.ns.nic.cz", { ip::address::from_string("127.0.0.5") }))
+        .add_dns(::LibFred::DnsHost("d.ns.nic.cz", { ip::address::from_string("127.0.0.6") }))
+        .add_dns(::LibFred::DnsHost("C.ns.nic.cz", { ip::address::from_string("127.0.0.7") }))
+        .add_tech_contact(admin_contact2_handle)
+        .add_tech_contact("NONEXISTENT-CONTACT" + xmark)
+        .add_tech_contact(admin_contact2_handle)
+        .exec(ctx);
+        ctx.commit_transaction();
+        BOOST_ERROR("no exception thrown");
+    }
+    catch (const ::LibFred::UpdateNsset::Exception& e)
+    {
+        BOOST_CHECK(e.is_set_vector_of_already_set_dns_host());
+        BOOST_REQUIRE_EQUAL(e.get_vector_of_already_set_dns_host().size(), 1);
+        BOOST_CHECK_EQUAL(e.get_vector_of_already_set_dns_host().at(0), "C.ns.nic.cz");
+        BOOST_CHECK(e.is_set_vector_of_already_set_technical_contact_handle());
+        BOOST_REQUIRE_EQUAL(e.get_vector_of_already_set_technical_contact_handle().size(), 1);
+        BOOST_CHECK_EQUAL(e.get_vector_of_already_set_technical_contact_handle().at(0), admin_contact2_handle);
+        BOOST_CHECK(e.is_set_vector_of_unknown_technical_contact_handle());
+        BOOST_REQUIRE_EQUAL(e.get_vector_of_unknown_technical_contact_handle().size(), 1);
+        BOOST_CHECK_EQUAL(e.get_vector_of_unknown_technical_contact_handle().at(0), "NONEXISTENT-CONTACT" + xmark);
+    }
+
+    ::LibFred::InfoNssetOutput info_data_2;
+    {
+        ::LibFred::OperationContextCreator ctx;
+        info_data_2 = ::LibFred::InfoNssetByHandle(test_nsset_handle).exec(ctx);
+    }
+    BOOST_CHECK(info_data_1 == info_data_2);
+}
+
 /**
  * test UpdateNsset remove unassigned dnshost
  */
@@ -26,6 +26,8 @@
 
 #include "test/setup/fixtures.hh"
 
+#include <set>
+
 namespace {
 
 struct HasBasicObjects
@@ -48,6 +50,16 @@ struct HasBasicObjects
     Test::HasDomain domain;
 };
 
+std::set<unsigned long long> to_ids(const std::set<LibFred::Object::ObjectId>& object_ids)
+{
+    std::set<unsigned long long> result;
+    for (const auto& object_id : object_ids)
+    {
+        result.insert(*object_id);
+    }
+    return result;
+}
+
 }//namespace {anonymous}
 
 BOOST_AUTO_TEST_SUITE(TestRegistryObjectAuthinfo)
@@ -220,6 +232,67 @@ BOOST_FIXTURE_TEST_CASE(check_authinfo_happy, HasBasicObjects)
             0);
 }
 
+BOOST_FIXTURE_TEST_CASE(check_many_authinfos, HasBasicObjects)
+{
+    //every registrar has its own authinfo
+    for (int cnt = 0; cnt < 10; ++cnt)
+    {
+        const Test::HasRegistrar another_registrar{ctx, "REG-AUTHINFO-" + std::to_string(cnt), false, false};
+        LibFred::Object::StoreAuthinfo{
+                LibFred::Object::ObjectId{domain.id},
+                another_registrar.id,
+                std::chrono::seconds{3600}}.exec(ctx, (cnt % 3) == 0 ? "password" : "another password");
+    }
+    for (int cnt = 0; cnt < 2; ++cnt)//the second round verifies remembered passwords
+    {
+        BOOST_CHECK_EQUAL(
+                LibFred::Object::CheckAuthinfo{LibFred::Object::ObjectId{domain.id}}
+                        .exec(ctx, "password", LibFred::Object::CheckAuthinfo::increment_usage),
+                4);
+        BOOST_CHECK_EQUAL(
+                LibFred::Object::CheckAuthinfo{LibFred::Object::ObjectId{domain.id}}
+                        .exec(ctx, "another password", LibFred::Object::CheckAuthinfo::increment_usage),
+                6);
+        BOOST_CHECK_EQUAL(
+                LibFred::Object::CheckAuthinfo{LibFred::Object::ObjectId{domain.id}}
+                        .exec(ctx, "bad password", LibFred::Object::CheckAuthinfo::increment_usage),
+                0);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(check_authinfo_of_any_object, HasBasicObjects)
+{
+    const Test::HasContact another_contact{ctx, "CONTACT-TEST-2", registrar};
+    const std::vector<LibFred::Object::ObjectId> object_ids = {
+            LibFred::Object::ObjectId{123456789ull},
+            LibFred::Object::ObjectId{contact.id},
+            LibFred::Object::ObjectId{another_contact.id}};
+    BOOST_CHECK(LibFred::Object::CheckAuthinfoOfAnyObject{{}}
+                        .exec(ctx, "password", LibFred::Object::CheckAuthinfo::increment_usage).empty());
+    BOOST_CHECK(LibFred::Object::CheckAuthinfoOfAnyObject{object_ids}
+                        .exec(ctx, "password", LibFred::Object::CheckAuthinfo::increment_usage).empty());
+    LibFred::Object::StoreAuthinfo{
+            LibFred::Object::ObjectId{another_contact.id},
+            registrar.id,
+            std::chrono::seconds{3600}}.exec(ctx, "password");
+    LibFred::Object::StoreAuthinfo{
+            LibFred::Object::ObjectId{contact.id},
+            registrar.id,
+            std::chrono::seconds{3600}}.exec(ctx, "another password");
+    BOOST_CHECK(to_ids(LibFred::Object::CheckAuthinfoOfAnyObject{object_ids}
+                        .exec(ctx, "password", LibFred::Object::CheckAuthinfo::increment_usage)) ==
+                std::set<unsigned long long>{another_contact.id});
+    BOOST_CHECK(to_ids(LibFred::Object::CheckAuthinfoOfAnyObject{object_ids}
+                        .exec(ctx, "another password", LibFred::Object::CheckAuthinfo::increment_usage)) ==
+                std::set<unsigned long long>{contact.id});
+    BOOST_CHECK(LibFred::Object::CheckAuthinfoOfAnyObject{object_ids}
+                        .exec(ctx, "bad password", LibFred::Object::CheckAuthinfo::increment_usage).empty());
+    BOOST_CHECK(LibFred::Object::CheckAuthinfoOfAnyObject{object_ids}
+                        .exec(ctx, "password", LibFred::Object::CheckAuthinfo::increment_usage_and_cancel).size() == 1);
+    BOOST_CHECK(LibFred::Object::CheckAuthinfoOfAnyObject{object_ids}
+                        .exec(ctx, "password", LibFred::Object::CheckAuthinfo::increment_usage).empty());
+}
+
 BOOST_FIXTURE_TEST_CASE(check_authinfo_exception, HasBasicObjects)
 {
     BOOST_CHECK_EXCEPTION(
@@ -20,7 +20,10 @@
 #include "libfred/object_state/create_object_state_request_id.hh"
 #include "libfred/object_state/get_object_state_descriptions.hh"
 #include "libfred/object_state/get_object_states.hh"
+#include "libfred/object_state/get_object_states_of_many.hh"
+#include "libfred/object_state/lock_object_state_request_lock.hh"
 #include "libfred/object_state/perform_object_state_request.hh"
+#include "libfred/object_state/perform_object_state_requests.hh"
 #include "libfred/opcontext.hh"
 #include "libfred/registrable_object/contact/check_contact.hh"
 #include "libfred/registrable_object/contact/copy_contact.hh"
@@ -30,6 +33,7 @@
 #include "libfred/registrable_object/contact/info_contact_diff.hh"
 #include "libfred/registrable_object/contact/merge_contact.hh"
 #include "libfred/registrable_object/contact/update_contact.hh"
+#include "libfred/registry_metadata.hh"
 #include "util/random/char_set/char_set.hh"
 #include "util/random/random.hh"
 #include "util/util.hh"
@@ -97,6 +101,91 @@ BOOST_FIXTURE_TEST_CASE(get_object_states, test_contact_fixture_8470af40b8634155
     BOOST_CHECK(states.at(0).state_name == Conversion::Enums::to_db_handle(::LibFred::Object_State::mojeid_contact));
 }
 
+BOOST_FIXTURE_TEST_CASE(get_object_states_of_many, test_contact_fixture_8470af40b863415588b78b1fb1782e7e )
+{
+    ::LibFred::OperationContextCreator ctx;
+    const unsigned long long contact_id = ::LibFred::InfoContactByHandle(test_contact_handle).exec(ctx).info_contact_data.id;
+    const unsigned long long nonexistent_id = static_cast<unsigned long long>(
+            ctx.get_conn().exec("SELECT COALESCE(MAX(id), 0) + 1 FROM object_registry")[0][0]);
+    const std::vector<unsigned long long> object_ids = { contact_id, nonexistent_id, contact_id };
+
+    ::LibFred::LockObjectStateRequestLocks(object_ids).exec(ctx);
+    ::LibFred::LockObjectStateRequestLocks({ }).exec(ctx);
+    BOOST_CHECK(::LibFred::GetObjectStatesOfMany({ }).exec(ctx).empty());
+
+    auto states = ::LibFred::GetObjectStatesOfMany(object_ids).exec(ctx);
+    BOOST_REQUIRE_EQUAL(states.size(), 2);
+    BOOST_CHECK(!states.at(contact_id).presents(::LibFred::Object_State::mojeid_contact));
+    BOOST_CHECK(!states.at(nonexistent_id).presents(::LibFred::Object_State::mojeid_contact));
+
+    ::LibFred::CreateObjectStateRequestId(contact_id,
+        Util::set_of<std::string>(Conversion::Enums::to_db_handle(::LibFred::Object_State::mojeid_contact))).exec(ctx);
+    ::LibFred::PerformObjectStateRequest().set_object_id(contact_id).exec(ctx);
+
+    states = ::LibFred::GetObjectStatesOfMany(object_ids).exec(ctx);
+    BOOST_REQUIRE_EQUAL(states.size(), 2);
+    BOOST_CHECK(states.at(contact_id).presents(::LibFred::Object_State::mojeid_contact));
+    BOOST_CHECK(!states.at(contact_id).presents(::LibFred::Object_State::linked));
+    BOOST_CHECK(!states.at(nonexistent_id).presents(::LibFred::Object_State::mojeid_contact));
+}
+
+BOOST_FIXTURE_TEST_CASE(perform_object_state_requests_in_chunks, test_contact_fixture_8470af40b863415588b78b1fb1782e7e )
+{
+    std::vector<unsigned long long> contact_ids;
+    {
+        ::LibFred::OperationContextCreator ctx;
+        contact_ids.push_back(::LibFred::InfoContactByHandle(test_contact_handle).exec(ctx).info_contact_data.id);
+        for (int idx = 0; idx < 4; ++idx)
+        {
+            contact_ids.push_back(::LibFred::CopyContact(
+                    test_contact_handle,
+                    test_contact_handle + "-COPY-" + boost::lexical_cast<std::string>(idx),
+                    registrar_handle,
+                    0).exec(ctx));
+        }
+        for (const auto contact_id : contact_ids)
+        {
+            ::LibFred::CreateObjectStateRequestId(contact_id,
+                Util::set_of<std::string>(Conversion::Enums::to_db_handle(::LibFred::Object_State::mojeid_contact))).exec(ctx);
+        }
+        ctx.commit_transaction();
+    }
+    std::vector<unsigned long long> object_ids = contact_ids;
+    object_ids.push_back(contact_ids.front());
+    std::reverse(object_ids.begin(), object_ids.end());
+
+    std::vector<::LibFred::PerformObjectStateRequests::Progress> progress;
+    const auto number_of_processed_objects = ::LibFred::PerformObjectStateRequests(object_ids)
+            .set_chunk_size(2)
+            .set_number_of_workers(2)
+            .set_resume_after(contact_ids.front())
+            .set_on_chunk_committed([&](const ::LibFred::PerformObjectStateRequests::Progress& chunk_progress)
+                    {
+                        progress.push_back(chunk_progress);
+                    })
+            .exec();
+    BOOST_CHECK_EQUAL(number_of_processed_objects, contact_ids.size() - 1);
+    BOOST_REQUIRE_EQUAL(progress.size(), 2);
+    BOOST_CHECK_EQUAL(progress.back().number_of_processed_objects, contact_ids.size() - 1);
+    BOOST_CHECK_EQUAL(progress.back().number_of_objects, contact_ids.size() - 1);
+    BOOST_CHECK_EQUAL(progress.back().processed_up_to_object_id, contact_ids.back());
+
+    {
+        ::LibFred::OperationContextCreator ctx;
+        const auto states = ::LibFred::GetObjectStatesOfMany(contact_ids).exec(ctx);
+        BOOST_CHECK(!states.at(contact_ids.front()).presents(::LibFred::Object_State::mojeid_contact));
+        for (auto contact_id_itr = contact_ids.begin() + 1; contact_id_itr != contact_ids.end(); ++contact_id_itr)
+        {
+            BOOST_CHECK(states.at(*contact_id_itr).presents(::LibFred::Object_State::mojeid_contact));
+        }
+    }
+
+    BOOST_CHECK_EQUAL(::LibFred::PerformObjectStateRequests(contact_ids.front(), contact_ids.front()).exec(), 1);
+    ::LibFred::OperationContextCreator ctx;
+    BOOST_CHECK(::LibFred::GetObjectStatesOfMany({ contact_ids.front() }).exec(ctx)
+            .at(contact_ids.front()).presents(::LibFred::Object_State::mojeid_contact));
+}
+
 /**
  * @namespace ObjectStateDescriptionWithComparison
  */
@@ -299,6 +388,7 @@ struct object_state_description_fixture : public Test::instantiate_db_template
             "INSERT INTO enum_object_states_desc VALUES (28,'EN','The domain is to be out of zone soon.'); "
         );
         ctx.commit_transaction();
+        ::LibFred::invalidate_registry_metadata();//enum tables changed
     }
 };
 
@@ -119,5 +119,53 @@ BOOST_FIXTURE_TEST_CASE(fredlib_state_messages, PollStateMessages)
     test();
 }
 
+BOOST_FIXTURE_TEST_CASE(fredlib_state_messages_in_chunks, PollStateMessages)
+{
+    const unsigned long long start_message_count = get_number_of_poll_messages(ctx);
+    const ::LibFred::Poll::CreateStateMessagesInChunks message_creator(
+            std::set<::LibFred::Poll::MessageType::Enum>(),
+            1);
+    const auto create_messages = [&]()
+    {
+        ::LibFred::Poll::CreateStateMessagesInChunks::NumberOfMessages number_of_messages;
+        unsigned long long last_state_id = 0;
+        while (true)
+        {
+            const auto chunk = message_creator.exec_chunk(ctx, last_state_id);
+            BOOST_CHECK(last_state_id <= chunk.last_state_id);
+            BOOST_CHECK(chunk.is_last || (last_state_id < chunk.last_state_id));
+            last_state_id = chunk.last_state_id;
+            for (const auto& message_type_count : chunk.number_of_messages)
+            {
+                number_of_messages[message_type_count.first] += message_type_count.second;
+            }
+            if (chunk.is_last)
+            {
+                return number_of_messages;
+            }
+        }
+    };
+    const auto number_of_messages = create_messages();
+    BOOST_REQUIRE_EQUAL(number_of_messages.count(::LibFred::Poll::MessageType::expiration), 1);
+    BOOST_CHECK_EQUAL(number_of_messages.at(::LibFred::Poll::MessageType::expiration), 1);
+    unsigned long long number_of_all_messages = 0;
+    for (const auto& message_type_count : number_of_messages)
+    {
+        number_of_all_messages += message_type_count.second;
+    }
+    BOOST_CHECK_EQUAL(get_number_of_poll_messages(ctx), start_message_count + number_of_all_messages);
+    BOOST_CHECK(create_messages().empty());
+
+    const Database::Result sql_query_result = ctx.get_conn().exec(
+        "SELECT obr.name "
+        "FROM poll_statechange ps "
+        "JOIN object_state os ON os.id=ps.stateid "
+        "JOIN object_registry obr ON obr.id=os.object_id "
+        "JOIN message m ON m.id=ps.msgid "
+        "WHERE m.msgtype=10 AND m.seen = false ORDER BY m.id DESC LIMIT 1");
+    BOOST_REQUIRE_EQUAL(sql_query_result.size(), 1);
+    BOOST_CHECK_EQUAL(static_cast<std::string>(sql_query_result[0][0]), handle);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 BOOST_AUTO_TEST_SUITE_END();
@@ -16,6 +16,7 @@
  * You should have received a copy of the GNU General Public License
  * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include "libfred/object/check_handle.hh"
 #include "libfred/opcontext.hh"
 #include "libfred/registrable_object/contact/check_contact.hh"
 #include "libfred/registrable_object/contact/copy_contact.hh"
@@ -47,7 +48,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <set>
 #include <string>
+#include <vector>
 
 namespace LibFred {
 namespace ContactHandleState {
@@ -380,6 +383,25 @@ BOOST_AUTO_TEST_CASE(check_registrar_handle_ok)
     BOOST_CHECK(!LibFred::CheckRegistrar("1234567890123456").is_invalid_handle());
 }
 
+/**
+ * test syntax check of many handles at once
+ */
+BOOST_AUTO_TEST_CASE(check_many_handles)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const std::vector<std::string> handles = { "CONTACT-1", "", "!", "contact@", "CONTACT-2", "CONTACT-1" };
+    const std::set<std::string> invalid_handles = { "", "!", "contact@" };
+    BOOST_CHECK(::LibFred::TestHandleOf<::LibFred::Object_Type::contact>::get_invalid_handles(ctx, handles) == invalid_handles);
+    BOOST_CHECK(::LibFred::TestHandleOf<::LibFred::Object_Type::nsset>::get_invalid_handles(ctx, handles) == invalid_handles);
+    BOOST_CHECK(::LibFred::TestHandleOf<::LibFred::Object_Type::keyset>::get_invalid_handles(ctx, handles) == invalid_handles);
+    BOOST_CHECK(::LibFred::TestHandleOf<::LibFred::Object_Type::contact>::get_invalid_handles(ctx, { }).empty());
+    for (const auto& handle : handles)
+    {
+        BOOST_CHECK_EQUAL(::LibFred::TestHandleOf<::LibFred::Object_Type::contact>(handle).is_invalid_handle(ctx),
+                          invalid_handles.count(handle) != 0);
+    }
+}
+
 
 BOOST_AUTO_TEST_SUITE_END();//TestCheckHandle
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026  CZ.NIC, z. s. p. o.
+ *
+ * This file is part of FRED.
+ *
+ * FRED is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FRED is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FRED.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "libfred/registry_metadata.hh"
+#include "libfred/object_state/get_object_state_descriptions.hh"
+#include "libfred/object_state/get_object_state_id_map.hh"
+#include "libfred/opcontext.hh"
+#include "test/setup/fixtures.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+#include <tuple>
+
+BOOST_FIXTURE_TEST_SUITE(TestRegistryMetadata, Test::instantiate_db_template)
+
+BOOST_AUTO_TEST_CASE(snapshot_versions)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const auto snapshot = ::LibFred::get_registry_metadata(ctx);
+    BOOST_REQUIRE(snapshot != nullptr);
+    BOOST_CHECK(::LibFred::get_registry_metadata(ctx) == snapshot);
+
+    const auto refreshed_snapshot = ::LibFred::refresh_registry_metadata(ctx);
+    BOOST_CHECK(refreshed_snapshot != snapshot);
+    BOOST_CHECK_LT(snapshot->get_version(), refreshed_snapshot->get_version());
+    BOOST_CHECK(::LibFred::get_registry_metadata(ctx) == refreshed_snapshot);
+    BOOST_CHECK_EQUAL(snapshot->get_object_type_id(::LibFred::Object_Type::domain),
+                      refreshed_snapshot->get_object_type_id(::LibFred::Object_Type::domain));
+
+    ::LibFred::invalidate_registry_metadata();
+    BOOST_CHECK_LT(refreshed_snapshot->get_version(), ::LibFred::get_registry_metadata(ctx)->get_version());
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_content)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const auto metadata = ::LibFred::get_registry_metadata(ctx);
+    for (const auto object_type : { ::LibFred::Object_Type::contact,
+                                    ::LibFred::Object_Type::nsset,
+                                    ::LibFred::Object_Type::domain,
+                                    ::LibFred::Object_Type::keyset })
+    {
+        const auto dbres = ctx.get_conn().exec_params(
+                "SELECT get_object_type_id($1::TEXT)",
+                Database::query_param_list(Conversion::Enums::to_db_handle(object_type)));
+        BOOST_CHECK_EQUAL(metadata->get_object_type_id(object_type), static_cast<unsigned long long>(dbres[0][0]));
+    }
+    BOOST_CHECK(metadata->find_object_type_id("nonexistent object type") == boost::none);
+    BOOST_CHECK_THROW(metadata->get_object_type_id("nonexistent object type"), ::LibFred::InternalError);
+
+    const auto states = ctx.get_conn().exec(
+            "SELECT id, name, external FROM enum_object_states ORDER BY id");
+    BOOST_REQUIRE_EQUAL(metadata->get_object_states().size(), states.size());
+    for (std::size_t idx = 0; idx < states.size(); ++idx)
+    {
+        const auto* const state = metadata->find_object_state(static_cast<std::string>(states[idx][1]));
+        BOOST_REQUIRE(state != nullptr);
+        BOOST_CHECK_EQUAL(state->id, static_cast<unsigned long long>(states[idx][0]));
+        BOOST_CHECK_EQUAL(state->external, static_cast<bool>(states[idx][2]));
+        BOOST_CHECK(metadata->find_object_state(state->id) == state);
+    }
+    BOOST_CHECK(metadata->find_object_state("nonexistent state") == nullptr);
+
+    const auto message_type = ctx.get_conn().exec("SELECT id FROM messagetype WHERE name='transfer_domain'");
+    BOOST_REQUIRE_EQUAL(message_type.size(), 1);
+    BOOST_CHECK_EQUAL(metadata->get_message_type_id(::LibFred::Poll::MessageType::transfer_domain),
+                      static_cast<unsigned long long>(message_type[0][0]));
+
+    const auto parameter = ctx.get_conn().exec(
+            "SELECT val FROM enum_parameters WHERE name='handle_registration_protection_period'");
+    BOOST_REQUIRE_EQUAL(parameter.size(), 1);
+    BOOST_REQUIRE(metadata->find_parameter("handle_registration_protection_period") != boost::none);
+    BOOST_CHECK_EQUAL(*metadata->find_parameter("handle_registration_protection_period"),
+                      static_cast<std::string>(parameter[0][0]));
+    BOOST_CHECK(metadata->find_parameter("nonexistent parameter") == boost::none);
+}
+
+BOOST_AUTO_TEST_CASE(operations_using_snapshot)
+{
+    ::LibFred::OperationContextCreator ctx;
+    const auto dbres = ctx.get_conn().exec(
+            "SELECT eosd.state_id, eos.name, eosd.description "
+            "FROM enum_object_states_desc eosd "
+            "JOIN enum_object_states eos ON eos.id=eosd.state_id AND "
+                                           "eos.external AND "
+                                           "get_object_type_id('domain')=ANY(eos.types) "
+            "WHERE UPPER(eosd.lang)='EN'");
+    std::set<std::tuple<unsigned long long, std::string, std::string>> expected_descriptions;
+    for (std::size_t idx = 0; idx < dbres.size(); ++idx)
+    {
+        expected_descriptions.emplace(
+                static_cast<unsigned long long>(dbres[idx][0]),
+                static_cast<std::string>(dbres[idx][1]),
+                static_cast<std::string>(dbres[idx][2]));
+    }
+    std::set<std::tuple<unsigned long long, std::string, std::string>> descriptions;
+    for (const auto& description : ::LibFred::GetObjectStateDescriptions("en").set_external().set_object_type("domain").exec(ctx))
+    {
+        descriptions.emplace(description.id, description.handle, description.description);
+    }
+    BOOST_CHECK(!descriptions.empty());
+    BOOST_CHECK(descriptions == expected_descriptions);
+    BOOST_CHECK(::LibFred::GetObjectStateDescriptions("EN").set_object_type("nonexistent object type").exec(ctx).empty());
+
+    const auto metadata = ::LibFred::get_registry_metadata(ctx);
+    const auto domain_type_id = metadata->get_object_type_id(::LibFred::Object_Type::domain);
+    ::LibFred::GetObjectStateIdMap state_id_map_operation(
+            { "serverDeleteProhibited", "outzone" },
+            static_cast<::LibFred::ObjectType>(domain_type_id));
+    const auto state_id_map = state_id_map_operation.exec(ctx);
+    BOOST_REQUIRE_EQUAL(state_id_map.size(), 2);
+    BOOST_CHECK_EQUAL(state_id_map.at("serverDeleteProhibited"), metadata->find_object_state("serverDeleteProhibited")->id);
+    BOOST_CHECK_EQUAL(state_id_map.at("outzone"), metadata->find_object_state("outzone")->id);
+    ::LibFred::GetObjectStateIdMap nonexistent_state_id_map_operation(
+            { "serverDeleteProhibited", "nonexistent state" },
+            static_cast<::LibFred::ObjectType>(domain_type_id));
+    BOOST_CHECK_THROW(nonexistent_state_id_map_operation.exec(ctx), ::LibFred::GetObjectStateIdMap::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
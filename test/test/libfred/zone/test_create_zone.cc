@@ -20,11 +20,13 @@
 #include "libfred/opexception.hh"
 #include "libfred/zone/create_zone.hh"
 #include "libfred/zone/exceptions.hh"
+#include "libfred/zone/zone.hh"
 #include "util/random/char_set/char_set.hh"
 #include "util/random/random.hh"
 #include "test/libfred/zone/util.hh"
 #include "test/setup/fixtures.hh"
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/test/test_tools.hpp>
 #include <boost/test/unit_test.hpp>
 #include <string>
@@ -105,6 +107,28 @@ BOOST_AUTO_TEST_CASE(set_max_create_enum_zone)
     BOOST_CHECK_EQUAL(exists_new_zone(fqdn, ctx), 1);
 }
 
+BOOST_AUTO_TEST_CASE(find_created_zone_in_fqdn)
+{
+    const std::string subzone_fqdn = "sub." + fqdn;
+    BOOST_CHECK_THROW(::LibFred::Zone::find_zone_in_fqdn_cached(ctx, "domain." + subzone_fqdn),
+           ::LibFred::Zone::Exception);
+
+    ::LibFred::Zone::CreateZone(fqdn, ex_period_min, ex_period_max).exec(ctx);
+    BOOST_CHECK_EQUAL(::LibFred::Zone::find_zone_in_fqdn_cached(ctx, "domain." + subzone_fqdn).name,
+                      boost::to_lower_copy(fqdn));
+
+    ::LibFred::Zone::CreateZone(subzone_fqdn, ex_period_min, ex_period_max).exec(ctx);
+    BOOST_CHECK_EQUAL(::LibFred::Zone::find_zone_in_fqdn_cached(ctx, "Domain." + subzone_fqdn).name,
+                      boost::to_lower_copy(subzone_fqdn));
+    BOOST_CHECK_EQUAL(::LibFred::Zone::find_zone_in_fqdn(ctx, "domain." + subzone_fqdn).name,
+                      boost::to_lower_copy(subzone_fqdn));
+    //zone itself is not a domain in the zone
+    BOOST_CHECK_EQUAL(::LibFred::Zone::find_zone_in_fqdn_cached(ctx, subzone_fqdn).name,
+                      boost::to_lower_copy(fqdn));
+    BOOST_CHECK_THROW(::LibFred::Zone::find_zone_in_fqdn_cached(ctx, fqdn),
+           ::LibFred::Zone::Exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 } // namespace Test
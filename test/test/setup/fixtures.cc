@@ -31,15 +31,19 @@
 
 #include "util/log/log.hh"
 
+#include "libfred/object/check_handle.hh"
 #include "libfred/registrable_object/contact/create_contact.hh"
 #include "libfred/registrable_object/contact/info_contact.hh"
 #include "libfred/registrable_object/domain/create_domain.hh"
 #include "libfred/registrable_object/domain/info_domain.hh"
+#include "libfred/registrable_object/keyset/check_dns_key.hh"
 #include "libfred/registrar/create_registrar.hh"
 #include "libfred/registrar/info_registrar.hh"
+#include "libfred/registry_metadata.hh"
 #include "libfred/zone/create_zone.hh"
 #include "libfred/zone/exceptions.hh"
 #include "libfred/zone/info_zone.hh"
+#include "libfred/zone/zone.hh"
 
 /** well, these includes are ugly
  * but there is no other way to get to the name of current test_case
@@ -377,6 +381,12 @@ instantiate_db_template::instantiate_db_template(const std::string& db_name_suff
     copy_db(create_db_template::get_db_template_name(),
             get_original_db_name(),
             CfgArgs::instance()->get_handler_ptr_by_type<HandleAdminDatabaseArgs>()->get_admin_connection());
+    //configuration cached from database of previous test case is not valid anymore
+    LibFred::Domain::invalidate_domain_name_validation_config_cache();
+    LibFred::Zone::invalidate_zone_index();
+    LibFred::invalidate_handle_validation_regexes();
+    LibFred::invalidate_registry_metadata();
+    LibFred::DnsSec::invalidate_dns_key_rules();
 }
 
 instantiate_db_template::~instantiate_db_template()
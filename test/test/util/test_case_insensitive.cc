@@ -24,7 +24,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <set>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(Tests)
 BOOST_AUTO_TEST_SUITE(Util)
@@ -48,6 +51,41 @@ BOOST_FIXTURE_TEST_CASE(test_comparison, Test::instantiate_db_template)
     BOOST_CHECK(!::Util::case_insensitive_equal_to(ctx.get_conn())(upper_case + " ", upper_case));
 };
 
+BOOST_FIXTURE_TEST_CASE(test_local_comparison_matches_database, Test::instantiate_db_template)
+{
+    const std::vector<std::string> strings = {
+            "", "handle-01", "HANDLE-01", "Handle_01", "příliš žluťoučký kůň", "PŘÍLIŠ ŽLUŤOUČKÝ KŮŇ",
+            "ÿ", "Ÿ", "ĳ", "Ĳ", "ǆ", "Ǆ", "ẞ", "ß", "αβγ ς", "ΑΒΓ Σ", "щука", "ЩУКА", "ёж", "ЁЖ",
+            "ｈａｎｄｌｅ", "ＨＡＮＤＬＥ", "ⓐⓑ", "ⒶⒷ"};
+    LibFred::OperationContextCreator ctx;
+    for (const auto& lhs : strings)
+    {
+        for (const auto& rhs : strings)
+        {
+            BOOST_CHECK_MESSAGE(
+                    ::Util::case_insensitive_equal_to()(lhs, rhs) ==
+                    ::Util::case_insensitive_equal_to(ctx.get_conn())(lhs, rhs),
+                    "\"" << lhs << "\" vs. \"" << rhs << "\"");
+        }
+        BOOST_CHECK_EQUAL(::Util::to_upper_case(lhs),
+                          static_cast<std::string>(ctx.get_conn().exec_params(
+                                  "SELECT UPPER($1::TEXT)",
+                                  Database::query_param_list(lhs))[0][0]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_containers)
+{
+    const std::unordered_set<std::string, ::Util::CaseInsensitiveHash, ::Util::CaseInsensitiveEqualTo<void>> hashed = {
+            "Kůň", "KŮŇ", "kůň", "kun"};
+    BOOST_CHECK_EQUAL(hashed.size(), 2);
+    BOOST_CHECK_EQUAL(hashed.count("kŮň"), 1);
+    const std::set<std::string, ::Util::CaseInsensitiveLess> ordered = {"Kůň", "KŮŇ", "kůň", "kun", "a", "B"};
+    BOOST_CHECK_EQUAL(ordered.size(), 4);
+    BOOST_CHECK_EQUAL(*ordered.begin(), "a");
+    BOOST_CHECK_EQUAL(ordered.count("b"), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()//Tests/Util/CaseInsensitive
 BOOST_AUTO_TEST_SUITE_END()//Tests/Util
 BOOST_AUTO_TEST_SUITE_END()//Tests
@@ -18,14 +18,22 @@
  */
 
 #include "src/libfred/opcontext.hh"
+#include "src/util/db/query_statistics.hh"
 
 #include "test/setup/fixtures.hh"
+#include "test/fake-src/util/cfg/config_handler_decl.hh"
+#include "test/fake-src/util/cfg/handle_database_args.hh"
 
 #include <boost/test/unit_test.hpp>
+#include <boost/uuid/string_generator.hpp>
+#include <boost/uuid/uuid_io.hpp>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <string>
 #include <sstream>
+#include <vector>
 
 
 namespace {
@@ -111,6 +119,13 @@ std::string get_non_existent_tablename(const LibFred::OperationContext& ctx, con
     return nonexistent_tablename;
 }
 
+const std::string& get_conn_info()
+{
+    return CfgArgs::instance()->get_handler_ptr_by_type<HandleDatabaseArgs>()->get_conn_info();
+}
+
+using PooledManager = Database::Manager_<Database::Factory::Pool<Database::PSQLConnection>>;
+
 }//namespace {anonymous}
 
 BOOST_AUTO_TEST_SUITE(Tests)
@@ -273,6 +288,213 @@ BOOST_FIXTURE_TEST_CASE(test_copy_from_fail_tx_broken_stream, Test::instantiate_
             });
 };
 
+BOOST_FIXTURE_TEST_CASE(test_pool_reuses_connection, Test::instantiate_db_template)
+{
+    Database::Factory::Pool<Database::PSQLConnection>::Parameters parameters;
+    parameters.min_size = 1;
+    parameters.max_size = 1;
+    const PooledManager manager{get_conn_info(), parameters};
+    std::string backend_pid;
+    {
+        const auto conn = manager.acquire();
+        backend_pid = static_cast<std::string>(conn->exec("SELECT pg_backend_pid()")[0][0]);
+        conn->exec("START TRANSACTION");
+        conn->exec("CREATE TEMPORARY TABLE pool_test (value TEXT)");
+    }
+    const auto conn = manager.acquire();
+    BOOST_CHECK_EQUAL(static_cast<std::string>(conn->exec("SELECT pg_backend_pid()")[0][0]), backend_pid);
+    BOOST_CHECK(!conn->is_in_transaction());
+    // pending transaction was rolled back on release
+    BOOST_CHECK_EQUAL(conn->exec("SELECT 0 FROM pg_tables WHERE tablename = 'pool_test'").size(), 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_pool_exhausted, Test::instantiate_db_template)
+{
+    Database::Factory::Pool<Database::PSQLConnection>::Parameters parameters;
+    parameters.max_size = 1;
+    parameters.acquire_timeout = std::chrono::milliseconds{10};
+    const PooledManager manager{get_conn_info(), parameters};
+    const auto conn = manager.acquire();
+    BOOST_CHECK_THROW(manager.acquire(), Database::ConnectionPoolExhausted);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_statement_cache, Test::instantiate_db_template)
+{
+    LibFred::OperationContextCreator ctx;
+    const auto statistics_before = ctx.get_conn().get_statement_cache_statistics();
+    static const std::string query = "SELECT $1::INT + 1";
+    for (int idx = 0; idx < 5; ++idx)
+    {
+        const auto result = ctx.get_conn().exec_params(query, Database::query_param_list(idx));
+        BOOST_CHECK_EQUAL(static_cast<int>(result[0][0]), idx + 1);
+    }
+    const auto statistics = ctx.get_conn().get_statement_cache_statistics();
+    BOOST_CHECK_EQUAL(statistics.hits - statistics_before.hits, 3u);
+    BOOST_CHECK_EQUAL(statistics.misses - statistics_before.misses, 2u);
+    BOOST_CHECK_EQUAL(statistics.size, statistics_before.size + 1);
+
+    ctx.get_conn().exec_params(query, Database::query_param_list(0), Database::StatementCaching::disabled);
+    const auto statistics_after_opt_out = ctx.get_conn().get_statement_cache_statistics();
+    BOOST_CHECK_EQUAL(statistics_after_opt_out.hits, statistics.hits);
+    BOOST_CHECK_EQUAL(statistics_after_opt_out.misses, statistics.misses);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_statement_cache_eviction, Test::instantiate_db_template)
+{
+    LibFred::OperationContextCreator ctx;
+    ctx.get_conn().set_statement_cache_capacity(1);
+    for (int idx = 0; idx < 3; ++idx)
+    {
+        ctx.get_conn().exec_params("SELECT $1::INT", Database::query_param_list(idx));
+        ctx.get_conn().exec_params("SELECT $1::INT - 1", Database::query_param_list(idx));
+    }
+    BOOST_CHECK_EQUAL(ctx.get_conn().get_statement_cache_statistics().size, 0u);
+    BOOST_CHECK_EQUAL(ctx.get_conn().exec("SELECT 0 FROM pg_prepared_statements WHERE name LIKE 'libfred_stmt_%'").size(), 0u);
+    ctx.get_conn().set_statement_cache_capacity(0);
+    ctx.get_conn().exec_params("SELECT $1::INT", Database::query_param_list(0));
+    BOOST_CHECK_EQUAL(ctx.get_conn().get_statement_cache_statistics().size, 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_typed_accessors, Test::instantiate_db_template)
+{
+    static const std::string query =
+            "SELECT $1::BIGINT AS id, "
+                   "$2::INT AS small, "
+                   "True AS flag, "
+                   "'text'::TEXT AS txt, "
+                   "'6b2e5ccf-83db-4804-bcbc-2bcb63b880a9'::UUID AS uuid, "
+                   "'2000-01-01 00:00:01.5'::TIMESTAMP AS ts, "
+                   "NULL::BIGINT AS nothing";
+    LibFred::OperationContextCreator ctx;
+    for (const auto result_format : {Database::ResultFormat::text, Database::ResultFormat::binary})
+    {
+        const auto result = ctx.get_conn().exec_params(
+                query,
+                Database::query_param_list(5000000000ll)(-7),
+                result_format);
+        const auto row = result[0];
+        BOOST_CHECK_EQUAL(row.get<long long>("id"), 5000000000ll);
+        BOOST_CHECK_THROW(row.get<int>("id"), ConversionError);
+        BOOST_CHECK_EQUAL(row.get<int>("small"), -7);
+        BOOST_CHECK(row.get<bool>("flag"));
+        BOOST_CHECK_EQUAL(row.get<std::string>("txt"), "text");
+        BOOST_CHECK_EQUAL(row.get<boost::string_ref>("txt"), "text");
+        BOOST_CHECK_EQUAL(
+                row.get<boost::uuids::uuid>("uuid"),
+                boost::uuids::string_generator()("6b2e5ccf-83db-4804-bcbc-2bcb63b880a9"));
+        BOOST_CHECK_EQUAL(
+                row.get<boost::posix_time::ptime>("ts"),
+                boost::posix_time::ptime(boost::gregorian::date(2000, 1, 1), boost::posix_time::milliseconds(1500)));
+        BOOST_CHECK_EQUAL(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                        row.get<std::chrono::system_clock::time_point>("ts").time_since_epoch()).count(),
+                946684801500ll);
+        BOOST_CHECK(row.get<boost::optional<long long>>("nothing") == boost::none);
+        BOOST_CHECK_THROW(row.get<long long>("nothing"), ConversionError);
+    }
+    const auto binary_result = ctx.get_conn().exec_params(
+            query,
+            Database::query_param_list(1)(2),
+            Database::ResultFormat::binary);
+    BOOST_CHECK_THROW(static_cast<long long>(binary_result[0]["id"]), Database::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_pipeline, Test::instantiate_db_template)
+{
+    LibFred::OperationContextCreator ctx;
+    auto pipeline = ctx.get_conn().pipeline();
+    BOOST_CHECK_EQUAL(pipeline.add("SELECT $1::INT", Database::query_param_list(1)), 0u);
+    BOOST_CHECK_EQUAL(pipeline.add("SELECT generate_series(1, $1::INT)", Database::query_param_list(3)), 1u);
+    BOOST_CHECK_EQUAL(pipeline.add("SELECT $1::TEXT", Database::query_param_list("text")), 2u);
+    BOOST_CHECK_EQUAL(pipeline.size(), 3u);
+    const auto results = pipeline.exec();
+    BOOST_REQUIRE_EQUAL(results.size(), 3u);
+    BOOST_CHECK_EQUAL(static_cast<int>(results[0][0][0]), 1);
+    BOOST_CHECK_EQUAL(results[1].size(), 3u);
+    BOOST_CHECK_EQUAL(static_cast<std::string>(results[2][0][0]), "text");
+
+    auto failing_pipeline = ctx.get_conn().pipeline();
+    failing_pipeline.add("SELECT 1", Database::QueryParams());
+    failing_pipeline.add("SELECT 1/$1::INT", Database::query_param_list(0));
+    failing_pipeline.add("SELECT 2", Database::QueryParams());
+    BOOST_CHECK_THROW(failing_pipeline.exec(), Database::ResultFailed);
+}
+
+BOOST_AUTO_TEST_CASE(test_query_normalization)
+{
+    BOOST_CHECK_EQUAL(
+            Database::normalize_query("SELECT id  FROM t1\n WHERE id IN (1, 2,3) -- comment\n AND name = 'O''Brien'"),
+            "SELECT id FROM t1 WHERE id IN (?) AND name = ?");
+    BOOST_CHECK_EQUAL(
+            Database::normalize_query("SELECT $1::BIGINT + 1.5e-3 FROM \"Table 2\" LIMIT 10"),
+            "SELECT $1::BIGINT + ? FROM \"Table 2\" LIMIT ?");
+    BOOST_CHECK_EQUAL(
+            Database::get_query_fingerprint(Database::normalize_query("SELECT 1")),
+            Database::get_query_fingerprint(Database::normalize_query("SELECT  2")));
+    BOOST_CHECK_NE(
+            Database::get_query_fingerprint(Database::normalize_query("SELECT $1::INT")),
+            Database::get_query_fingerprint(Database::normalize_query("SELECT $2::INT")));
+}
+
+BOOST_AUTO_TEST_CASE(test_latency_histogram)
+{
+    Database::LatencyHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.get_percentile(50).count(), 0);
+    for (int value = 1; value <= 1000; ++value)
+    {
+        histogram.record(std::chrono::microseconds{value});
+    }
+    BOOST_CHECK_EQUAL(histogram.get_count(), 1000u);
+    BOOST_CHECK_EQUAL(histogram.get_percentile(1).count(), 10);
+    BOOST_CHECK_GE(histogram.get_percentile(50).count(), 500);
+    BOOST_CHECK_LE(histogram.get_percentile(50).count(), 500 + 500 / 16);
+    BOOST_CHECK_GE(histogram.get_percentile(99).count(), 990);
+    BOOST_CHECK_LE(histogram.get_percentile(99).count(), 990 + 990 / 16);
+    BOOST_CHECK_GE(histogram.get_percentile(100).count(), 1000);
+    Database::LatencyHistogram other;
+    other.record(std::chrono::hours{24 * 365});
+    histogram.merge(other);
+    BOOST_CHECK_EQUAL(histogram.get_count(), 1001u);
+    BOOST_CHECK(std::chrono::hours{24 * 365} <= histogram.get_percentile(100));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_query_statistics, Test::instantiate_db_template)
+{
+    Database::reset_query_statistics();
+    std::vector<std::string> slow_queries;
+    Database::set_slow_query_callback(
+            std::chrono::microseconds::zero(),
+            [&](const Database::SlowQuery& slow_query) { slow_queries.push_back(slow_query.query); });
+    {
+        LibFred::OperationContextCreator ctx;
+        ctx.get_conn().exec_params("SELECT generate_series(1, $1::INT)", Database::query_param_list(3));
+        ctx.get_conn().exec_params("SELECT generate_series(1, $1::INT)", Database::query_param_list(2));
+        BOOST_CHECK_THROW(ctx.get_conn().exec("SELECT 1/0"), Database::ResultFailed);
+    }
+    Database::set_slow_query_callback(std::chrono::microseconds::zero(), Database::SlowQueryCallback{});
+
+    const auto statistics = Database::get_query_statistics();
+    const auto find_statistics = [&](const std::string& query)
+    {
+        const auto fingerprint = Database::get_query_fingerprint(Database::normalize_query(query));
+        return std::find_if(begin(statistics), end(statistics), [&](auto&& item) { return item.fingerprint == fingerprint; });
+    };
+    const auto series = find_statistics("SELECT generate_series(1, $1::INT)");
+    BOOST_REQUIRE(series != end(statistics));
+    BOOST_CHECK_EQUAL(series->normalized_query, "SELECT generate_series(?, $1::INT)");
+    BOOST_CHECK_EQUAL(series->calls, 2u);
+    BOOST_CHECK_EQUAL(series->errors, 0u);
+    BOOST_CHECK_EQUAL(series->rows_returned, 5u);
+    BOOST_CHECK_EQUAL(series->latency.get_count(), 2u);
+    BOOST_CHECK(series->max_time <= series->total_time);
+    const auto division = find_statistics("SELECT 1/0");
+    BOOST_REQUIRE(division != end(statistics));
+    BOOST_CHECK_EQUAL(division->calls, 1u);
+    BOOST_CHECK_EQUAL(division->errors, 1u);
+    BOOST_CHECK_EQUAL(std::count(begin(slow_queries), end(slow_queries), "SELECT generate_series(1, $1::INT)"), 2);
+    BOOST_CHECK_EQUAL(std::count(begin(slow_queries), end(slow_queries), "SELECT 1/0"), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()//Tests/Util/Db
 BOOST_AUTO_TEST_SUITE_END()//Tests/Util
 BOOST_AUTO_TEST_SUITE_END()//Tests
@@ -23,13 +23,20 @@
 
 #define BOOST_TEST_NO_MAIN
 
+#include <boost/archive/iterators/base64_from_binary.hpp>
+#include <boost/archive/iterators/binary_from_base64.hpp>
+#include <boost/archive/iterators/transform_width.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <vector>
 
 std::ostream& operator<<(std::ostream &out, const struct ::timespec& dt)
 {
@@ -115,6 +122,45 @@ bool test_is_password_correct(
     return password_is_correct;
 }
 
+//the former implementation by boost archive iterators, the reference of base64 codec
+std::string reference_encode_base64(const std::vector<unsigned char>& data)
+{
+    typedef boost::archive::iterators::base64_from_binary<
+                    boost::archive::iterators::transform_width<const unsigned char*, 6, 8>> Base64EncodeIterator;
+    std::ostringstream result;
+    std::copy(Base64EncodeIterator(data.data()),
+              Base64EncodeIterator(data.data() + data.size()),
+              std::ostream_iterator<char>(result));
+    return result.str() + std::string((3 - (data.size() % 3)) % 3, '=');
+}
+
+std::vector<unsigned char> reference_decode_base64(const std::string& src)
+{
+    typedef boost::archive::iterators::transform_width<
+                    boost::archive::iterators::binary_from_base64<const char*>, 8, 6> Base64DecodeIterator;
+    const auto size = src.find('=') == std::string::npos ? src.size() : src.find('=');
+    std::ostringstream data;
+    std::copy(Base64DecodeIterator(src.c_str()),
+              Base64DecodeIterator(src.c_str() + size),
+              std::ostream_iterator<char>(data));
+    const auto str = data.str();
+    return std::vector<unsigned char>(str.begin(), str.end());
+}
+
+std::string encode_base64(const std::vector<unsigned char>& data)
+{
+    std::string result(::PasswordStorage::get_size_of_base64_encoded_data(data.size()), '\0');
+    result.resize(::PasswordStorage::encode_base64(data.data(), data.size(), &result[0]));
+    return result;
+}
+
+std::vector<unsigned char> decode_base64(const std::string& src)
+{
+    std::vector<unsigned char> result(::PasswordStorage::get_max_size_of_base64_decoded_data(src.size()));
+    result.resize(::PasswordStorage::decode_base64(src.data(), src.size(), result.data()));
+    return result;
+}
+
 }//namespace {anonymous}
 
 BOOST_AUTO_TEST_CASE(test_function_is_password_correct)
@@ -147,6 +193,68 @@ BOOST_AUTO_TEST_CASE(test_base64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_base64_codec)
+{
+    std::vector<unsigned char> data;
+    for (int size = 0; size < 100; ++size)
+    {
+        const auto base64_encoded = encode_base64(data);
+        BOOST_CHECK_EQUAL(base64_encoded, reference_encode_base64(data));
+        BOOST_CHECK(decode_base64(base64_encoded) == data);
+        BOOST_CHECK(reference_decode_base64(base64_encoded) == data);
+        BOOST_CHECK(decode_base64(base64_encoded.substr(0, base64_encoded.find('='))) == data);
+        data.push_back(static_cast<unsigned char>(size * 37 + 11));
+    }
+    BOOST_CHECK_THROW(decode_base64("YWJj!"), std::runtime_error);
+    BOOST_CHECK_THROW(decode_base64("YWJjZ"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_base64_codec_speed)
+{
+    const std::vector<unsigned char> data(64, 0xa5);//size of sha512 hash
+    const int rounds = 100000;
+    std::size_t checksum = 0;
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for (int cnt = 0; cnt < rounds; ++cnt)
+    {
+        checksum += reference_decode_base64(reference_encode_base64(data)).size();
+    }
+    BOOST_TEST_MESSAGE("boost archive iterators base64 encode + decode took " << stopwatch.get_intermediate_time() << "s of CPU time");
+    stopwatch.start();
+    std::array<char, ::PasswordStorage::get_size_of_base64_encoded_data(64)> encoded;
+    std::array<unsigned char, ::PasswordStorage::get_max_size_of_base64_decoded_data(encoded.size())> decoded;
+    for (int cnt = 0; cnt < rounds; ++cnt)
+    {
+        const auto size_of_encoded = ::PasswordStorage::encode_base64(data.data(), data.size(), encoded.data());
+        checksum += ::PasswordStorage::decode_base64(encoded.data(), size_of_encoded, decoded.data());
+    }
+    BOOST_TEST_MESSAGE("base64 encode + decode into caller provided buffers took " << stopwatch.get_intermediate_time() << "s of CPU time");
+    BOOST_CHECK_EQUAL(checksum, 2 * rounds * data.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupted_password_data)
+{
+    const auto encrypted = TestedAlgorithm::encrypt_password("nazdar").get_value();
+    BOOST_CHECK(test_is_password_correct("nazdar", ::PasswordStorage::PasswordData::construct_from(encrypted)));
+    BOOST_CHECK_THROW(
+            ::PasswordStorage::check_password("nazdar", ::PasswordStorage::PasswordData::construct_from(encrypted + "$")),
+            std::runtime_error);
+    BOOST_CHECK_THROW(
+            ::PasswordStorage::check_password("nazdar", ::PasswordStorage::PasswordData::construct_from(encrypted.substr(1))),
+            std::runtime_error);
+    BOOST_CHECK_THROW(
+            ::PasswordStorage::check_password("nazdar", ::PasswordStorage::PasswordData::construct_from(
+                    encrypted.substr(0, encrypted.rfind('$')))),
+            std::runtime_error);
+    BOOST_CHECK_THROW(
+            ::PasswordStorage::check_password("nazdar", ::PasswordStorage::PasswordData::construct_from(std::string("$pbkdf2$sha512$x1$$"))),
+            std::runtime_error);
+    BOOST_CHECK(test_is_password_correct("nazdar", ::PasswordStorage::PasswordData::construct_from(std::string("$plaintext$nazdar"))));
+    BOOST_CHECK(!test_is_password_correct("nazdar!", ::PasswordStorage::PasswordData::construct_from(std::string("$plaintext$nazdar"))));
+    BOOST_CHECK(!test_is_password_correct("nazda", ::PasswordStorage::PasswordData::construct_from(std::string("$plaintext$nazdar"))));
+}
+
 BOOST_AUTO_TEST_SUITE_END()//Tests/Util/PasswordStorage
 BOOST_AUTO_TEST_SUITE_END()//Tests/Util
 BOOST_AUTO_TEST_SUITE_END()//Tests